@@ -0,0 +1,600 @@
+/***********************************************************************************************//**
+ *  Benchmarks and accuracy checks of the orbit_trajectory module
+ *  @author     DSS-SIM development team, i2CAT
+ *  @date       2026-oct-16
+ *  @copyright  This code has been developed by Fundació Privada Internet i Innovació Digital a
+ *              Catalunya (i2CAT). i2CAT is a non-profit research and innovation centre that
+ *              promotes mission-driven knowledge to solve business challenges, co-create solutions
+ *              with a transformative impact, empower citizens through open and participative
+ *              digital social innovation with territorial capillarity, and promote pioneering and
+ *              strategic initiatives. i2CAT *aims to transfer* research project results to private
+ *              companies in order to create social and economic impact via the out-licensing of
+ *              intellectual property and the creation of spin-offs.
+ *              Find more information of i2CAT projects and IP rights at:
+ *              https://i2cat.net/tech-transfer/
+ *
+ *  Besides the Google Benchmark flags, the executable accepts:
+ *      --verification_tle=PATH         Vallado's SGP4-VER.TLE
+ *      --verification_out=PATH         Vallado's tcppver.out (reference states of the TLEs above)
+ *      --accuracy_tolerance_km=VALUE   Maximum position error accepted (default 1e-5 km)
+ *      --baseline=PATH                 JSON results of a previous run
+ *      --max_regression=VALUE          Maximum relative throughput loss accepted (default 0.1)
+ *  Without the verification files, the accuracy check uses the reference states of catalog object
+ *  00005 published with Vallado's verification set. The executable returns 1 if the accuracy or
+ *  the throughput gates fail.
+ **************************************************************************************************/
+
+/* Global libraries */
+#include "dss.hpp"
+
+/* External Libraries */
+#include <array>
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <fstream>
+#include "SGP4.h"
+
+/* Internal Libraries */
+#include "SGP4OrbitTrajectory.hpp"
+#include "SGP4BatchPropagator.hpp"
+#include "SGP4Kernels.hpp"
+#include "TLECatalogLoader.hpp"
+#include "TimeUtils.hpp"
+
+LOG_COMPONENT_DEFINE("OrbitTrajectoryBenchmark");
+
+#define BENCHMARK_STEPS             10      /**< Time steps propagated per benchmark iteration */
+#define BENCHMARK_SECONDS_PER_UNIT  60.0    /**< SGP4 evaluates its time argument in minutes */
+
+/* Command line options of the gates. */
+static std::string g_verification_tle;
+static std::string g_verification_out;
+static std::string g_baseline;
+static double g_accuracy_tolerance = 1.0e-5;
+static double g_max_regression = 0.1;
+
+/* Result of the accuracy check, used by the gate. */
+static double g_max_position_error = -1;
+static std::size_t g_failed_cases = 0;
+
+/* Element set 00005 of Vallado's verification set and its published states (wgs72, 'a'). */
+static const char* VERIFICATION_00005 =
+    "1 00005U 58002B   00179.78495062  .00000023  00000-0  28098-4 0  4753\n"
+    "2 00005  34.2682 348.7242 1859667 331.7664  19.3264 10.82419157413667\n";
+static const double REFERENCE_00005[][7] = {
+    {  0.0, 7022.46529266, -1400.08296755, 0.03995155, 1.893841015, 6.405893759, 4.534807250},
+    {360.0, -7154.03120202, -3783.17682504, -3536.19412294, 4.741887409, -4.151817765,
+        -2.093935425},
+};
+
+/***********************************************************************************************//**
+ * Builds a synthetic LEO catalog: shells of circular-ish orbits between 500 and 1200 km with
+ * inclinations between 53 and 98 deg, spread in right ascension and mean anomaly.
+ **************************************************************************************************/
+static std::vector<TLE> makeCatalog(std::size_t count)
+{
+    std::vector<TLE> catalog(count);
+    std::size_t planes = std::max<std::size_t>(1, std::sqrt((double)count));
+
+    for(std::size_t i = 0; i < count; i++) {
+        TLE& tle = catalog[i];
+        std::size_t shell = i % 5;
+        double altitude = 500.0 + 175.0 * shell;
+        double a = 6378.137 + altitude;
+        double n = std::sqrt(Globals::constants.earth_mu / (a * a * a));
+
+        tle.sat_number = (int)(i % 100000);
+        tle.mean_motion = n * 86400.0 / (2.0 * Globals::constants.pi);
+        tle.orbit_params.semimajor_axis = a;
+        tle.orbit_params.eccentricity = 0.0001 + 0.0002 * (i % 7);
+        tle.orbit_params.inclination = 53.0 + 11.25 * shell;
+        tle.orbit_params.arg_perigee = 37.0 * (i % 11);
+        tle.orbit_params.raan = 360.0 * (i % planes) / planes;
+        tle.mean_anomaly = std::fmod(360.0 * (i / planes) / planes + 7.0 * shell, 360.0);
+        tle.first_time = 0.00001;
+        tle.second_time = 0;
+        tle.bstar = 3.0 + 0.5 * shell;
+        tle.tle_number = 999;
+        tle.revolutions = 1000;
+        tle.epoch_year = 24;
+        tle.epoch_doy = 100.5;
+    }
+    return catalog;
+}
+
+/***********************************************************************************************//**
+ * Initialised trajectories of a synthetic catalog, shared by the benchmarks of the same size.
+ **************************************************************************************************/
+static std::vector<std::unique_ptr<SGP4OrbitTrajectory>>& getTrajectories(std::size_t count)
+{
+    static std::map<std::size_t, std::vector<std::unique_ptr<SGP4OrbitTrajectory>>> cache;
+    std::vector<std::unique_ptr<SGP4OrbitTrajectory>>& trajectories = cache[count];
+
+    if(trajectories.empty()) {
+        std::vector<TLE> catalog = makeCatalog(count);
+        for(std::size_t i = 0; i < count; i++) {
+            std::string id = std::to_string(i);
+            trajectories.emplace_back(new SGP4OrbitTrajectory(catalog[i], id, false));
+            trajectories.back()->sgp4Init(catalog[i], id, wgs84, 'i');
+        }
+    }
+    return trajectories;
+}
+
+static void sizes(benchmark::internal::Benchmark* b)
+{
+    for(int count : {1, 100, 1000, 10000, 50000}) {
+        b->Arg(count);
+    }
+}
+
+static void sizesAndPrecisions(benchmark::internal::Benchmark* b)
+{
+    for(int count : {1, 100, 1000, 10000, 50000}) {
+        for(int single : {0, 1}) {
+            b->Args({count, single});
+        }
+    }
+}
+
+static void sizesAndSteps(benchmark::internal::Benchmark* b)
+{
+    for(int count : {1, 100, 1000, 10000, 50000}) {
+        for(int step : {1, 10, 60, 600}) {
+            b->Args({count, step});
+        }
+    }
+}
+
+/* sgp4Init of a whole catalog. */
+static void BM_SGP4Init(benchmark::State& state)
+{
+    std::size_t count = state.range(0);
+    std::vector<TLE> catalog = makeCatalog(count);
+    std::vector<std::unique_ptr<SGP4OrbitTrajectory>>& trajectories = getTrajectories(count);
+
+    for(auto _ : state) {
+        for(std::size_t i = 0; i < count; i++) {
+            benchmark::DoNotOptimize(trajectories[i]->sgp4Init(catalog[i], "", wgs84, 'i'));
+        }
+    }
+    state.counters["inits_per_second"] = benchmark::Counter(
+        (double)count * state.iterations(), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_SGP4Init)->Apply(sizes)->Unit(benchmark::kMicrosecond);
+
+/* sgp4Propagate of a whole catalog over consecutive time steps (step given in seconds). */
+static void BM_SGP4Propagate(benchmark::State& state)
+{
+    std::size_t count = state.range(0);
+    double step = state.range(1) / BENCHMARK_SECONDS_PER_UNIT;
+    std::vector<std::unique_ptr<SGP4OrbitTrajectory>>& trajectories = getTrajectories(count);
+    double time = 0;
+
+    for(auto _ : state) {
+        for(int k = 0; k < BENCHMARK_STEPS; k++, time += step) {
+            for(std::size_t i = 0; i < count; i++) {
+                benchmark::DoNotOptimize(trajectories[i]->sgp4Propagate(time));
+            }
+        }
+    }
+    state.counters["states_per_second"] = benchmark::Counter(
+        (double)count * BENCHMARK_STEPS * state.iterations(), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_SGP4Propagate)->Apply(sizesAndSteps)->Unit(benchmark::kMicrosecond);
+
+/* computeMean (through getMeanAnomaly) of a whole catalog over consecutive time steps. */
+static void BM_ComputeMean(benchmark::State& state)
+{
+    std::size_t count = state.range(0);
+    double step = state.range(1);
+    std::vector<std::unique_ptr<SGP4OrbitTrajectory>>& trajectories = getTrajectories(count);
+    double time = 0;
+
+    for(auto _ : state) {
+        for(int k = 0; k < BENCHMARK_STEPS; k++, time += step) {
+            TimeUtils::setSimulationTime(time);
+            for(std::size_t i = 0; i < count; i++) {
+                benchmark::DoNotOptimize(trajectories[i]->getMeanAnomaly());
+            }
+        }
+    }
+    state.counters["states_per_second"] = benchmark::Counter(
+        (double)count * BENCHMARK_STEPS * state.iterations(), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_ComputeMean)->Apply(sizesAndSteps)->Unit(benchmark::kMicrosecond);
+
+/* Generic SGP4Funcs::sgp4 (argument 0) against the kernel selected at init, in double
+ * (argument 1) and in mixed single precision (argument 2). */
+static void BM_SGP4Kernel(benchmark::State& state)
+{
+    std::vector<std::unique_ptr<SGP4OrbitTrajectory>>& trajectories = getTrajectories(10000);
+    std::vector<elsetrec> satrecs;
+    std::vector<SGP4Kernel> kernels;
+    double r[3], v[3];
+    double time = 0;
+
+    for(const std::unique_ptr<SGP4OrbitTrajectory>& trajectory : trajectories) {
+        satrecs.push_back(trajectory->getSatrec());
+        kernels.push_back(state.range(0) ? selectSGP4Kernel(satrecs.back(), wgs84,
+            state.range(0) == 2) : &SGP4Funcs::sgp4);
+    }
+    state.SetLabel(state.range(0) == 0 ? "generic"
+        : state.range(0) == 1 ? "specialised" : "single_precision");
+
+    for(auto _ : state) {
+        for(std::size_t i = 0; i < satrecs.size(); i++) {
+            kernels[i](satrecs[i], time, r, v);
+            benchmark::DoNotOptimize(r);
+        }
+        time += 1.0;
+    }
+    state.counters["states_per_second"] = benchmark::Counter(
+        (double)satrecs.size() * state.iterations(), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_SGP4Kernel)->Arg(0)->Arg(1)->Arg(2)->Unit(benchmark::kMicrosecond);
+
+/* Structure-of-arrays batch propagation of a whole catalog, in double (second argument 0) and
+ * in mixed single precision (second argument 1). */
+static void BM_BatchPropagate(benchmark::State& state)
+{
+    std::size_t count = state.range(0);
+    std::vector<std::unique_ptr<SGP4OrbitTrajectory>>& trajectories = getTrajectories(count);
+    SGP4BatchPropagator propagator;
+    BatchStates states;
+    double time = 0;
+
+    for(const std::unique_ptr<SGP4OrbitTrajectory>& trajectory : trajectories) {
+        propagator.addSatellite(*trajectory);
+    }
+    propagator.setSinglePrecision(state.range(1) != 0);
+    state.SetLabel(state.range(1) ? "single_precision" : "double");
+
+    for(auto _ : state) {
+        propagator.propagate(time, states);
+        benchmark::DoNotOptimize(states.x.data());
+        time += 1.0;
+    }
+    state.counters["states_per_second"] = benchmark::Counter(
+        (double)count * state.iterations(), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_BatchPropagate)->Apply(sizesAndPrecisions)->Unit(benchmark::kMicrosecond);
+
+/***********************************************************************************************//**
+ * Position error of the mixed single-precision kernels against the double-precision ones on the
+ * synthetic catalog, sampled every 10 minutes up to the number of days of the argument. It runs
+ * once and reports the maximum and RMS errors as counters.
+ **************************************************************************************************/
+static void BM_SinglePrecisionAccuracy(benchmark::State& state)
+{
+    std::vector<std::unique_ptr<SGP4OrbitTrajectory>>& trajectories = getTrajectories(1000);
+    double minutes = state.range(0) * 1440.0;
+    double max_error = 0, sum_squares = 0;
+    std::size_t cases = 0;
+
+    for(auto _ : state) {
+        for(const std::unique_ptr<SGP4OrbitTrajectory>& trajectory : trajectories) {
+            elsetrec reference = trajectory->getSatrec();
+            elsetrec single = reference;
+            SGP4Kernel reference_kernel = selectSGP4Kernel(reference, wgs84, false);
+            SGP4Kernel single_kernel = selectSGP4Kernel(single, wgs84, true);
+            for(double t = 0; t <= minutes; t += 10.0) {
+                double r0[3], v0[3], r1[3], v1[3];
+                if(!reference_kernel(reference, t, r0, v0) || !single_kernel(single, t, r1, v1)) {
+                    break;
+                }
+                double error = 0;
+                for(int c = 0; c < 3; c++) {
+                    error += (r1[c] - r0[c]) * (r1[c] - r0[c]);
+                }
+                max_error = std::max(max_error, std::sqrt(error));
+                sum_squares += error;
+                cases++;
+            }
+        }
+    }
+    if(cases == 0) {
+        state.SkipWithError("No states could be compared.");
+        return;
+    }
+
+    state.counters["max_position_error_km"] = max_error;
+    state.counters["rms_position_error_km"] = std::sqrt(sum_squares / cases);
+    state.counters["cases"] = cases;
+}
+BENCHMARK(BM_SinglePrecisionAccuracy)->Arg(1)->Arg(7)->Arg(30)->Iterations(1)
+    ->Unit(benchmark::kMillisecond);
+
+/***********************************************************************************************//**
+ * Compares the propagated states with reference states.
+ *
+ * @param  propagate    Propagation path under test. It is called with the time since epoch (min)
+ *                      and the output position and velocity, and returns the SGP4 error code
+ * @param  reference    Rows of time, position (km) and velocity (km/s)
+ * @param  max_r        Maximum position error (km), updated
+ * @param  max_v        Maximum velocity error (km/s), updated
+ * @param  cases        Compared states, updated
+ **************************************************************************************************/
+template<typename Propagate>
+static void compareStates(
+    Propagate propagate,
+    const std::vector<std::array<double, 7>>& reference,
+    double& max_r,
+    double& max_v,
+    std::size_t& cases
+)
+{
+    for(const std::array<double, 7>& row : reference) {
+        double r[3], v[3];
+        int error = propagate(row[0], r, v);
+        cases++;
+        if(error != 0 && error != 6) {
+            g_failed_cases++;
+            continue;
+        }
+        double er = 0, ev = 0;
+        for(int c = 0; c < 3; c++) {
+            er += (r[c] - row[1 + c]) * (r[c] - row[1 + c]);
+            ev += (v[c] - row[4 + c]) * (v[c] - row[4 + c]);
+        }
+        max_r = std::max(max_r, std::sqrt(er));
+        max_v = std::max(max_v, std::sqrt(ev));
+    }
+}
+
+/***********************************************************************************************//**
+ * Reads the reference states of tcppver.out. Each object starts with a line "<satnum> xx" and
+ * continues with rows of time since epoch (min), position (km), velocity (km/s) and date.
+ **************************************************************************************************/
+static std::map<int, std::vector<std::array<double, 7>>> readReference(const std::string& path)
+{
+    std::map<int, std::vector<std::array<double, 7>>> reference;
+    std::ifstream file(path);
+    std::string line;
+    int satnum = -1;
+
+    while(std::getline(file, line)) {
+        std::istringstream row(line);
+        std::array<double, 7> values;
+        if(line.find("xx") != std::string::npos) {
+            row >> satnum;
+            continue;
+        }
+        bool valid = satnum >= 0;
+        for(int c = 0; c < 7 && valid; c++) {
+            valid = static_cast<bool>(row >> values[c]);
+        }
+        if(valid) {
+            reference[satnum].push_back(values);
+        }
+    }
+    return reference;
+}
+
+/***********************************************************************************************//**
+ * Compares a verification element set with its reference states along one propagation path: the
+ * generic SGP4Funcs::sgp4 (path 0), the kernel selected at init (path 1), sgp4Propagate of an
+ * SGP4OrbitTrajectory (path 2) or the batch propagator (path 3).
+ **************************************************************************************************/
+static void verifyPath(
+    int path,
+    const TLE& tle,
+    const elsetrec& satrec,
+    const std::vector<std::array<double, 7>>& reference,
+    double& max_r,
+    double& max_v,
+    std::size_t& cases
+)
+{
+    if(path == 0 || path == 1) {
+        elsetrec working = satrec;
+        SGP4Kernel kernel = path == 0 ? &SGP4Funcs::sgp4 : selectSGP4Kernel(working, wgs72, false);
+        compareStates([&](double time, double r[3], double v[3]) {
+            kernel(working, time, r, v);
+            return working.error;
+        }, reference, max_r, max_v, cases);
+    } else if(path == 2) {
+        std::string id = std::to_string(tle.sat_number);
+        SGP4OrbitTrajectory trajectory(tle, id, false);
+        trajectory.sgp4Init(tle, id, wgs72, 'a');
+        compareStates([&](double time, double r[3], double v[3]) {
+            std::tuple<ECICoordinates, ECICoordinates> state = trajectory.sgp4Propagate(time);
+            r[0] = std::get<0>(state).x;  r[1] = std::get<0>(state).y;  r[2] = std::get<0>(state).z;
+            v[0] = std::get<1>(state).x;  v[1] = std::get<1>(state).y;  v[2] = std::get<1>(state).z;
+            return trajectory.getSatrec().error;
+        }, reference, max_r, max_v, cases);
+    } else {
+        /* With a single satellite, the reference epoch of the batch is its own TLE epoch. */
+        SGP4BatchPropagator propagator;
+        BatchStates states;
+        propagator.addSatellite(satrec);
+        compareStates([&](double time, double r[3], double v[3]) {
+            propagator.propagate(time, states);
+            r[0] = states.x[0];  r[1] = states.y[0];  r[2] = states.z[0];
+            v[0] = states.vx[0]; v[1] = states.vy[0]; v[2] = states.vz[0];
+            return states.error[0];
+        }, reference, max_r, max_v, cases);
+    }
+}
+
+/* Accuracy against Vallado's verification states along each propagation path (see verifyPath).
+ * It runs once and reports counters; the gate takes the worst path. */
+static void BM_VerificationAccuracy(benchmark::State& state)
+{
+    TLECatalogLoader loader(1, wgs72, 'a');
+    std::map<int, std::vector<std::array<double, 7>>> reference;
+    double max_r = 0, max_v = 0;
+    std::size_t cases = 0;
+    std::size_t failed_cases = g_failed_cases;
+    int path = state.range(0);
+
+    if(!g_verification_tle.empty() && !g_verification_out.empty()) {
+        loader.load(g_verification_tle);
+        reference = readReference(g_verification_out);
+    } else {
+        loader.load(VERIFICATION_00005, std::strlen(VERIFICATION_00005));
+        for(const double* row : {REFERENCE_00005[0], REFERENCE_00005[1]}) {
+            std::array<double, 7> values;
+            std::copy(row, row + 7, values.begin());
+            reference[5].push_back(values);
+        }
+    }
+
+    state.SetLabel(path == 0 ? "generic" : path == 1 ? "specialised"
+        : path == 2 ? "sgp4Propagate" : "batch");
+    for(auto _ : state) {
+        for(std::size_t i = 0; i < loader.size(); i++) {
+            auto it = reference.find(loader.getTLEs()[i].sat_number);
+            if(it != reference.end()) {
+                verifyPath(path, loader.getTLEs()[i], loader.getSatrecs()[i], it->second,
+                    max_r, max_v, cases);
+            }
+        }
+    }
+    if(cases == 0) {
+        state.SkipWithError("No verification states could be compared.");
+        return;
+    }
+
+    g_max_position_error = std::max(g_max_position_error, max_r);
+    state.counters["max_position_error_km"] = max_r;
+    state.counters["max_velocity_error_kms"] = max_v;
+    state.counters["cases"] = cases;
+    state.counters["failed_cases"] = g_failed_cases - failed_cases;
+}
+BENCHMARK(BM_VerificationAccuracy)->Arg(0)->Arg(1)->Arg(2)->Arg(3)->Iterations(1)
+    ->Unit(benchmark::kMillisecond);
+
+/***********************************************************************************************//**
+ * Console reporter that also keeps the throughput counters of every run for the regression gate.
+ **************************************************************************************************/
+class RecordingReporter : public benchmark::ConsoleReporter
+{
+public:
+    std::map<std::string, std::map<std::string, double>> m_rates;  /**< Rates of each run */
+
+    void ReportRuns(const std::vector<Run>& runs) override
+    {
+        for(const Run& run : runs) {
+            for(const auto& counter : run.counters) {
+                if(counter.first.find("_per_second") != std::string::npos) {
+                    m_rates[run.benchmark_name()][counter.first] = counter.second.value;
+                }
+            }
+        }
+        ConsoleReporter::ReportRuns(runs);
+    }
+};
+
+/***********************************************************************************************//**
+ * Reads the "_per_second" counters of a Google Benchmark JSON file.
+ **************************************************************************************************/
+static std::map<std::string, std::map<std::string, double>> readBaseline(const std::string& path)
+{
+    std::map<std::string, std::map<std::string, double>> rates;
+    std::ifstream file(path);
+    std::string line;
+    std::string name;
+
+    while(std::getline(file, line)) {
+        std::size_t key_start = line.find('"');
+        std::size_t key_end = line.find('"', key_start + 1);
+        if(key_start == std::string::npos || key_end == std::string::npos) {
+            continue;
+        }
+        std::string key = line.substr(key_start + 1, key_end - key_start - 1);
+        std::size_t colon = line.find(':', key_end);
+        if(colon == std::string::npos) {
+            continue;
+        }
+        std::string value = line.substr(colon + 1);
+        if(key == "name") {
+            std::size_t first = value.find('"');
+            std::size_t last = value.rfind('"');
+            name = value.substr(first + 1, last - first - 1);
+        } else if(key.find("_per_second") != std::string::npos) {
+            rates[name][key] = std::strtod(value.c_str(), nullptr);
+        }
+    }
+    return rates;
+}
+
+/* Removes an option of the form --name=value from the command line. */
+static bool takeOption(int& argc, char** argv, int i, const std::string& name, std::string& value)
+{
+    std::string prefix = "--" + name + "=";
+    if(std::string(argv[i]).compare(0, prefix.size(), prefix) != 0) {
+        return false;
+    }
+    value = argv[i] + prefix.size();
+    for(int j = i; j < argc - 1; j++) {
+        argv[j] = argv[j + 1];
+    }
+    argc--;
+    return true;
+}
+
+int main(int argc, char** argv)
+{
+    std::string value;
+    int status = 0;
+
+    for(int i = 1; i < argc; ) {
+        if(takeOption(argc, argv, i, "verification_tle", g_verification_tle)
+            || takeOption(argc, argv, i, "verification_out", g_verification_out)
+            || takeOption(argc, argv, i, "baseline", g_baseline)) {
+            continue;
+        }
+        if(takeOption(argc, argv, i, "accuracy_tolerance_km", value)) {
+            g_accuracy_tolerance = std::strtod(value.c_str(), nullptr);
+            continue;
+        }
+        if(takeOption(argc, argv, i, "max_regression", value)) {
+            g_max_regression = std::strtod(value.c_str(), nullptr);
+            continue;
+        }
+        i++;
+    }
+
+    benchmark::Initialize(&argc, argv);
+    if(benchmark::ReportUnrecognizedArguments(argc, argv)) {
+        return 1;
+    }
+    RecordingReporter reporter;
+    benchmark::RunSpecifiedBenchmarks(&reporter);
+
+    /* Accuracy gate. */
+    if(g_max_position_error > g_accuracy_tolerance || g_failed_cases > 0) {
+        std::stringstream ss;
+        ss << "Accuracy gate failed: maximum position error " << g_max_position_error
+            << " km (tolerance " << g_accuracy_tolerance << " km), " << g_failed_cases
+            << " failed cases.";
+        LOG_ERROR(ss.str());
+        status = 1;
+    }
+
+    /* Throughput gate. */
+    if(!g_baseline.empty()) {
+        std::map<std::string, std::map<std::string, double>> baseline = readBaseline(g_baseline);
+        for(const auto& run : reporter.m_rates) {
+            auto previous = baseline.find(run.first);
+            if(previous == baseline.end()) {
+                continue;
+            }
+            for(const auto& rate : run.second) {
+                auto old_rate = previous->second.find(rate.first);
+                if(old_rate != previous->second.end()
+                    && rate.second < old_rate->second * (1.0 - g_max_regression)) {
+                    std::stringstream ss;
+                    ss << "Throughput regression in " << run.first << ": " << rate.first << " "
+                        << rate.second << " against " << old_rate->second << " in the baseline.";
+                    LOG_ERROR(ss.str());
+                    status = 1;
+                }
+            }
+        }
+    }
+
+    benchmark::Shutdown();
+    return status;
+}
@@ -0,0 +1,29 @@
+/***********************************************************************************************//**
+ *  Benchmark stand-in of the DSS-SIM coordinate conversions
+ *  @author     DSS-SIM development team, i2CAT
+ *  @date       2026-oct-16
+ *  @copyright  This code has been developed by Fundació Privada Internet i Innovació Digital a
+ *              Catalunya (i2CAT). i2CAT is a non-profit research and innovation centre that
+ *              promotes mission-driven knowledge to solve business challenges, co-create solutions
+ *              with a transformative impact, empower citizens through open and participative
+ *              digital social innovation with territorial capillarity, and promote pioneering and
+ *              strategic initiatives. i2CAT *aims to transfer* research project results to private
+ *              companies in order to create social and economic impact via the out-licensing of
+ *              intellectual property and the creation of spin-offs.
+ *              Find more information of i2CAT projects and IP rights at:
+ *              https://i2cat.net/tech-transfer/
+ **************************************************************************************************/
+
+#ifndef __COORDINATE_SYSTEM_UTILS_HPP__
+#define __COORDINATE_SYSTEM_UTILS_HPP__
+
+#include "ns3/vector.h"
+#include "ECICoordinates.hpp"
+
+namespace CoordinateSystemUtils
+{
+    inline ns3::Vector fromECIToNS3Vector(ECICoordinates eci) { return ns3::Vector(eci.x, eci.y, eci.z); }
+    inline ECICoordinates fromNS3VectorToECI(ns3::Vector v) { return ECICoordinates(v.x, v.y, v.z); }
+}
+
+#endif /* __COORDINATE_SYSTEM_UTILS_HPP__ */
@@ -0,0 +1,33 @@
+/***********************************************************************************************//**
+ *  Benchmark stand-in of the DSS-SIM ECI coordinates
+ *  @author     DSS-SIM development team, i2CAT
+ *  @date       2026-oct-16
+ *  @copyright  This code has been developed by Fundació Privada Internet i Innovació Digital a
+ *              Catalunya (i2CAT). i2CAT is a non-profit research and innovation centre that
+ *              promotes mission-driven knowledge to solve business challenges, co-create solutions
+ *              with a transformative impact, empower citizens through open and participative
+ *              digital social innovation with territorial capillarity, and promote pioneering and
+ *              strategic initiatives. i2CAT *aims to transfer* research project results to private
+ *              companies in order to create social and economic impact via the out-licensing of
+ *              intellectual property and the creation of spin-offs.
+ *              Find more information of i2CAT projects and IP rights at:
+ *              https://i2cat.net/tech-transfer/
+ **************************************************************************************************/
+
+#ifndef __ECI_COORDINATES_HPP__
+#define __ECI_COORDINATES_HPP__
+
+/***********************************************************************************************//**
+ * Cartesian coordinates in the Earth-centred inertial frame.
+ **************************************************************************************************/
+struct ECICoordinates
+{
+    double x;   /**< X axis */
+    double y;   /**< Y axis */
+    double z;   /**< Z axis */
+
+    ECICoordinates(void) : x(0), y(0), z(0) { }
+    ECICoordinates(double px, double py, double pz) : x(px), y(py), z(pz) { }
+};
+
+#endif /* __ECI_COORDINATES_HPP__ */
@@ -0,0 +1,26 @@
+/***********************************************************************************************//**
+ *  Benchmark stand-in of the DSS-SIM math utilities
+ *  @author     DSS-SIM development team, i2CAT
+ *  @date       2026-oct-16
+ *  @copyright  This code has been developed by Fundació Privada Internet i Innovació Digital a
+ *              Catalunya (i2CAT). i2CAT is a non-profit research and innovation centre that
+ *              promotes mission-driven knowledge to solve business challenges, co-create solutions
+ *              with a transformative impact, empower citizens through open and participative
+ *              digital social innovation with territorial capillarity, and promote pioneering and
+ *              strategic initiatives. i2CAT *aims to transfer* research project results to private
+ *              companies in order to create social and economic impact via the out-licensing of
+ *              intellectual property and the creation of spin-offs.
+ *              Find more information of i2CAT projects and IP rights at:
+ *              https://i2cat.net/tech-transfer/
+ **************************************************************************************************/
+
+#ifndef __MATH_UTILS_HPP__
+#define __MATH_UTILS_HPP__
+
+namespace MathUtils
+{
+    inline double degToRad(double deg) { return deg * 3.14159265358979323846 / 180.0; }
+    inline double radToDeg(double rad) { return rad * 180.0 / 3.14159265358979323846; }
+}
+
+#endif /* __MATH_UTILS_HPP__ */
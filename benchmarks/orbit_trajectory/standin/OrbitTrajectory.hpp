@@ -0,0 +1,38 @@
+/***********************************************************************************************//**
+ *  Benchmark stand-in of the DSS-SIM OrbitTrajectory base class
+ *  @author     DSS-SIM development team, i2CAT
+ *  @date       2026-oct-16
+ *  @copyright  This code has been developed by Fundació Privada Internet i Innovació Digital a
+ *              Catalunya (i2CAT). i2CAT is a non-profit research and innovation centre that
+ *              promotes mission-driven knowledge to solve business challenges, co-create solutions
+ *              with a transformative impact, empower citizens through open and participative
+ *              digital social innovation with territorial capillarity, and promote pioneering and
+ *              strategic initiatives. i2CAT *aims to transfer* research project results to private
+ *              companies in order to create social and economic impact via the out-licensing of
+ *              intellectual property and the creation of spin-offs.
+ *              Find more information of i2CAT projects and IP rights at:
+ *              https://i2cat.net/tech-transfer/
+ **************************************************************************************************/
+
+#ifndef __ORBIT_TRAJECTORY_HPP__
+#define __ORBIT_TRAJECTORY_HPP__
+
+#include "dss.hpp"
+#include "ECICoordinates.hpp"
+
+/***********************************************************************************************//**
+ * Base class of the orbit trajectories. The stand-in keeps the constructors and the propagation
+ * hook used by SGP4OrbitTrajectory; it does not record the trajectory.
+ **************************************************************************************************/
+class OrbitTrajectory
+{
+public:
+    OrbitTrajectory(OrbitalParams params, std::string sat_id, bool record) { }
+    OrbitTrajectory(ECICoordinates position) { }
+    virtual ~OrbitTrajectory(void) = default;
+
+protected:
+    virtual std::tuple<ECICoordinates, ECICoordinates> propagateOrbit(double time) = 0;
+};
+
+#endif /* __ORBIT_TRAJECTORY_HPP__ */
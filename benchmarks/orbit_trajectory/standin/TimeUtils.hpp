@@ -0,0 +1,28 @@
+/***********************************************************************************************//**
+ *  Benchmark stand-in of the DSS-SIM time utilities. The simulation time can be set.
+ *  @author     DSS-SIM development team, i2CAT
+ *  @date       2026-oct-16
+ *  @copyright  This code has been developed by Fundació Privada Internet i Innovació Digital a
+ *              Catalunya (i2CAT). i2CAT is a non-profit research and innovation centre that
+ *              promotes mission-driven knowledge to solve business challenges, co-create solutions
+ *              with a transformative impact, empower citizens through open and participative
+ *              digital social innovation with territorial capillarity, and promote pioneering and
+ *              strategic initiatives. i2CAT *aims to transfer* research project results to private
+ *              companies in order to create social and economic impact via the out-licensing of
+ *              intellectual property and the creation of spin-offs.
+ *              Find more information of i2CAT projects and IP rights at:
+ *              https://i2cat.net/tech-transfer/
+ **************************************************************************************************/
+
+#ifndef __TIME_UTILS_HPP__
+#define __TIME_UTILS_HPP__
+
+namespace TimeUtils
+{
+    /* Simulation time returned by getSimulationTime (in s). */
+    inline double& simulationTime(void) { static double time = 0; return time; }
+    inline double getSimulationTime(void) { return simulationTime(); }
+    inline void setSimulationTime(double time) { simulationTime() = time; }
+}
+
+#endif /* __TIME_UTILS_HPP__ */
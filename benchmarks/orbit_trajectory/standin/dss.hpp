@@ -0,0 +1,81 @@
+/***********************************************************************************************//**
+ *  Benchmark stand-in of the DSS-SIM global header: types and logging macros only
+ *  @author     DSS-SIM development team, i2CAT
+ *  @date       2026-oct-16
+ *  @copyright  This code has been developed by Fundació Privada Internet i Innovació Digital a
+ *              Catalunya (i2CAT). i2CAT is a non-profit research and innovation centre that
+ *              promotes mission-driven knowledge to solve business challenges, co-create solutions
+ *              with a transformative impact, empower citizens through open and participative
+ *              digital social innovation with territorial capillarity, and promote pioneering and
+ *              strategic initiatives. i2CAT *aims to transfer* research project results to private
+ *              companies in order to create social and economic impact via the out-licensing of
+ *              intellectual property and the creation of spin-offs.
+ *              Find more information of i2CAT projects and IP rights at:
+ *              https://i2cat.net/tech-transfer/
+ **************************************************************************************************/
+
+#ifndef __DSS_HPP__
+#define __DSS_HPP__
+
+/* External Libraries */
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+/* The benchmark only reports warnings and errors. */
+#define LOG_COMPONENT_DEFINE(name)  static const char* g_log_component = name
+#define LOG_WARN(msg)   (std::cerr << "[" << g_log_component << "] WARN: " << (msg) << std::endl)
+#define LOG_ERROR(msg)  (std::cerr << "[" << g_log_component << "] ERROR: " << (msg) << std::endl)
+#define LOG_INFO(msg)   ((void)g_log_component)
+#define LOG_DEBUG(msg)  ((void)g_log_component)
+
+/***********************************************************************************************//**
+ * Classical orbital parameters, as in DSS-SIM.
+ **************************************************************************************************/
+struct OrbitalParams
+{
+    double semimajor_axis;  /**< Semi-major axis (km) */
+    double eccentricity;    /**< Eccentricity */
+    double inclination;     /**< Inclination (deg) */
+    double arg_perigee;     /**< Argument of the perigee (deg) */
+    double raan;            /**< Right ascension of the ascending node (deg) */
+};
+
+/***********************************************************************************************//**
+ * Two-line element set, as in DSS-SIM.
+ **************************************************************************************************/
+struct TLE
+{
+    int sat_number;             /**< Satellite catalog number */
+    double mean_motion;         /**< Mean motion (rev/day) */
+    OrbitalParams orbit_params; /**< Orbital parameters */
+    double mean_anomaly;        /**< Mean anomaly (deg) */
+    double first_time;          /**< First derivative of the mean motion */
+    double second_time;         /**< Second derivative of the mean motion */
+    double bstar;               /**< Drag term (x 1e5) */
+    int tle_number;             /**< Element set number */
+    int revolutions;            /**< Revolution number at epoch */
+    int epoch_year;             /**< Epoch year (two digits) */
+    double epoch_doy;           /**< Epoch day of the year and fraction */
+};
+
+/***********************************************************************************************//**
+ * Position in the orbital plane, as in DSS-SIM.
+ **************************************************************************************************/
+struct OrbitalCoordinates
+{
+    double r;       /**< Radius (km) */
+    double nu;      /**< True anomaly (rad) */
+};
+
+#include "Globals.hpp"
+#include "MathUtils.hpp"
+
+#endif /* __DSS_HPP__ */
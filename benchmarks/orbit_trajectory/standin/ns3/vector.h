@@ -0,0 +1,39 @@
+/***********************************************************************************************//**
+ *  Benchmark stand-in of the ns-3 vector
+ *  @author     DSS-SIM development team, i2CAT
+ *  @date       2026-oct-16
+ *  @copyright  This code has been developed by Fundació Privada Internet i Innovació Digital a
+ *              Catalunya (i2CAT). i2CAT is a non-profit research and innovation centre that
+ *              promotes mission-driven knowledge to solve business challenges, co-create solutions
+ *              with a transformative impact, empower citizens through open and participative
+ *              digital social innovation with territorial capillarity, and promote pioneering and
+ *              strategic initiatives. i2CAT *aims to transfer* research project results to private
+ *              companies in order to create social and economic impact via the out-licensing of
+ *              intellectual property and the creation of spin-offs.
+ *              Find more information of i2CAT projects and IP rights at:
+ *              https://i2cat.net/tech-transfer/
+ **************************************************************************************************/
+
+#ifndef __NS3_VECTOR_H__
+#define __NS3_VECTOR_H__
+
+#include <cmath>
+
+namespace ns3
+{
+    struct Vector
+    {
+        double x, y, z;
+
+        Vector(void) : x(0), y(0), z(0) { }
+        Vector(double px, double py, double pz) : x(px), y(py), z(pz) { }
+        double GetLength(void) const { return std::sqrt(x * x + y * y + z * z); }
+    };
+
+    inline Vector operator-(const Vector& a, const Vector& b)
+    {
+        return Vector(a.x - b.x, a.y - b.y, a.z - b.z);
+    }
+}
+
+#endif /* __NS3_VECTOR_H__ */
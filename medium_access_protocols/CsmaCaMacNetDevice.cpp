@@ -17,6 +17,8 @@
 
 #include "CsmaCaMacNetDevice.hpp"
 #include "SpaceNetDevice.hpp"
+#include "ContactSchedule.hpp"
+#include "LinkDynamicsTable.hpp"
 
 LOG_COMPONENT_DEFINE("CsmaCaMacNetDevice");
 
@@ -32,6 +34,11 @@ CsmaCaMacNetDevice::CsmaCaMacNetDevice()
     , m_send_cts_event()
     , m_send_ack_event()
     , m_send_data_event()
+    , m_contact_node(0)
+    , m_contact_ground(false)
+    , m_contact_origin(0)
+    , m_parked(0)
+    , m_link_origin(0)
 {
     m_cw = m_cw_min;
     m_nav = ns3::Simulator::Now();
@@ -210,6 +217,15 @@ void CsmaCaMacNetDevice::ccaForDifs(void)
         return;
     }
     
+    /* Without any possible link, the access waits for the next window instead of polling. */
+    ns3::Time delay = getContactDelay();
+    if(delay > ns3::Seconds(0)) {
+        m_parked++;
+        m_cca_timeout_event =
+            ns3::Simulator::Schedule(delay, &CsmaCaMacNetDevice::ccaForDifs, this);
+        return;
+    }
+
     ns3::Time nav = std::max(m_nav, m_local_nav);
     if(nav > now + getSlotTime()) {
         m_cca_timeout_event = 
@@ -227,6 +243,52 @@ void CsmaCaMacNetDevice::ccaForDifs(void)
         ns3::Simulator::Schedule(getDifs(), &CsmaCaMacNetDevice::backoffStart, this);
 }
 
+void CsmaCaMacNetDevice::setContactSchedule(
+    std::shared_ptr<const ContactSchedule> schedule,
+    std::size_t node,
+    bool ground,
+    double time_origin
+)
+{
+    m_contacts = schedule;
+    m_contact_node = node;
+    m_contact_ground = ground;
+    m_contact_origin = time_origin;
+}
+
+ns3::Time CsmaCaMacNetDevice::getContactDelay(void) const
+{
+    if(!m_contacts) {
+        return ns3::Seconds(0);
+    }
+
+    double now = m_contact_origin
+        + ns3::Simulator::Now().GetSeconds() / CONTACT_SCHEDULE_SECONDS_PER_UNIT;
+    double next = m_contacts->getNextContact(m_contact_node, m_contact_ground, now);
+
+    if(next <= now) {
+        return ns3::Seconds(0);
+    }
+    /* At least one slot, so that rounding does not wake the device just before the window. */
+    return std::max(ns3::Seconds((next - now) * CONTACT_SCHEDULE_SECONDS_PER_UNIT), m_slot_time);
+}
+
+ns3::Time CsmaCaMacNetDevice::getRoundTripDelay(ns3::Mac48Address peer) const
+{
+    if(!m_link_dynamics) {
+        return ns3::Seconds(0);
+    }
+
+    std::map<ns3::Mac48Address, std::size_t>::const_iterator it = m_link_pairs.find(peer);
+    if(it == m_link_pairs.end()) {
+        return ns3::Seconds(0);
+    }
+
+    double time = m_link_origin
+        + ns3::Simulator::Now().GetSeconds() / LINK_DYNAMICS_SECONDS_PER_UNIT;
+    return ns3::Seconds(2.0 * m_link_dynamics->getDelay(it->second, time));
+}
+
 void CsmaCaMacNetDevice::backoffStart(void)
 {   
     if(m_state != IDLE || !m_space_device->IsIdle()) {
@@ -310,7 +372,8 @@ void CsmaCaMacNetDevice::sendRts(ns3::Ptr<ns3::Packet> pktData)
     packet->AddHeader(rtsHeader);
     
     ns3::Time ctsTimeout = getCtrlDuration(SW_PKT_TYPE_RTS) + getSifs() 
-        + getCtrlDuration(SW_PKT_TYPE_CTS) + getSlotTime();
+        + getCtrlDuration(SW_PKT_TYPE_CTS) + getSlotTime()
+        + getRoundTripDelay(dataHeader.getDestinationAddress());
     if(sendPacket(packet, 0)) {
         updateLocalNav(ctsTimeout);
         m_cts_timeout_event = 
@@ -345,7 +408,8 @@ void CsmaCaMacNetDevice::sendData(void)
         m_pkt_data->AddHeader(header);
         if(sendPacket(m_pkt_data, 1)) {
             ns3::Time ackTimeout = getDataDuration(m_pkt_data) + getSifs() + 
-                getCtrlDuration(SW_PKT_TYPE_ACK) + getSlotTime();
+                getCtrlDuration(SW_PKT_TYPE_ACK) + getSlotTime()
+                + getRoundTripDelay(header.getDestinationAddress());
             updateLocalNav(ackTimeout);
             m_ack_timeout_event = 
                 ns3::Simulator::Schedule(ackTimeout, &CsmaCaMacNetDevice::ackTimeout, this);
@@ -567,6 +631,8 @@ void CsmaCaMacNetDevice::ackTimeout(void)
     m_state = IDLE;
     if(++m_retry > m_data_retry_limit){    /* Retransmission is over the limit. Drop packet. */
         sendDataDone(false);
+    } else if(getContactDelay() > ns3::Seconds(0)) {   /* Window closed. Retry in the next one. */
+        startOver();
     } else{
         sendData();
     }
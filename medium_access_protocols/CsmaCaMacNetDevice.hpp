@@ -27,6 +27,8 @@
 #include <ns3/event-id.h>
 #include <ns3/drop-tail-queue.h>
 #include "ns3/random-variable-stream.h"
+#include <map>
+#include <memory>
 
 /* Internal includes */
 #include "common_networking.hpp"
@@ -36,6 +38,8 @@
 #include "SpaceNetDeviceTag.hpp"
 
 class SpaceNetDevice;     /* Needed to create a bidirectional relationship */
+class ContactSchedule;
+class LinkDynamicsTable;
 
 /***********************************************************************************************//**
  * 
@@ -362,6 +366,52 @@ public:
 
     void setQueue(ns3::Ptr<ns3::Queue<ns3::Packet>> queue){ m_queue = queue; }
 
+    /*******************************************************************************************//**
+     * Enables the contact-aware mode. While the node has no possible link, the channel access is
+     * parked until its next visibility window opens, instead of polling the channel and retrying
+     * transmissions that cannot be received. With sparse contacts, the simulator then jumps over
+     * the intervals without links. Past the end of the plan, the access is no longer parked.
+     *
+     * @param      schedule     Visibility windows of the constellation
+     * @param      node         Index of this node in the contact plan
+     * @param      ground       True if this node is a ground station
+     * @param      time_origin  Propagation time of the contact plan at simulation time 0
+     **********************************************************************************************/
+    void setContactSchedule(std::shared_ptr<const ContactSchedule> schedule, std::size_t node,
+        bool ground, double time_origin = 0.0);
+
+    /*******************************************************************************************//**
+     * Disables the contact-aware mode. A parked channel access is resumed at the next packet.
+     **********************************************************************************************/
+    void clearContactSchedule(void) { m_contacts.reset(); }
+
+    /*******************************************************************************************//**
+     * Retrieves the number of times that the channel access has been parked until a window.
+     **********************************************************************************************/
+    uint64_t getParkedCount(void) const { return m_parked; }
+
+    /*******************************************************************************************//**
+     * Sets the link-dynamics table of the constellation. The CTS and ACK timeouts of the frames
+     * sent to a registered peer are extended with the round-trip light time of the link, looked
+     * up in the table.
+     *
+     * @param      table        Link-dynamics table
+     * @param      time_origin  Propagation time of the table at simulation time 0
+     **********************************************************************************************/
+    void setLinkDynamics(std::shared_ptr<const LinkDynamicsTable> table, double time_origin = 0.0)
+    {
+        m_link_dynamics = table;
+        m_link_origin = time_origin;
+    }
+
+    /*******************************************************************************************//**
+     * Registers the pair of the link-dynamics table that joins this device with a peer.
+     *
+     * @param      peer     Address of the peer device
+     * @param      pair     Index of the pair in the link-dynamics table
+     **********************************************************************************************/
+    void addLinkPeer(ns3::Mac48Address peer, std::size_t pair) { m_link_pairs[peer] = pair; }
+
 protected:
 
     typedef enum {IDLE, BACKOFF, WAIT_TX, TX, WAIT_RX, RX, COLLISION } State;
@@ -411,6 +461,14 @@ protected:
     ns3::EventId m_send_cts_event;
     ns3::EventId m_send_ack_event;
     ns3::EventId m_send_data_event;
+    std::shared_ptr<const ContactSchedule> m_contacts;              /**< Visibility windows */
+    std::size_t m_contact_node;                                     /**< Node in the windows */
+    bool m_contact_ground;                                          /**< Node is a ground station */
+    double m_contact_origin;                                        /**< Window time at Now() = 0 */
+    uint64_t m_parked;                                              /**< Parked channel accesses */
+    std::shared_ptr<const LinkDynamicsTable> m_link_dynamics;       /**< Delays of the links */
+    double m_link_origin;                                           /**< Table time at Now() = 0 */
+    std::map<ns3::Mac48Address, std::size_t> m_link_pairs;          /**< Table pair of each peer */
 
     /*******************************************************************************************//**
      * A method that retrieves the SIFS time.
@@ -453,6 +511,23 @@ protected:
      **********************************************************************************************/
     void setCw(uint32_t cw) { m_cw = cw; }
 
+    /*******************************************************************************************//**
+     * Method that retrieves the time until the next visibility window of the node: zero if it has
+     * a link now, if the contact-aware mode is disabled or if the plan has ended.
+     *
+     * @return     Time until the next window
+     **********************************************************************************************/
+    ns3::Time getContactDelay(void) const;
+
+    /*******************************************************************************************//**
+     * Method that retrieves the round-trip light time to a peer, from the link-dynamics table.
+     * It is zero if there is no table or the peer is not registered.
+     *
+     * @param      peer     Address of the peer device
+     * @return     Round-trip propagation delay
+     **********************************************************************************************/
+    ns3::Time getRoundTripDelay(ns3::Mac48Address peer) const;
+
     /*******************************************************************************************//**
      * Method that calculates the Clear Channel Assesment for DIFS
      * 
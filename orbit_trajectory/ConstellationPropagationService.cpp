@@ -0,0 +1,65 @@
+/***********************************************************************************************//**
+ *  Class that propagates a constellation over several time steps in parallel
+ *  @class      ConstellationPropagationService
+ *  @author     DSS-SIM development team, i2CAT
+ *  @date       2026-oct-16
+ *  @copyright  This code has been developed by Fundació Privada Internet i Innovació Digital a
+ *              Catalunya (i2CAT). i2CAT is a non-profit research and innovation centre that
+ *              promotes mission-driven knowledge to solve business challenges, co-create solutions
+ *              with a transformative impact, empower citizens through open and participative
+ *              digital social innovation with territorial capillarity, and promote pioneering and
+ *              strategic initiatives. i2CAT *aims to transfer* research project results to private
+ *              companies in order to create social and economic impact via the out-licensing of
+ *              intellectual property and the creation of spin-offs.
+ *              Find more information of i2CAT projects and IP rights at:
+ *              https://i2cat.net/tech-transfer/
+ **************************************************************************************************/
+
+#include "ConstellationPropagationService.hpp"
+
+LOG_COMPONENT_DEFINE("ConstellationPropagationService");
+
+ConstellationPropagationService::ConstellationPropagationService(
+    std::shared_ptr<const SGP4BatchPropagator> propagator,
+    unsigned int threads,
+    std::size_t block_size
+)
+    : m_propagator(propagator)
+    , m_pool(threads)
+    , m_block_size(std::max<std::size_t>(block_size, SGP4_BATCH_LANES))
+    , m_start(0)
+    , m_step(0)
+{ }
+
+void ConstellationPropagationService::propagate(double start, double step, std::size_t steps)
+{
+    std::size_t satellites = m_propagator->size();
+    std::size_t blocks = (satellites + m_block_size - 1) / m_block_size;
+
+    m_start = start;
+    m_step = step;
+    m_table.resize(steps);
+    for(BatchStates& states : m_table) {
+        states.resize(satellites);
+    }
+
+    m_pool.parallelFor(blocks * steps, [this, blocks, satellites](std::size_t task) {
+        std::size_t step_index = task / blocks;
+        std::size_t begin = (task % blocks) * m_block_size;
+        std::size_t end = std::min(begin + m_block_size, satellites);
+        BatchStates& states = m_table[step_index];
+
+        m_propagator->propagate(getTime(step_index), begin, end, states.x.data(),
+            states.y.data(), states.z.data(), states.vx.data(), states.vy.data(),
+            states.vz.data(), states.error.data());
+    });
+}
+
+ECICoordinates ConstellationPropagationService::getPosition(
+    std::size_t step,
+    std::size_t satellite
+) const
+{
+    const BatchStates& states = m_table[step];
+    return ECICoordinates(states.x[satellite], states.y[satellite], states.z[satellite]);
+}
@@ -0,0 +1,114 @@
+/***********************************************************************************************//**
+ *  Class that propagates a constellation over several time steps in parallel
+ *  @class      ConstellationPropagationService
+ *  @author     DSS-SIM development team, i2CAT
+ *  @date       2026-oct-16
+ *  @copyright  This code has been developed by Fundació Privada Internet i Innovació Digital a
+ *              Catalunya (i2CAT). i2CAT is a non-profit research and innovation centre that
+ *              promotes mission-driven knowledge to solve business challenges, co-create solutions
+ *              with a transformative impact, empower citizens through open and participative
+ *              digital social innovation with territorial capillarity, and promote pioneering and
+ *              strategic initiatives. i2CAT *aims to transfer* research project results to private
+ *              companies in order to create social and economic impact via the out-licensing of
+ *              intellectual property and the creation of spin-offs.
+ *              Find more information of i2CAT projects and IP rights at:
+ *              https://i2cat.net/tech-transfer/
+ **************************************************************************************************/
+
+#ifndef __CONSTELLATION_PROPAGATION_SERVICE_HPP__
+#define __CONSTELLATION_PROPAGATION_SERVICE_HPP__
+
+/* Global libraries */
+#include "dss.hpp"
+
+/* External Libraries */
+#include <memory>
+#include <vector>
+
+/* Internal Libraries */
+#include "ECICoordinates.hpp"
+#include "SGP4BatchPropagator.hpp"
+#include "WorkStealingPool.hpp"
+
+/***********************************************************************************************//**
+ * Service that fills a table of constellation states for a series of equally spaced time steps
+ * before the simulation needs them. The work is split in (satellite block x time step) tasks that
+ * run on a work-stealing thread pool. Every task writes a disjoint range of the table and the
+ * value of each cell only depends on its satellite and time, so the table is identical whatever
+ * the number of threads.
+ *
+ * @see     SGP4BatchPropagator
+ * @see     WorkStealingPool
+ **************************************************************************************************/
+class ConstellationPropagationService
+{
+public:
+    /*******************************************************************************************//**
+     * Constructs the service.
+     *
+     * @param  propagator   Batch propagator of the constellation
+     * @param  threads      Number of worker threads (0 to use all the hardware threads)
+     * @param  block_size   Number of satellites propagated by each task
+     **********************************************************************************************/
+    ConstellationPropagationService(
+        std::shared_ptr<const SGP4BatchPropagator> propagator,
+        unsigned int threads = 0,
+        std::size_t block_size = 256
+    );
+
+    /*******************************************************************************************//**
+     * Auto-generated destructor.
+     **********************************************************************************************/
+    ~ConstellationPropagationService(void) = default;
+
+    /*******************************************************************************************//**
+     * Propagates the whole constellation for a series of time steps, replacing the previous table.
+     *
+     * @param  start    Time of the first step, from the reference epoch of the propagator
+     * @param  step     Time between consecutive steps
+     * @param  steps    Number of time steps
+     **********************************************************************************************/
+    void propagate(double start, double step, std::size_t steps);
+
+    /*******************************************************************************************//**
+     * Retrieves the number of time steps of the table.
+     **********************************************************************************************/
+    std::size_t getStepCount(void) const { return m_table.size(); }
+
+    /*******************************************************************************************//**
+     * Retrieves the time of a step of the table.
+     *
+     * @param  step     Index of the time step
+     **********************************************************************************************/
+    double getTime(std::size_t step) const { return m_start + m_step * step; }
+
+    /*******************************************************************************************//**
+     * Retrieves the states of the whole constellation at a time step.
+     *
+     * @param  step     Index of the time step
+     **********************************************************************************************/
+    const BatchStates& getStates(std::size_t step) const { return m_table[step]; }
+
+    /*******************************************************************************************//**
+     * Retrieves the position of a satellite at a time step.
+     *
+     * @param  step         Index of the time step
+     * @param  satellite    Index of the satellite in the batch propagator
+     **********************************************************************************************/
+    ECICoordinates getPosition(std::size_t step, std::size_t satellite) const;
+
+    /*******************************************************************************************//**
+     * Retrieves the thread pool of the service, so other constellation-wide stages can share it.
+     **********************************************************************************************/
+    WorkStealingPool& getPool(void) { return m_pool; }
+
+private:
+    std::shared_ptr<const SGP4BatchPropagator> m_propagator;    /**< Constellation propagator */
+    WorkStealingPool m_pool;                                    /**< Worker threads */
+    std::size_t m_block_size;                                   /**< Satellites per task */
+    double m_start;                                             /**< Time of the first step */
+    double m_step;                                              /**< Time between steps */
+    std::vector<BatchStates> m_table;                           /**< States per time step */
+};
+
+#endif /* __CONSTELLATION_PROPAGATION_SERVICE_HPP__ */
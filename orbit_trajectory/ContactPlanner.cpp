@@ -0,0 +1,326 @@
+/***********************************************************************************************//**
+ *  Class that computes the contact windows of a constellation and its ground stations
+ *  @class      ContactPlanner
+ *  @author     DSS-SIM development team, i2CAT
+ *  @date       2026-oct-16
+ *  @copyright  This code has been developed by Fundació Privada Internet i Innovació Digital a
+ *              Catalunya (i2CAT). i2CAT is a non-profit research and innovation centre that
+ *              promotes mission-driven knowledge to solve business challenges, co-create solutions
+ *              with a transformative impact, empower citizens through open and participative
+ *              digital social innovation with territorial capillarity, and promote pioneering and
+ *              strategic initiatives. i2CAT *aims to transfer* research project results to private
+ *              companies in order to create social and economic impact via the out-licensing of
+ *              intellectual property and the creation of spin-offs.
+ *              Find more information of i2CAT projects and IP rights at:
+ *              https://i2cat.net/tech-transfer/
+ **************************************************************************************************/
+
+#include "ContactPlanner.hpp"
+
+#include <algorithm>
+
+LOG_COMPONENT_DEFINE("ContactPlanner");
+
+#define CONTACT_LATITUDE_MARGIN 0.01    /**< Margin of the latitude filter (rad), which covers the
+                                          *  geodetic/geocentric difference and node precession */
+#define CONTACT_BLOCK_STEPS     16      /**< Coarse steps propagated at once */
+
+ContactPlanner::ContactPlanner(double jd_start, double min_elevation, unsigned int threads)
+    : m_pool(threads)
+    , m_jd_start(jd_start)
+    , m_min_elevation(min_elevation * Globals::constants.pi / 180.0)
+    , m_isl(false)
+    , m_max_range(0)
+    , m_min_clearance(0)
+    , m_coarse_step(1.0)
+    , m_tolerance(1.0e-4)
+    , m_pruned(0)
+{
+    m_propagator.setReferenceEpoch(m_jd_start);
+}
+
+std::size_t ContactPlanner::addSatellite(const SGP4OrbitTrajectory& trajectory)
+{
+    return addSatellite(trajectory.getSatrec());
+}
+
+std::size_t ContactPlanner::addSatellite(const elsetrec& satrec)
+{
+    m_satrecs.push_back(satrec);
+    m_propagator.addSatellite(satrec);
+    return m_satrecs.size() - 1;
+}
+
+std::size_t ContactPlanner::addGroundStation(const GroundStation& station)
+{
+    m_stations.push_back(station);
+    return m_stations.size() - 1;
+}
+
+void ContactPlanner::enableInterSatelliteLinks(double max_range, double min_clearance)
+{
+    m_isl = true;
+    m_max_range = max_range;
+    m_min_clearance = min_clearance;
+}
+
+void ContactPlanner::setResolution(double coarse_step, double tolerance)
+{
+    if(coarse_step <= 0 || tolerance <= 0) {
+        LOG_WARN("The contact search resolution shall be positive; it is not changed.");
+        return;
+    }
+    m_coarse_step = coarse_step;
+    m_tolerance = tolerance;
+}
+
+ECICoordinates ContactPlanner::groundStationToECI(
+    const GroundStation& station,
+    double gmst,
+    ECICoordinates& up
+)
+{
+    double lat = station.latitude * Globals::constants.pi / 180.0;
+    double lon = station.longitude * Globals::constants.pi / 180.0 + gmst;
+    double e2 = CONTACT_WGS84_FLATTENING * (2.0 - CONTACT_WGS84_FLATTENING);
+    double sin_lat = std::sin(lat);
+    double cos_lat = std::cos(lat);
+    double n = CONTACT_WGS84_RADIUS / std::sqrt(1.0 - e2 * sin_lat * sin_lat);
+
+    up = ECICoordinates(cos_lat * std::cos(lon), cos_lat * std::sin(lon), sin_lat);
+    return ECICoordinates((n + station.altitude) * cos_lat * std::cos(lon),
+        (n + station.altitude) * cos_lat * std::sin(lon),
+        (n * (1.0 - e2) + station.altitude) * sin_lat);
+}
+
+std::vector<Contact> ContactPlanner::computePlan(double start, double end)
+{
+    std::vector<Pair> pairs;
+    std::vector<Contact> plan;
+
+    m_pruned = 0;
+    for(std::size_t i = 0; i < m_satrecs.size(); i++) {
+        std::vector<Pair> candidates;
+        for(std::size_t j = 0; j < m_stations.size(); j++) {
+            candidates.push_back(Pair{i, j, true});
+        }
+        for(std::size_t j = i + 1; m_isl && j < m_satrecs.size(); j++) {
+            candidates.push_back(Pair{i, j, false});
+        }
+        for(const Pair& pair : candidates) {
+            if(isImpossible(pair)) {
+                m_pruned++;
+            } else {
+                pairs.push_back(pair);
+            }
+        }
+    }
+
+    /* Search state of each pair: last sample, its visibility and the last rise. */
+    struct Search
+    {
+        double t0;
+        double f0;
+        double rise;
+    };
+
+    std::vector<std::vector<Contact>> contacts(pairs.size());
+    std::vector<Search> searches(pairs.size(), Search{start, 0.0, start});
+    std::size_t steps = std::max<std::size_t>(1, std::ceil((end - start) / m_coarse_step));
+    std::size_t stations = m_stations.size();
+    std::vector<BatchStates> states(CONTACT_BLOCK_STEPS);
+    std::vector<double> times(CONTACT_BLOCK_STEPS);
+    std::vector<ECICoordinates> positions(CONTACT_BLOCK_STEPS * stations);
+    std::vector<ECICoordinates> ups(CONTACT_BLOCK_STEPS * stations);
+
+    /* The constellation and the stations are moved once per coarse step, block by block. */
+    for(std::size_t block = 0; block <= steps; block += CONTACT_BLOCK_STEPS) {
+        std::size_t count = std::min<std::size_t>(CONTACT_BLOCK_STEPS, steps + 1 - block);
+        for(std::size_t k = 0; k < count; k++) {
+            times[k] = std::min(start + (block + k) * m_coarse_step, end);
+            double gmst = SGP4Funcs::gstime(m_jd_start + times[k] * CONTACT_TIME_UNIT_DAYS);
+            for(std::size_t j = 0; j < stations; j++) {
+                positions[k * stations + j] = groundStationToECI(m_stations[j], gmst,
+                    ups[k * stations + j]);
+            }
+        }
+        m_pool.parallelFor(count, [&](std::size_t k) {
+            m_propagator.propagate(times[k], states[k]);
+        });
+
+        m_pool.parallelFor(pairs.size(), [&](std::size_t index) {
+            const Pair& pair = pairs[index];
+            Search& search = searches[index];
+            for(std::size_t k = 0; k < count; k++) {
+                double t1 = times[k];
+                double f1 = visibility(pair, states[k], &positions[k * stations],
+                    &ups[k * stations]);
+                if(block + k > 0 && (search.f0 > 0) != (f1 > 0)) {
+                    /* Working copies, since SGP4 updates the element sets of deep-space orbits. */
+                    elsetrec first = m_satrecs[pair.satellite];
+                    elsetrec second = pair.ground ? first : m_satrecs[pair.peer];
+                    double crossing = refine(pair, first, second, search.t0, search.f0, t1);
+                    if(f1 > 0) {
+                        search.rise = crossing;
+                    } else {
+                        contacts[index].push_back(
+                            Contact{pair.satellite, pair.peer, pair.ground, search.rise, crossing});
+                    }
+                }
+                search.t0 = t1;
+                search.f0 = f1;
+            }
+        });
+    }
+    for(std::size_t index = 0; index < pairs.size(); index++) {
+        if(searches[index].f0 > 0) {
+            const Pair& pair = pairs[index];
+            contacts[index].push_back(
+                Contact{pair.satellite, pair.peer, pair.ground, searches[index].rise, end});
+        }
+    }
+
+    for(const std::vector<Contact>& pair_contacts : contacts) {
+        plan.insert(plan.end(), pair_contacts.begin(), pair_contacts.end());
+    }
+    std::sort(plan.begin(), plan.end(), [](const Contact& a, const Contact& b) {
+        if(a.start != b.start) {
+            return a.start < b.start;
+        }
+        if(a.satellite != b.satellite) {
+            return a.satellite < b.satellite;
+        }
+        if(a.ground != b.ground) {
+            return a.ground;
+        }
+        return a.peer < b.peer;
+    });
+    return plan;
+}
+
+bool ContactPlanner::isImpossible(const Pair& pair) const
+{
+    const elsetrec& sat = m_satrecs[pair.satellite];
+    double perigee = sat.a * (1.0 - sat.ecco) * sat.radiusearthkm;
+    double apogee = sat.a * (1.0 + sat.ecco) * sat.radiusearthkm;
+
+    if(pair.ground) {
+        /* The station shall be inside the latitude band swept by the footprint at apogee. */
+        double max_latitude = std::min(sat.inclo, Globals::constants.pi - sat.inclo);
+        double ratio = CONTACT_WGS84_RADIUS * std::cos(m_min_elevation) / apogee;
+        double footprint = std::acos(std::min(ratio, 1.0)) - m_min_elevation;
+        double latitude = std::fabs(m_stations[pair.peer].latitude) * Globals::constants.pi / 180.0;
+        return latitude > max_latitude + footprint + CONTACT_LATITUDE_MARGIN;
+    }
+
+    /* Altitude shells farther apart than the maximum range can never be linked. */
+    const elsetrec& other = m_satrecs[pair.peer];
+    double other_perigee = other.a * (1.0 - other.ecco) * other.radiusearthkm;
+    double other_apogee = other.a * (1.0 + other.ecco) * other.radiusearthkm;
+    double gap = std::max(other_perigee - apogee, perigee - other_apogee);
+    return m_max_range > 0 && gap > m_max_range;
+}
+
+double ContactPlanner::visibility(
+    const Pair& pair,
+    const BatchStates& states,
+    const ECICoordinates* stations,
+    const ECICoordinates* ups
+) const
+{
+    std::size_t i = pair.satellite;
+    std::size_t j = pair.peer;
+
+    if(states.error[i] != 0 || (!pair.ground && states.error[j] != 0)) {
+        return -1;
+    }
+
+    double r[3] = {states.x[i], states.y[i], states.z[i]};
+    if(pair.ground) {
+        return visibility(pair, r, r, stations[j], ups[j]);
+    }
+    double r2[3] = {states.x[j], states.y[j], states.z[j]};
+    return visibility(pair, r, r2, ECICoordinates(), ECICoordinates());
+}
+
+double ContactPlanner::visibility(
+    const Pair& pair,
+    const double r[3],
+    const double r2[3],
+    const ECICoordinates& station,
+    const ECICoordinates& up
+) const
+{
+    if(pair.ground) {
+        double dx = r[0] - station.x;
+        double dy = r[1] - station.y;
+        double dz = r[2] - station.z;
+        double range = std::sqrt(dx * dx + dy * dy + dz * dz);
+        double sin_elevation = (dx * up.x + dy * up.y + dz * up.z) / range;
+        return std::asin(sin_elevation) - m_min_elevation;
+    }
+
+    /* Distance from the Earth centre to the closest point of the line of sight. */
+    double d[3] = {r2[0] - r[0], r2[1] - r[1], r2[2] - r[2]};
+    double d2 = d[0] * d[0] + d[1] * d[1] + d[2] * d[2];
+    double s = -(r[0] * d[0] + r[1] * d[1] + r[2] * d[2]) / d2;
+    s = std::min(std::max(s, 0.0), 1.0);
+    double p[3] = {r[0] + s * d[0], r[1] + s * d[1], r[2] + s * d[2]};
+    double clearance = std::sqrt(p[0] * p[0] + p[1] * p[1] + p[2] * p[2])
+        - CONTACT_WGS84_RADIUS - m_min_clearance;
+
+    if(m_max_range > 0) {
+        return std::min(clearance, m_max_range - std::sqrt(d2));
+    }
+    return clearance;
+}
+
+double ContactPlanner::visibility(
+    const Pair& pair,
+    elsetrec& first,
+    elsetrec& second,
+    double time
+) const
+{
+    double r[3], v[3];
+
+    /* SGP4 measures the time from the epoch of each element set, the plan from jd_start. */
+    if(!SGP4Funcs::sgp4(first, time - m_propagator.getEpochOffset(pair.satellite), r, v)) {
+        return -1;
+    }
+
+    if(pair.ground) {
+        ECICoordinates up;
+        double gmst = SGP4Funcs::gstime(m_jd_start + time * CONTACT_TIME_UNIT_DAYS);
+        ECICoordinates station = groundStationToECI(m_stations[pair.peer], gmst, up);
+        return visibility(pair, r, r, station, up);
+    }
+
+    double r2[3], v2[3];
+    if(!SGP4Funcs::sgp4(second, time - m_propagator.getEpochOffset(pair.peer), r2, v2)) {
+        return -1;
+    }
+    return visibility(pair, r, r2, ECICoordinates(), ECICoordinates());
+}
+
+double ContactPlanner::refine(
+    const Pair& pair,
+    elsetrec& first,
+    elsetrec& second,
+    double t0,
+    double f0,
+    double t1
+) const
+{
+    while(t1 - t0 > m_tolerance) {
+        double middle = 0.5 * (t0 + t1);
+        double f = visibility(pair, first, second, middle);
+        if((f > 0) == (f0 > 0)) {
+            t0 = middle;
+            f0 = f;
+        } else {
+            t1 = middle;
+        }
+    }
+    return 0.5 * (t0 + t1);
+}
@@ -0,0 +1,240 @@
+/***********************************************************************************************//**
+ *  Class that computes the contact windows of a constellation and its ground stations
+ *  @class      ContactPlanner
+ *  @author     DSS-SIM development team, i2CAT
+ *  @date       2026-oct-16
+ *  @copyright  This code has been developed by Fundació Privada Internet i Innovació Digital a
+ *              Catalunya (i2CAT). i2CAT is a non-profit research and innovation centre that
+ *              promotes mission-driven knowledge to solve business challenges, co-create solutions
+ *              with a transformative impact, empower citizens through open and participative
+ *              digital social innovation with territorial capillarity, and promote pioneering and
+ *              strategic initiatives. i2CAT *aims to transfer* research project results to private
+ *              companies in order to create social and economic impact via the out-licensing of
+ *              intellectual property and the creation of spin-offs.
+ *              Find more information of i2CAT projects and IP rights at:
+ *              https://i2cat.net/tech-transfer/
+ **************************************************************************************************/
+
+#ifndef __CONTACT_PLANNER_HPP__
+#define __CONTACT_PLANNER_HPP__
+
+/* Global libraries */
+#include "dss.hpp"
+
+/* External Libraries */
+#include <string>
+#include <vector>
+#include "SGP4.h"
+
+/* Internal Libraries */
+#include "ECICoordinates.hpp"
+#include "SGP4BatchPropagator.hpp"
+#include "SGP4OrbitTrajectory.hpp"
+#include "WorkStealingPool.hpp"
+
+#define CONTACT_MIN_ELEVATION   10.0            /**< Elevation mask, as in Clouds::isValid (deg) */
+#define CONTACT_TIME_UNIT_DAYS  (1.0 / 1440.0)  /**< Days per unit of propagation time (SGP4
+                                                  *  evaluates its time argument in minutes) */
+#define CONTACT_WGS84_RADIUS    6378.137        /**< WGS84 equatorial radius (km) */
+#define CONTACT_WGS84_FLATTENING (1.0 / 298.257223563)  /**< WGS84 flattening */
+
+/***********************************************************************************************//**
+ * Ground station, fixed on the rotating Earth.
+ **************************************************************************************************/
+struct GroundStation
+{
+    std::string name;       /**< Name of the station */
+    double latitude;        /**< Geodetic latitude (deg) */
+    double longitude;       /**< Longitude, positive to the East (deg) */
+    double altitude;        /**< Altitude over the WGS84 ellipsoid (km) */
+};
+
+/***********************************************************************************************//**
+ * Contact window between a satellite and a ground station, or between two satellites.
+ **************************************************************************************************/
+struct Contact
+{
+    std::size_t satellite;  /**< Index of the satellite */
+    std::size_t peer;       /**< Index of the ground station, or of the second satellite */
+    bool ground;            /**< True if the peer is a ground station */
+    double start;           /**< Rise time, from the jd_start of the planner (in min) */
+    double end;             /**< Set time, from the jd_start of the planner (in min) */
+};
+
+/***********************************************************************************************//**
+ * Contact window engine. For every satellite/ground-station and satellite/satellite pair, the
+ * visibility function (elevation over the mask for ground links, line-of-sight clearance over the
+ * Earth and maximum range for inter-satellite links) is sampled on a coarse grid to bracket its
+ * sign changes, and every rise and set time is refined by bisection. The whole constellation is
+ * propagated once per coarse step with the batch propagator, and the pairs are sampled from those
+ * states; the scalar SGP4 routine is only evaluated by the bisections.
+ *
+ * Pairs that can never be in contact are discarded before sampling: stations out of the latitude
+ * band that the inclination of the orbital plane and the footprint allow, and satellites whose
+ * altitude shells are farther apart than the maximum range. Two orbital planes always cross on a
+ * line through the Earth centre, so satellites of different planes come as close as their shells
+ * allow and there is no sound plane filter for the inter-satellite links beyond the shell one.
+ *
+ * The coarse step shall be shorter than the shortest contact of interest: contacts that start and
+ * end between two samples are not detected.
+ *
+ * @see     SGP4OrbitTrajectory
+ **************************************************************************************************/
+class ContactPlanner
+{
+public:
+    /*******************************************************************************************//**
+     * Constructs the planner.
+     *
+     * @param  jd_start         Julian date (UT1) at plan time 0, used to rotate the Earth.
+     *                          The satellites are propagated to the same instant whatever the
+     *                          epochs of their element sets.
+     * @param  min_elevation    Elevation mask of the ground links (deg)
+     * @param  threads          Number of worker threads (0 to use all the hardware threads)
+     **********************************************************************************************/
+    ContactPlanner(double jd_start, double min_elevation = CONTACT_MIN_ELEVATION,
+        unsigned int threads = 0);
+
+    /*******************************************************************************************//**
+     * Auto-generated destructor.
+     **********************************************************************************************/
+    ~ContactPlanner(void) = default;
+
+    /*******************************************************************************************//**
+     * Adds a satellite. The element set is copied, so the trajectory can be destroyed afterwards.
+     *
+     * @param  trajectory   Trajectory initialised with sgp4Init
+     * @return              Index of the satellite
+     **********************************************************************************************/
+    std::size_t addSatellite(const SGP4OrbitTrajectory& trajectory);
+
+    /*******************************************************************************************//**
+     * Adds a satellite given its initialised SGP4 element set.
+     *
+     * @param  satrec   Element set initialised with sgp4init
+     * @return          Index of the satellite
+     **********************************************************************************************/
+    std::size_t addSatellite(const elsetrec& satrec);
+
+    /*******************************************************************************************//**
+     * Adds a ground station.
+     *
+     * @param  station  Ground station
+     * @return          Index of the station
+     **********************************************************************************************/
+    std::size_t addGroundStation(const GroundStation& station);
+
+    /*******************************************************************************************//**
+     * Enables the inter-satellite links in the plan.
+     *
+     * @param  max_range        Maximum range of a link (km, 0 for no limit)
+     * @param  min_clearance    Minimum altitude of the line of sight over the Earth (km)
+     **********************************************************************************************/
+    void enableInterSatelliteLinks(double max_range, double min_clearance = 100.0);
+
+    /*******************************************************************************************//**
+     * Sets the resolution of the search.
+     *
+     * @param  coarse_step  Step of the bracketing grid
+     * @param  tolerance    Accuracy of the rise and set times
+     **********************************************************************************************/
+    void setResolution(double coarse_step, double tolerance);
+
+    /*******************************************************************************************//**
+     * Computes the contact plan in a time interval. Contacts in progress at the limits of the
+     * interval are clipped to them.
+     *
+     * @param  start    Start of the interval, from jd_start (in min)
+     * @param  end      End of the interval, from jd_start (in min)
+     * @return          Contacts sorted by start time
+     **********************************************************************************************/
+    std::vector<Contact> computePlan(double start, double end);
+
+    /*******************************************************************************************//**
+     * Retrieves the number of pairs discarded by the pruning filters in the last plan.
+     **********************************************************************************************/
+    std::size_t getPrunedPairs(void) const { return m_pruned; }
+
+    /*******************************************************************************************//**
+     * Computes the ECI position of a ground station.
+     *
+     * @param  station  Ground station
+     * @param  gmst     Greenwich mean sidereal time (rad)
+     * @param  up       Output unit vector normal to the ellipsoid at the station
+     * @return          ECI position of the station (km)
+     **********************************************************************************************/
+    static ECICoordinates groundStationToECI(const GroundStation& station, double gmst,
+        ECICoordinates& up);
+
+private:
+    /*******************************************************************************************//**
+     * Pair of nodes whose visibility is searched.
+     **********************************************************************************************/
+    struct Pair
+    {
+        std::size_t satellite;  /**< Index of the satellite */
+        std::size_t peer;       /**< Index of the station or of the second satellite */
+        bool ground;            /**< True if the peer is a ground station */
+    };
+
+    WorkStealingPool m_pool;                    /**< Worker threads */
+    double m_jd_start;                          /**< Julian date at propagation time 0 */
+    double m_min_elevation;                     /**< Elevation mask (rad) */
+    bool m_isl;                                 /**< Inter-satellite links enabled */
+    double m_max_range;                         /**< Maximum range of the ISLs (km, 0: none) */
+    double m_min_clearance;                     /**< Minimum line-of-sight altitude (km) */
+    double m_coarse_step;                       /**< Step of the bracketing grid */
+    double m_tolerance;                         /**< Accuracy of the rise and set times */
+    std::size_t m_pruned;                       /**< Pairs pruned in the last plan */
+    std::vector<elsetrec> m_satrecs;            /**< Element sets of the satellites */
+    SGP4BatchPropagator m_propagator;           /**< Propagator of the coarse grid */
+    std::vector<GroundStation> m_stations;      /**< Ground stations */
+
+    /*******************************************************************************************//**
+     * Checks if a pair can never be in contact.
+     **********************************************************************************************/
+    bool isImpossible(const Pair& pair) const;
+
+    /*******************************************************************************************//**
+     * Evaluates the visibility function of a pair from the states of a coarse step.
+     *
+     * @param  pair     Pair of nodes
+     * @param  states   States of the constellation
+     * @param  stations ECI position of each ground station at the time of the states
+     * @param  ups      Unit vector normal to the ellipsoid at each ground station
+     **********************************************************************************************/
+    double visibility(const Pair& pair, const BatchStates& states, const ECICoordinates* stations,
+        const ECICoordinates* ups) const;
+
+    /*******************************************************************************************//**
+     * Evaluates the visibility function of a pair given the positions of its nodes.
+     *
+     * @param  pair     Pair of nodes
+     * @param  r        ECI position of the satellite (km)
+     * @param  r2       ECI position of the second satellite (km, ISLs)
+     * @param  station  ECI position of the ground station (km, ground links)
+     * @param  up       Unit vector normal to the ellipsoid at the station (ground links)
+     **********************************************************************************************/
+    double visibility(const Pair& pair, const double r[3], const double r2[3],
+        const ECICoordinates& station, const ECICoordinates& up) const;
+
+    /*******************************************************************************************//**
+     * Evaluates the visibility function of a pair. It is positive when the pair is in contact.
+     *
+     * @param  pair     Pair of nodes
+     * @param  first    Working copy of the element set of the satellite
+     * @param  second   Working copy of the element set of the second satellite (ISLs)
+     * @param  time     Propagation time
+     **********************************************************************************************/
+    double visibility(const Pair& pair, elsetrec& first, elsetrec& second, double time) const;
+
+    /*******************************************************************************************//**
+     * Refines a sign change of the visibility function by bisection.
+     *
+     * @return  Time of the sign change
+     **********************************************************************************************/
+    double refine(const Pair& pair, elsetrec& first, elsetrec& second, double t0, double f0,
+        double t1) const;
+};
+
+#endif /* __CONTACT_PLANNER_HPP__ */
@@ -0,0 +1,104 @@
+/***********************************************************************************************//**
+ *  Per-node visibility windows built from a contact plan
+ *  @class      ContactSchedule
+ *  @author     DSS-SIM development team, i2CAT
+ *  @date       2026-oct-16
+ *  @copyright  This code has been developed by Fundació Privada Internet i Innovació Digital a
+ *              Catalunya (i2CAT). i2CAT is a non-profit research and innovation centre that
+ *              promotes mission-driven knowledge to solve business challenges, co-create solutions
+ *              with a transformative impact, empower citizens through open and participative
+ *              digital social innovation with territorial capillarity, and promote pioneering and
+ *              strategic initiatives. i2CAT *aims to transfer* research project results to private
+ *              companies in order to create social and economic impact via the out-licensing of
+ *              intellectual property and the creation of spin-offs.
+ *              Find more information of i2CAT projects and IP rights at:
+ *              https://i2cat.net/tech-transfer/
+ **************************************************************************************************/
+
+#include "ContactSchedule.hpp"
+
+#include <algorithm>
+
+LOG_COMPONENT_DEFINE("ContactSchedule");
+
+ContactSchedule::ContactSchedule(const std::vector<Contact>& plan, double end, double guard)
+    : m_end(end)
+{
+    for(const Contact& contact : plan) {
+        Window window{contact.start - guard, contact.end + guard};
+        std::vector<std::vector<Window>>& peers = contact.ground ? m_stations : m_satellites;
+
+        if(contact.satellite >= m_satellites.size()) {
+            m_satellites.resize(contact.satellite + 1);
+        }
+        if(contact.peer >= peers.size()) {
+            peers.resize(contact.peer + 1);
+        }
+        m_satellites[contact.satellite].push_back(window);
+        peers[contact.peer].push_back(window);
+    }
+    merge(m_satellites);
+    merge(m_stations);
+}
+
+void ContactSchedule::merge(std::vector<std::vector<Window>>& nodes)
+{
+    for(std::vector<Window>& windows : nodes) {
+        std::vector<Window> merged;
+
+        std::sort(windows.begin(), windows.end(), [](const Window& a, const Window& b) {
+            return a.start < b.start;
+        });
+        for(const Window& window : windows) {
+            if(!merged.empty() && window.start <= merged.back().end) {
+                merged.back().end = std::max(merged.back().end, window.end);
+            } else {
+                merged.push_back(window);
+            }
+        }
+        windows.swap(merged);
+    }
+}
+
+const std::vector<ContactSchedule::Window>& ContactSchedule::getWindows(
+    std::size_t node,
+    bool ground
+) const
+{
+    static const std::vector<Window> none;
+    const std::vector<std::vector<Window>>& nodes = ground ? m_stations : m_satellites;
+
+    return node < nodes.size() ? nodes[node] : none;
+}
+
+double ContactSchedule::getNextContact(std::size_t node, bool ground, double time) const
+{
+    const std::vector<Window>& windows = getWindows(node, ground);
+
+    /* Past the end of the plan nothing is known, so the node shall not wait. */
+    if(time >= m_end) {
+        return time;
+    }
+
+    /* First window that has not ended yet. */
+    std::vector<Window>::const_iterator it = std::lower_bound(windows.begin(), windows.end(),
+        time, [](const Window& window, double t) { return window.end < t; });
+
+    if(it == windows.end() || it->start >= m_end) {
+        return m_end;
+    }
+    return std::max(it->start, time);
+}
+
+double ContactSchedule::getDutyCycle(std::size_t node, bool ground, double start, double end) const
+{
+    double covered = 0;
+
+    if(end <= start) {
+        return 0.0;
+    }
+    for(const Window& window : getWindows(node, ground)) {
+        covered += std::max(0.0, std::min(window.end, end) - std::max(window.start, start));
+    }
+    return covered / (end - start);
+}
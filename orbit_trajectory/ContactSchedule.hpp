@@ -0,0 +1,124 @@
+/***********************************************************************************************//**
+ *  Per-node visibility windows built from a contact plan
+ *  @class      ContactSchedule
+ *  @author     DSS-SIM development team, i2CAT
+ *  @date       2026-oct-16
+ *  @copyright  This code has been developed by Fundació Privada Internet i Innovació Digital a
+ *              Catalunya (i2CAT). i2CAT is a non-profit research and innovation centre that
+ *              promotes mission-driven knowledge to solve business challenges, co-create solutions
+ *              with a transformative impact, empower citizens through open and participative
+ *              digital social innovation with territorial capillarity, and promote pioneering and
+ *              strategic initiatives. i2CAT *aims to transfer* research project results to private
+ *              companies in order to create social and economic impact via the out-licensing of
+ *              intellectual property and the creation of spin-offs.
+ *              Find more information of i2CAT projects and IP rights at:
+ *              https://i2cat.net/tech-transfer/
+ **************************************************************************************************/
+
+#ifndef __CONTACT_SCHEDULE_HPP__
+#define __CONTACT_SCHEDULE_HPP__
+
+/* Global libraries */
+#include "dss.hpp"
+
+/* External Libraries */
+#include <vector>
+
+/* Internal Libraries */
+#include "ContactPlanner.hpp"
+
+#define CONTACT_SCHEDULE_SECONDS_PER_UNIT   60.0    /**< Seconds per unit of propagation time
+                                                         (SGP4 uses minutes) */
+
+/***********************************************************************************************//**
+ * Visibility windows of every node of a contact plan. The contacts of each satellite and of each
+ * ground station, with any peer, are widened by a guard time and merged, so a node can tell in
+ * O(log n) whether it has a link at a time and, if not, when the next one starts. It is used by
+ * the MAC layers to park their timers across the intervals without any possible link, which lets
+ * the event loop jump over them.
+ *
+ * Times are measured from the jd_start of the planner, as in ContactPlanner::computePlan. The plan
+ * only covers the interval for which it was computed: past its end, the windows are unknown and
+ * every node is reported to have a possible link, so that no timer is parked forever.
+ *
+ * @see     ContactPlanner
+ **************************************************************************************************/
+class ContactSchedule
+{
+public:
+    /*******************************************************************************************//**
+     * Builds the windows of a contact plan.
+     *
+     * @param  plan     Contacts, as computed by ContactPlanner::computePlan
+     * @param  end      End of the interval of the plan
+     * @param  guard    Time added before and after every contact, to absorb the tolerance of the
+     *                  plan and the time of the last exchange
+     **********************************************************************************************/
+    ContactSchedule(const std::vector<Contact>& plan, double end, double guard = 0.0);
+
+    /*******************************************************************************************//**
+     * Auto-generated destructor.
+     **********************************************************************************************/
+    ~ContactSchedule(void) = default;
+
+    /*******************************************************************************************//**
+     * Retrieves the first time, not earlier than a given one, at which a node has a link.
+     *
+     * @param  node     Index of the satellite or of the ground station
+     * @param  ground   True if the node is a ground station
+     * @param  time     Time from jd_start (in min)
+     * @return          The time itself if the node has a link or the time is past the end of the
+     *                  plan, the start of its next window otherwise, or the end of the plan if
+     *                  there are no more windows in it
+     **********************************************************************************************/
+    double getNextContact(std::size_t node, bool ground, double time) const;
+
+    /*******************************************************************************************//**
+     * Retrieves the end of the interval covered by the plan.
+     **********************************************************************************************/
+    double getEnd(void) const { return m_end; }
+
+    /*******************************************************************************************//**
+     * Checks if a node has a link at a time.
+     **********************************************************************************************/
+    bool inContact(std::size_t node, bool ground, double time) const
+    {
+        return getNextContact(node, ground, time) <= time;
+    }
+
+    /*******************************************************************************************//**
+     * Retrieves the fraction of an interval in which a node has a link.
+     *
+     * @param  node     Index of the satellite or of the ground station
+     * @param  ground   True if the node is a ground station
+     * @param  start    Start of the interval
+     * @param  end      End of the interval
+     **********************************************************************************************/
+    double getDutyCycle(std::size_t node, bool ground, double start, double end) const;
+
+private:
+    /*******************************************************************************************//**
+     * Merged window of a node.
+     **********************************************************************************************/
+    struct Window
+    {
+        double start;   /**< Start of the window */
+        double end;     /**< End of the window */
+    };
+
+    double m_end;                                   /**< End of the interval of the plan */
+    std::vector<std::vector<Window>> m_satellites;  /**< Windows of each satellite, by start */
+    std::vector<std::vector<Window>> m_stations;    /**< Windows of each station, by start */
+
+    /*******************************************************************************************//**
+     * Retrieves the windows of a node (empty if the node has no contacts).
+     **********************************************************************************************/
+    const std::vector<Window>& getWindows(std::size_t node, bool ground) const;
+
+    /*******************************************************************************************//**
+     * Sorts and merges the overlapping windows of every node.
+     **********************************************************************************************/
+    static void merge(std::vector<std::vector<Window>>& nodes);
+};
+
+#endif /* __CONTACT_SCHEDULE_HPP__ */
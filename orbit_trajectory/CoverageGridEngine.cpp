@@ -0,0 +1,313 @@
+/***********************************************************************************************//**
+ *  Earth-coverage statistics of a constellation over an equal-area grid
+ *  @class      CoverageGridEngine
+ *  @author     DSS-SIM development team, i2CAT
+ *  @date       2026-oct-16
+ *  @copyright  This code has been developed by Fundació Privada Internet i Innovació Digital a
+ *              Catalunya (i2CAT). i2CAT is a non-profit research and innovation centre that
+ *              promotes mission-driven knowledge to solve business challenges, co-create solutions
+ *              with a transformative impact, empower citizens through open and participative
+ *              digital social innovation with territorial capillarity, and promote pioneering and
+ *              strategic initiatives. i2CAT *aims to transfer* research project results to private
+ *              companies in order to create social and economic impact via the out-licensing of
+ *              intellectual property and the creation of spin-offs.
+ *              Find more information of i2CAT projects and IP rights at:
+ *              https://i2cat.net/tech-transfer/
+ **************************************************************************************************/
+
+#include "CoverageGridEngine.hpp"
+#include "ECISpatialIndex.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+
+LOG_COMPONENT_DEFINE("CoverageGridEngine");
+
+CoverageGridEngine::CoverageGridEngine(
+    double jd_start,
+    std::size_t cells,
+    double min_elevation,
+    unsigned int threads
+)
+    : m_pool(threads)
+    , m_jd_start(jd_start)
+    , m_min_elevation(min_elevation * Globals::constants.pi / 180.0)
+    , m_cell_count(0)
+    , m_steps(0)
+{
+    m_propagator.setReferenceEpoch(m_jd_start);
+    buildGrid(std::max<std::size_t>(cells, 2));
+    m_stats.resize(m_cell_count, CoverageCellStatistics{0, 0, 0, 0.0, 0.0, 0.0, false, false});
+    m_counts.resize(m_cell_count, 0);
+}
+
+std::size_t CoverageGridEngine::addSatellite(const SGP4OrbitTrajectory& trajectory)
+{
+    return m_propagator.addSatellite(trajectory);
+}
+
+std::size_t CoverageGridEngine::addSatellite(const elsetrec& satrec)
+{
+    return m_propagator.addSatellite(satrec);
+}
+
+void CoverageGridEngine::buildGrid(std::size_t cells)
+{
+    double pi = Globals::constants.pi;
+    double cell_area = 4.0 * pi / cells;
+    std::size_t rings = std::max<std::size_t>(1, std::round(std::sqrt(pi * cells) / 2.0));
+
+    /* Rings of equal height in latitude, each split in as many cells of the nominal area as fit
+     * in it. The centre of the cells halves the area of the ring. */
+    for(std::size_t k = 0; k < rings; k++) {
+        double south = std::sin(-pi / 2.0 + k * pi / rings);
+        double north = std::sin(-pi / 2.0 + (k + 1) * pi / rings);
+        double area = 2.0 * pi * (north - south);
+        std::size_t count = std::max<std::size_t>(1, std::round(area / cell_area));
+        double sin_lat = (south + north) / 2.0;
+
+        m_rings.push_back(Ring{m_cell_count, count, sin_lat, std::sqrt(1.0 - sin_lat * sin_lat),
+            area / (4.0 * pi * count)});
+        m_cell_count += count;
+    }
+
+    /* Tiles of consecutive cells, with the sphere that holds them. */
+    for(std::size_t k = 0; k < m_rings.size(); k++) {
+        const Ring& ring = m_rings[k];
+        for(std::size_t first = 0; first < ring.count; first += COVERAGE_TILE_CELLS) {
+            Tile tile{k, first, std::min<std::size_t>(COVERAGE_TILE_CELLS, ring.count - first),
+                ECICoordinates(), 0.0};
+            std::vector<ECICoordinates> positions;
+            ECICoordinates up;
+
+            for(std::size_t j = first; j < first + tile.count; j++) {
+                double lon = (j + 0.5) * 2.0 * pi / ring.count - pi;
+                positions.push_back(toEarthFixed(ring, std::cos(lon), std::sin(lon), up));
+                tile.center.x += positions.back().x / tile.count;
+                tile.center.y += positions.back().y / tile.count;
+                tile.center.z += positions.back().z / tile.count;
+            }
+            for(const ECICoordinates& position : positions) {
+                double dx = position.x - tile.center.x;
+                double dy = position.y - tile.center.y;
+                double dz = position.z - tile.center.z;
+                tile.radius = std::max(tile.radius, std::sqrt(dx * dx + dy * dy + dz * dz));
+            }
+            m_tiles.push_back(tile);
+        }
+    }
+}
+
+std::size_t CoverageGridEngine::findRing(std::size_t cell) const
+{
+    std::vector<Ring>::const_iterator it = std::upper_bound(m_rings.begin(), m_rings.end(), cell,
+        [](std::size_t index, const Ring& ring) { return index < ring.first; });
+
+    return (it - m_rings.begin()) - 1;
+}
+
+void CoverageGridEngine::getCellCenter(std::size_t cell, double& latitude, double& longitude) const
+{
+    const Ring& ring = m_rings[findRing(cell)];
+
+    latitude = std::asin(ring.sin_lat) * 180.0 / Globals::constants.pi;
+    longitude = (cell - ring.first + 0.5) * 360.0 / ring.count - 180.0;
+}
+
+double CoverageGridEngine::getCellWeight(std::size_t cell) const
+{
+    return m_rings[findRing(cell)].weight;
+}
+
+ECICoordinates CoverageGridEngine::toEarthFixed(
+    const Ring& ring,
+    double cos_lon,
+    double sin_lon,
+    ECICoordinates& up
+)
+{
+    double e2 = CONTACT_WGS84_FLATTENING * (2.0 - CONTACT_WGS84_FLATTENING);
+    double n = CONTACT_WGS84_RADIUS / std::sqrt(1.0 - e2 * ring.sin_lat * ring.sin_lat);
+
+    up = ECICoordinates(ring.cos_lat * cos_lon, ring.cos_lat * sin_lon, ring.sin_lat);
+    return ECICoordinates(n * up.x, n * up.y, n * (1.0 - e2) * up.z);
+}
+
+double CoverageGridEngine::getMaxSlantRange(double max_radius) const
+{
+    /* The slant range at the mask grows as the Earth radius shrinks, so the polar radius bounds
+     * it for every cell. */
+    if(m_min_elevation < 0) {
+        return max_radius + CONTACT_WGS84_RADIUS;
+    }
+
+    double sin_mask = std::sin(m_min_elevation);
+    double cos_mask = std::cos(m_min_elevation);
+    double r2 = max_radius * max_radius
+        - COVERAGE_POLAR_RADIUS * COVERAGE_POLAR_RADIUS * cos_mask * cos_mask;
+
+    return std::sqrt(std::max(r2, 0.0)) - COVERAGE_POLAR_RADIUS * sin_mask;
+}
+
+void CoverageGridEngine::accumulate(CoverageCellStatistics& stats, uint16_t count, double time)
+{
+    if(count > 0) {
+        if(!stats.covered) {
+            double gap = time - stats.gap_start;
+            stats.max_gap = std::max(stats.max_gap, gap);
+            if(stats.seen) {
+                stats.revisits++;
+                stats.revisit_sum += gap;
+            }
+            stats.covered = true;
+            stats.seen = true;
+        }
+        stats.covered_steps++;
+        stats.max_visible = std::max<uint32_t>(stats.max_visible, count);
+    } else if(stats.covered) {
+        stats.covered = false;
+        stats.gap_start = time;
+    }
+}
+
+void CoverageGridEngine::run(double start, double end, double step)
+{
+    if(step <= 0 || end < start) {
+        LOG_WARN("The coverage interval shall be ordered and the step positive; nothing is run.");
+        return;
+    }
+
+    std::size_t satellites = m_propagator.size();
+    double sin_mask = std::sin(m_min_elevation);
+    BatchStates states;
+    std::unique_ptr<ECISpatialIndex> index;
+
+    m_steps = (std::size_t)((end - start) / step + 1.0e-9) + 1;
+    std::fill(m_stats.begin(), m_stats.end(),
+        CoverageCellStatistics{0, 0, 0, 0.0, 0.0, start, false, false});
+
+    for(std::size_t k = 0; k < m_steps; k++) {
+        double time = start + k * step;
+        double gmst = SGP4Funcs::gstime(m_jd_start + time * CONTACT_TIME_UNIT_DAYS);
+        double cos_gmst = std::cos(gmst);
+        double sin_gmst = std::sin(gmst);
+        double max_radius = 0;
+
+        /* The satellites are rotated to the Earth-fixed frame, where the cells do not move.
+         * Failed satellites are placed at the centre of the Earth, below every horizon. */
+        m_propagator.propagate(time, states);
+        for(std::size_t i = 0; i < satellites; i++) {
+            double x = 0, y = 0, z = 0;
+            if(states.error[i] == 0) {
+                x = cos_gmst * states.x[i] + sin_gmst * states.y[i];
+                y = -sin_gmst * states.x[i] + cos_gmst * states.y[i];
+                z = states.z[i];
+                max_radius = std::max(max_radius, std::sqrt(x * x + y * y + z * z));
+            }
+            states.x[i] = x;
+            states.y[i] = y;
+            states.z[i] = z;
+        }
+
+        double range = getMaxSlantRange(max_radius);
+        if(!index) {
+            index.reset(new ECISpatialIndex(std::max(range, 1.0)));
+        }
+        index->update(states);
+
+        m_pool.parallelFor(m_tiles.size(), [&](std::size_t t) {
+            static thread_local std::vector<std::size_t> candidates;
+            static thread_local std::vector<double> sx, sy, sz;
+            const Tile& tile = m_tiles[t];
+            const Ring& ring = m_rings[tile.ring];
+
+            index->queryRange(tile.center, range + tile.radius, candidates);
+            std::size_t n = candidates.size();
+            sx.resize(n);
+            sy.resize(n);
+            sz.resize(n);
+            for(std::size_t c = 0; c < n; c++) {
+                ECICoordinates position = index->getPosition(candidates[c]);
+                sx[c] = position.x;
+                sy[c] = position.y;
+                sz[c] = position.z;
+            }
+            const double* px = sx.data();
+            const double* py = sy.data();
+            const double* pz = sz.data();
+
+            /* The longitude advances by a fixed angle from one cell to the next. */
+            double pi = Globals::constants.pi;
+            double delta = 2.0 * pi / ring.count;
+            double lon = (tile.first + 0.5) * delta - pi;
+            double cos_lon = std::cos(lon);
+            double sin_lon = std::sin(lon);
+            double cos_delta = std::cos(delta);
+            double sin_delta = std::sin(delta);
+
+            for(std::size_t j = 0; j < tile.count; j++) {
+                ECICoordinates up;
+                ECICoordinates cell = toEarthFixed(ring, cos_lon, sin_lon, up);
+                std::size_t visible = 0;
+
+                for(std::size_t c = 0; c < n; c++) {
+                    double dx = px[c] - cell.x;
+                    double dy = py[c] - cell.y;
+                    double dz = pz[c] - cell.z;
+                    double height = dx * up.x + dy * up.y + dz * up.z;
+                    visible += height >= sin_mask * std::sqrt(dx * dx + dy * dy + dz * dz);
+                }
+
+                std::size_t cell_index = ring.first + tile.first + j;
+                uint16_t count = (uint16_t)std::min<std::size_t>(visible,
+                    std::numeric_limits<uint16_t>::max());
+                m_counts[cell_index] = count;
+                accumulate(m_stats[cell_index], count, time);
+
+                double next = cos_lon * cos_delta - sin_lon * sin_delta;
+                sin_lon = sin_lon * cos_delta + cos_lon * sin_delta;
+                cos_lon = next;
+            }
+        });
+
+        if(m_callback) {
+            m_callback(time, m_counts);
+        }
+    }
+
+    /* Gaps still open at the end of the run. */
+    double last = start + (m_steps - 1) * step;
+    for(CoverageCellStatistics& stats : m_stats) {
+        if(!stats.covered) {
+            stats.max_gap = std::max(stats.max_gap, last - stats.gap_start);
+        }
+    }
+}
+
+double CoverageGridEngine::getMeanCoverage(void) const
+{
+    double coverage = 0;
+
+    if(m_steps == 0) {
+        return 0.0;
+    }
+    for(const Ring& ring : m_rings) {
+        for(std::size_t j = ring.first; j < ring.first + ring.count; j++) {
+            coverage += ring.weight * m_stats[j].covered_steps;
+        }
+    }
+    return coverage / m_steps;
+}
+
+double CoverageGridEngine::getEverCovered(void) const
+{
+    double covered = 0;
+
+    for(const Ring& ring : m_rings) {
+        for(std::size_t j = ring.first; j < ring.first + ring.count; j++) {
+            covered += m_stats[j].seen ? ring.weight : 0.0;
+        }
+    }
+    return covered;
+}
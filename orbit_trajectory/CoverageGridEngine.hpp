@@ -0,0 +1,244 @@
+/***********************************************************************************************//**
+ *  Earth-coverage statistics of a constellation over an equal-area grid
+ *  @class      CoverageGridEngine
+ *  @author     DSS-SIM development team, i2CAT
+ *  @date       2026-oct-16
+ *  @copyright  This code has been developed by Fundació Privada Internet i Innovació Digital a
+ *              Catalunya (i2CAT). i2CAT is a non-profit research and innovation centre that
+ *              promotes mission-driven knowledge to solve business challenges, co-create solutions
+ *              with a transformative impact, empower citizens through open and participative
+ *              digital social innovation with territorial capillarity, and promote pioneering and
+ *              strategic initiatives. i2CAT *aims to transfer* research project results to private
+ *              companies in order to create social and economic impact via the out-licensing of
+ *              intellectual property and the creation of spin-offs.
+ *              Find more information of i2CAT projects and IP rights at:
+ *              https://i2cat.net/tech-transfer/
+ **************************************************************************************************/
+
+#ifndef __COVERAGE_GRID_ENGINE_HPP__
+#define __COVERAGE_GRID_ENGINE_HPP__
+
+/* Global libraries */
+#include "dss.hpp"
+
+/* External Libraries */
+#include <functional>
+#include <vector>
+#include "SGP4.h"
+
+/* Internal Libraries */
+#include "ContactPlanner.hpp"
+#include "ECICoordinates.hpp"
+#include "SGP4BatchPropagator.hpp"
+#include "SGP4OrbitTrajectory.hpp"
+#include "WorkStealingPool.hpp"
+
+#define COVERAGE_TILE_CELLS     64              /**< Maximum number of cells of a tile */
+#define COVERAGE_POLAR_RADIUS   6356.752314     /**< WGS84 polar radius (km) */
+
+/***********************************************************************************************//**
+ * Coverage statistics of one grid cell. Times have the same meaning as in sgp4Propagate.
+ **************************************************************************************************/
+struct CoverageCellStatistics
+{
+    uint32_t covered_steps;     /**< Steps with at least one satellite over the mask */
+    uint32_t max_visible;       /**< Maximum number of satellites seen at once */
+    uint32_t revisits;          /**< Gaps closed on both sides by a covered step */
+    double revisit_sum;         /**< Sum of the closed gaps */
+    double max_gap;             /**< Longest time without coverage, including the open gaps at
+                                  *  the limits of the run */
+    double gap_start;           /**< Start of the current gap (internal state of the run) */
+    bool covered;               /**< The cell was covered at the last step (internal state) */
+    bool seen;                  /**< The cell has been covered at least once */
+
+    /*******************************************************************************************//**
+     * Retrieves the mean time between two coverages, or 0 if there has been no revisit.
+     **********************************************************************************************/
+    double getMeanRevisit(void) const { return revisits > 0 ? revisit_sum / revisits : 0.0; }
+};
+
+/***********************************************************************************************//**
+ * Coverage engine. The surface of the Earth is split in an equal-area grid of iso-latitude rings,
+ * in the spirit of HEALPix: the rings have the same height in latitude and the number of cells of
+ * a ring is proportional to its area, so every cell spans almost the same area. Each cell weighs
+ * its exact area in the global figures. Cells are never stored: their positions are derived from
+ * their index.
+ *
+ * At each step the constellation is propagated in batch, rotated to the Earth-fixed frame and
+ * loaded in a spatial index. The cells are processed in parallel by tiles of consecutive cells of
+ * a ring; a single range query per tile, with the maximum slant range for the elevation mask,
+ * gathers the candidate satellites, whose elevation is then tested against every cell of the tile
+ * in a branch-free loop over contiguous arrays that the compiler vectorises.
+ *
+ * Only streaming statistics are kept per cell (covered time, gaps and revisit times), so the
+ * memory does not grow with the number of steps. The per-cell counts of each step are passed to
+ * an optional callback and then overwritten.
+ *
+ * @see     SGP4BatchPropagator
+ * @see     ECISpatialIndex
+ * @see     ContactPlanner
+ **************************************************************************************************/
+class CoverageGridEngine
+{
+public:
+    /*******************************************************************************************//**
+     * Function called after every step with its time and the number of satellites over the mask
+     * of every cell.
+     **********************************************************************************************/
+    typedef std::function<void(double, const std::vector<uint16_t>&)> StepCallback;
+
+    /*******************************************************************************************//**
+     * Constructs the engine and its grid.
+     *
+     * @param  jd_start         Julian date (UT1) at propagation time 0, used to rotate the Earth
+     * @param  cells            Approximate number of grid cells
+     * @param  min_elevation    Elevation mask (deg)
+     * @param  threads          Number of worker threads (0 to use all the hardware threads)
+     **********************************************************************************************/
+    CoverageGridEngine(double jd_start, std::size_t cells,
+        double min_elevation = CONTACT_MIN_ELEVATION, unsigned int threads = 0);
+
+    /*******************************************************************************************//**
+     * Auto-generated destructor.
+     **********************************************************************************************/
+    ~CoverageGridEngine(void) = default;
+
+    /*******************************************************************************************//**
+     * Adds a satellite. The element set is copied, so the trajectory can be destroyed afterwards.
+     *
+     * @param  trajectory   Trajectory initialised with sgp4Init
+     * @return              Index of the satellite
+     **********************************************************************************************/
+    std::size_t addSatellite(const SGP4OrbitTrajectory& trajectory);
+
+    /*******************************************************************************************//**
+     * Adds a satellite given its initialised SGP4 element set.
+     *
+     * @param  satrec   Element set initialised with sgp4init
+     * @return          Index of the satellite
+     **********************************************************************************************/
+    std::size_t addSatellite(const elsetrec& satrec);
+
+    /*******************************************************************************************//**
+     * Sets the function called after every step (none by default).
+     **********************************************************************************************/
+    void setStepCallback(const StepCallback& callback) { m_callback = callback; }
+
+    /*******************************************************************************************//**
+     * Computes the coverage statistics of a time interval. The statistics of a previous run are
+     * discarded.
+     *
+     * @param  start    Start of the interval, with the same meaning as in sgp4Propagate
+     * @param  end      End of the interval
+     * @param  step     Time between steps
+     **********************************************************************************************/
+    void run(double start, double end, double step);
+
+    /*******************************************************************************************//**
+     * Retrieves the number of cells of the grid.
+     **********************************************************************************************/
+    std::size_t getCellCount(void) const { return m_cell_count; }
+
+    /*******************************************************************************************//**
+     * Retrieves the centre of a cell.
+     *
+     * @param  cell         Index of the cell
+     * @param  latitude     Output geodetic latitude (deg)
+     * @param  longitude    Output longitude, positive to the East (deg)
+     **********************************************************************************************/
+    void getCellCenter(std::size_t cell, double& latitude, double& longitude) const;
+
+    /*******************************************************************************************//**
+     * Retrieves the area of a cell, as a fraction of the surface of the Earth.
+     **********************************************************************************************/
+    double getCellWeight(std::size_t cell) const;
+
+    /*******************************************************************************************//**
+     * Retrieves the statistics of a cell in the last run.
+     **********************************************************************************************/
+    const CoverageCellStatistics& getStatistics(std::size_t cell) const { return m_stats[cell]; }
+
+    /*******************************************************************************************//**
+     * Retrieves the area-weighted mean fraction of time that the cells were covered in the last
+     * run.
+     **********************************************************************************************/
+    double getMeanCoverage(void) const;
+
+    /*******************************************************************************************//**
+     * Retrieves the fraction of the surface of the Earth covered at least once in the last run.
+     **********************************************************************************************/
+    double getEverCovered(void) const;
+
+private:
+    /*******************************************************************************************//**
+     * Iso-latitude ring of cells.
+     **********************************************************************************************/
+    struct Ring
+    {
+        std::size_t first;      /**< Index of the first cell */
+        std::size_t count;      /**< Number of cells */
+        double sin_lat;         /**< Sine of the latitude of the cell centres */
+        double cos_lat;         /**< Cosine of the latitude of the cell centres */
+        double weight;          /**< Area of each cell, as a fraction of the whole surface */
+    };
+
+    /*******************************************************************************************//**
+     * Run of consecutive cells of a ring, processed as a single task.
+     **********************************************************************************************/
+    struct Tile
+    {
+        std::size_t ring;       /**< Index of the ring */
+        std::size_t first;      /**< Index of the first cell in the ring */
+        std::size_t count;      /**< Number of cells */
+        ECICoordinates center;  /**< Earth-fixed centre of the tile (km) */
+        double radius;          /**< Distance from the centre to the farthest cell (km) */
+    };
+
+    WorkStealingPool m_pool;                        /**< Worker threads */
+    SGP4BatchPropagator m_propagator;               /**< Constellation */
+    double m_jd_start;                              /**< Julian date at propagation time 0 */
+    double m_min_elevation;                         /**< Elevation mask (rad) */
+    std::size_t m_cell_count;                       /**< Number of cells */
+    std::vector<Ring> m_rings;                      /**< Rings, from the South pole */
+    std::vector<Tile> m_tiles;                      /**< Tasks of a step */
+    std::vector<CoverageCellStatistics> m_stats;    /**< Statistics of each cell */
+    std::vector<uint16_t> m_counts;                 /**< Visible satellites of each cell */
+    std::size_t m_steps;                            /**< Steps of the last run */
+    StepCallback m_callback;                        /**< Per-step output */
+
+    /*******************************************************************************************//**
+     * Builds the rings and the tiles of the grid.
+     **********************************************************************************************/
+    void buildGrid(std::size_t cells);
+
+    /*******************************************************************************************//**
+     * Retrieves the ring that holds a cell.
+     **********************************************************************************************/
+    std::size_t findRing(std::size_t cell) const;
+
+    /*******************************************************************************************//**
+     * Computes the Earth-fixed position and the unit normal of the centre of a cell.
+     *
+     * @param  ring         Ring of the cell
+     * @param  cos_lon      Cosine of the longitude of the cell
+     * @param  sin_lon      Sine of the longitude of the cell
+     * @param  up           Output unit vector normal to the ellipsoid
+     * @return              Position on the ellipsoid (km)
+     **********************************************************************************************/
+    static ECICoordinates toEarthFixed(const Ring& ring, double cos_lon, double sin_lon,
+        ECICoordinates& up);
+
+    /*******************************************************************************************//**
+     * Updates the statistics of a cell with the count of a step.
+     **********************************************************************************************/
+    static void accumulate(CoverageCellStatistics& stats, uint16_t count, double time);
+
+    /*******************************************************************************************//**
+     * Computes the maximum distance between a point of the grid and a satellite over the mask.
+     *
+     * @param  max_radius   Largest geocentric distance of the satellites (km)
+     **********************************************************************************************/
+    double getMaxSlantRange(double max_radius) const;
+};
+
+#endif /* __COVERAGE_GRID_ENGINE_HPP__ */
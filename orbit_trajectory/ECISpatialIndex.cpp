@@ -0,0 +1,227 @@
+/***********************************************************************************************//**
+ *  Class that indexes ECI positions in a uniform grid for range and neighbour queries
+ *  @class      ECISpatialIndex
+ *  @author     DSS-SIM development team, i2CAT
+ *  @date       2026-oct-16
+ *  @copyright  This code has been developed by Fundació Privada Internet i Innovació Digital a
+ *              Catalunya (i2CAT). i2CAT is a non-profit research and innovation centre that
+ *              promotes mission-driven knowledge to solve business challenges, co-create solutions
+ *              with a transformative impact, empower citizens through open and participative
+ *              digital social innovation with territorial capillarity, and promote pioneering and
+ *              strategic initiatives. i2CAT *aims to transfer* research project results to private
+ *              companies in order to create social and economic impact via the out-licensing of
+ *              intellectual property and the creation of spin-offs.
+ *              Find more information of i2CAT projects and IP rights at:
+ *              https://i2cat.net/tech-transfer/
+ **************************************************************************************************/
+
+#include "ECISpatialIndex.hpp"
+
+#include <algorithm>
+#include <queue>
+
+LOG_COMPONENT_DEFINE("ECISpatialIndex");
+
+#define SPATIAL_INDEX_KEY_BITS      21                          /**< Bits per cell coordinate */
+#define SPATIAL_INDEX_KEY_OFFSET    (int64_t(1) << 20)          /**< Bias of cell coordinates */
+#define SPATIAL_INDEX_KEY_MASK      ((uint64_t(1) << 21) - 1)   /**< Mask of a cell coordinate */
+
+ECISpatialIndex::ECISpatialIndex(double cell_size)
+    : m_cell_size(cell_size)
+    , m_moves(0)
+{
+    if(m_cell_size <= 0) {
+        LOG_WARN("The cell size shall be positive; the default size is used.");
+        m_cell_size = SPATIAL_INDEX_CELL_SIZE;
+    }
+}
+
+int64_t ECISpatialIndex::toCell(double coordinate) const
+{
+    return (int64_t)std::floor(coordinate / m_cell_size);
+}
+
+uint64_t ECISpatialIndex::toKey(int64_t i, int64_t j, int64_t k)
+{
+    return ((uint64_t)(i + SPATIAL_INDEX_KEY_OFFSET) & SPATIAL_INDEX_KEY_MASK)
+        | (((uint64_t)(j + SPATIAL_INDEX_KEY_OFFSET) & SPATIAL_INDEX_KEY_MASK)
+            << SPATIAL_INDEX_KEY_BITS)
+        | (((uint64_t)(k + SPATIAL_INDEX_KEY_OFFSET) & SPATIAL_INDEX_KEY_MASK)
+            << (2 * SPATIAL_INDEX_KEY_BITS));
+}
+
+void ECISpatialIndex::unlink(std::size_t node)
+{
+    auto cell = m_cells.find(m_nodes[node].cell);
+    std::vector<std::size_t>& list = cell->second;
+    std::size_t slot = m_nodes[node].slot;
+
+    /* Swap with the last node of the cell to remove in constant time. */
+    list[slot] = list.back();
+    m_nodes[list[slot]].slot = slot;
+    list.pop_back();
+    if(list.empty()) {
+        m_cells.erase(cell);
+    }
+}
+
+void ECISpatialIndex::link(std::size_t node, uint64_t cell)
+{
+    std::vector<std::size_t>& list = m_cells[cell];
+    m_nodes[node].cell = cell;
+    m_nodes[node].slot = list.size();
+    list.push_back(node);
+}
+
+void ECISpatialIndex::update(std::size_t node, const ECICoordinates& position)
+{
+    uint64_t cell = toKey(toCell(position.x), toCell(position.y), toCell(position.z));
+
+    while(m_nodes.size() <= node) {
+        /* New nodes are linked at their first position. */
+        m_nodes.push_back(Node{position.x, position.y, position.z, 0, 0});
+        link(m_nodes.size() - 1, cell);
+    }
+
+    Node& entry = m_nodes[node];
+    entry.x = position.x;
+    entry.y = position.y;
+    entry.z = position.z;
+    if(entry.cell != cell) {
+        unlink(node);
+        link(node, cell);
+        m_moves++;
+    }
+}
+
+void ECISpatialIndex::update(const BatchStates& states)
+{
+    for(std::size_t i = 0; i < states.size(); i++) {
+        update(i, ECICoordinates(states.x[i], states.y[i], states.z[i]));
+    }
+}
+
+ECICoordinates ECISpatialIndex::getPosition(std::size_t node) const
+{
+    const Node& entry = m_nodes[node];
+    return ECICoordinates(entry.x, entry.y, entry.z);
+}
+
+template<typename F>
+void ECISpatialIndex::forEachCell(
+    int64_t ci,
+    int64_t cj,
+    int64_t ck,
+    int64_t radius,
+    bool shell,
+    F visit
+) const
+{
+    double side = 2.0 * radius + 1.0;
+
+    if(side * side * side > (double)m_cells.size()) {
+        for(const auto& cell : m_cells) {
+            visit(cell.second);
+        }
+        return;
+    }
+
+    for(int64_t i = ci - radius; i <= ci + radius; i++) {
+        for(int64_t j = cj - radius; j <= cj + radius; j++) {
+            bool inner = shell && std::abs(i - ci) < radius && std::abs(j - cj) < radius;
+            for(int64_t k = ck - radius; k <= ck + radius; k += inner ? 2 * radius : 1) {
+                auto cell = m_cells.find(toKey(i, j, k));
+                if(cell != m_cells.end()) {
+                    visit(cell->second);
+                }
+                if(radius == 0) {
+                    break;
+                }
+            }
+        }
+    }
+}
+
+void ECISpatialIndex::queryRange(
+    const ECICoordinates& center,
+    double radius,
+    std::vector<std::size_t>& result
+) const
+{
+    double radius2 = radius * radius;
+    int64_t cells = (int64_t)std::ceil(radius / m_cell_size);
+
+    result.clear();
+    forEachCell(toCell(center.x), toCell(center.y), toCell(center.z), cells, false,
+        [&](const std::vector<std::size_t>& list) {
+            for(std::size_t node : list) {
+                const Node& entry = m_nodes[node];
+                double dx = entry.x - center.x;
+                double dy = entry.y - center.y;
+                double dz = entry.z - center.z;
+                if(dx * dx + dy * dy + dz * dz <= radius2) {
+                    result.push_back(node);
+                }
+            }
+        });
+}
+
+void ECISpatialIndex::queryNearest(
+    const ECICoordinates& center,
+    std::size_t count,
+    std::vector<std::size_t>& result
+) const
+{
+    std::priority_queue<std::pair<double, std::size_t>> best;
+    int64_t ci = toCell(center.x);
+    int64_t cj = toCell(center.y);
+    int64_t ck = toCell(center.z);
+    std::size_t visited = 0;
+
+    auto visit = [&](const std::vector<std::size_t>& list) {
+        for(std::size_t node : list) {
+            const Node& entry = m_nodes[node];
+            double dx = entry.x - center.x;
+            double dy = entry.y - center.y;
+            double dz = entry.z - center.z;
+            double distance2 = dx * dx + dy * dy + dz * dz;
+            if(best.size() < count) {
+                best.push(std::make_pair(distance2, node));
+            } else if(distance2 < best.top().first) {
+                best.pop();
+                best.push(std::make_pair(distance2, node));
+            }
+        }
+        visited += list.size();
+    };
+
+    result.clear();
+    count = std::min(count, m_nodes.size());
+    if(count == 0) {
+        return;
+    }
+
+    for(int64_t radius = 0; ; radius++) {
+        double side = 2.0 * radius + 1.0;
+        if(side * side * side > (double)m_cells.size()) {
+            /* The cube covers more cells than the index holds: scan every node once. */
+            best = std::priority_queue<std::pair<double, std::size_t>>();
+            forEachCell(ci, cj, ck, radius, false, visit);
+            break;
+        }
+        forEachCell(ci, cj, ck, radius, true, visit);
+
+        /* Nodes outside the visited cube are at least radius cells away. */
+        double bound = radius * m_cell_size;
+        if((best.size() == count && best.top().first <= bound * bound)
+            || visited == m_nodes.size()) {
+            break;
+        }
+    }
+
+    result.resize(best.size());
+    for(std::size_t i = best.size(); i > 0; i--) {
+        result[i - 1] = best.top().second;
+        best.pop();
+    }
+}
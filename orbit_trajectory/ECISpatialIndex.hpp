@@ -0,0 +1,162 @@
+/***********************************************************************************************//**
+ *  Class that indexes ECI positions in a uniform grid for range and neighbour queries
+ *  @class      ECISpatialIndex
+ *  @author     DSS-SIM development team, i2CAT
+ *  @date       2026-oct-16
+ *  @copyright  This code has been developed by Fundació Privada Internet i Innovació Digital a
+ *              Catalunya (i2CAT). i2CAT is a non-profit research and innovation centre that
+ *              promotes mission-driven knowledge to solve business challenges, co-create solutions
+ *              with a transformative impact, empower citizens through open and participative
+ *              digital social innovation with territorial capillarity, and promote pioneering and
+ *              strategic initiatives. i2CAT *aims to transfer* research project results to private
+ *              companies in order to create social and economic impact via the out-licensing of
+ *              intellectual property and the creation of spin-offs.
+ *              Find more information of i2CAT projects and IP rights at:
+ *              https://i2cat.net/tech-transfer/
+ **************************************************************************************************/
+
+#ifndef __ECI_SPATIAL_INDEX_HPP__
+#define __ECI_SPATIAL_INDEX_HPP__
+
+/* Global libraries */
+#include "dss.hpp"
+
+/* External Libraries */
+#include <unordered_map>
+#include <vector>
+
+/* Internal Libraries */
+#include "ECICoordinates.hpp"
+#include "SGP4BatchPropagator.hpp"
+
+#define SPATIAL_INDEX_CELL_SIZE 1000.0  /**< Default edge of the grid cells (km) */
+
+/***********************************************************************************************//**
+ * Spatial index of node positions in the ECI frame. Space is split in cubic cells of equal size
+ * and only the non-empty cells are stored, in a hash table. When the positions of a new time step
+ * are loaded, only the nodes that have crossed to another cell are moved, so the cost of an update
+ * is proportional to the number of nodes plus the number of cell changes.
+ *
+ * Range queries visit the cells that overlap the query sphere, and k-nearest queries visit shells
+ * of cells of growing radius until no closer node can exist. With a cell size close to the typical
+ * query radius, both only look at the nodes around the query point instead of at every node.
+ *
+ * @see     SGP4BatchPropagator
+ **************************************************************************************************/
+class ECISpatialIndex
+{
+public:
+    /*******************************************************************************************//**
+     * Constructs an empty index.
+     *
+     * @param  cell_size    Edge of the grid cells (km)
+     **********************************************************************************************/
+    ECISpatialIndex(double cell_size = SPATIAL_INDEX_CELL_SIZE);
+
+    /*******************************************************************************************//**
+     * Auto-generated destructor.
+     **********************************************************************************************/
+    ~ECISpatialIndex(void) = default;
+
+    /*******************************************************************************************//**
+     * Retrieves the number of indexed nodes.
+     **********************************************************************************************/
+    std::size_t size(void) const { return m_nodes.size(); }
+
+    /*******************************************************************************************//**
+     * Retrieves the number of cell changes since construction.
+     **********************************************************************************************/
+    uint64_t getMoves(void) const { return m_moves; }
+
+    /*******************************************************************************************//**
+     * Loads the positions of a time step. The i-th satellite of the states is the node i. Nodes
+     * are added if the states hold more satellites than the index.
+     *
+     * @param  states   Propagated states of the constellation
+     **********************************************************************************************/
+    void update(const BatchStates& states);
+
+    /*******************************************************************************************//**
+     * Sets the position of one node, adding it (and any node before it) if needed.
+     *
+     * @param  node         Index of the node
+     * @param  position     ECI position (km)
+     **********************************************************************************************/
+    void update(std::size_t node, const ECICoordinates& position);
+
+    /*******************************************************************************************//**
+     * Retrieves the position of a node.
+     **********************************************************************************************/
+    ECICoordinates getPosition(std::size_t node) const;
+
+    /*******************************************************************************************//**
+     * Finds the nodes inside a sphere.
+     *
+     * @param  center   ECI position of the centre of the sphere (km)
+     * @param  radius   Radius of the sphere (km)
+     * @param  result   Output nodes, in no particular order (the vector is cleared first)
+     **********************************************************************************************/
+    void queryRange(const ECICoordinates& center, double radius,
+        std::vector<std::size_t>& result) const;
+
+    /*******************************************************************************************//**
+     * Finds the nearest nodes to a point.
+     *
+     * @param  center   ECI position of the point (km)
+     * @param  count    Number of nodes to find
+     * @param  result   Output nodes, sorted by increasing distance (the vector is cleared first)
+     **********************************************************************************************/
+    void queryNearest(const ECICoordinates& center, std::size_t count,
+        std::vector<std::size_t>& result) const;
+
+private:
+    /*******************************************************************************************//**
+     * Indexed node.
+     **********************************************************************************************/
+    struct Node
+    {
+        double x, y, z;     /**< ECI position (km) */
+        uint64_t cell;      /**< Key of the cell that holds the node */
+        std::size_t slot;   /**< Position of the node in the list of its cell */
+    };
+
+    double m_cell_size;                                             /**< Edge of the cells (km) */
+    std::vector<Node> m_nodes;                                      /**< Indexed nodes */
+    std::unordered_map<uint64_t, std::vector<std::size_t>> m_cells; /**< Nodes of each cell */
+    uint64_t m_moves;                                               /**< Cell changes */
+
+    /*******************************************************************************************//**
+     * Computes the integer coordinate of the cell that holds a coordinate.
+     **********************************************************************************************/
+    int64_t toCell(double coordinate) const;
+
+    /*******************************************************************************************//**
+     * Packs three cell coordinates in a hash key.
+     **********************************************************************************************/
+    static uint64_t toKey(int64_t i, int64_t j, int64_t k);
+
+    /*******************************************************************************************//**
+     * Removes a node from the list of its cell.
+     **********************************************************************************************/
+    void unlink(std::size_t node);
+
+    /*******************************************************************************************//**
+     * Appends a node to the list of a cell.
+     **********************************************************************************************/
+    void link(std::size_t node, uint64_t cell);
+
+    /*******************************************************************************************//**
+     * Calls a function for every non-empty cell in a cube of cells, or for every non-empty cell
+     * of the index if the cube has more cells than the index.
+     *
+     * @param  ci, cj, ck   Cell coordinates of the centre of the cube
+     * @param  radius       Half edge of the cube (in cells)
+     * @param  shell        Visit only the surface of the cube
+     * @param  visit        Function called with the nodes of each cell
+     **********************************************************************************************/
+    template<typename F>
+    void forEachCell(int64_t ci, int64_t cj, int64_t ck, int64_t radius, bool shell,
+        F visit) const;
+};
+
+#endif /* __ECI_SPATIAL_INDEX_HPP__ */
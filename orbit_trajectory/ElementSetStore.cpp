@@ -0,0 +1,90 @@
+/***********************************************************************************************//**
+ *  Time-indexed store of the successive element sets of a satellite
+ *  @class      ElementSetStore
+ *  @author     DSS-SIM development team, i2CAT
+ *  @date       2026-oct-16
+ *  @copyright  This code has been developed by Fundació Privada Internet i Innovació Digital a
+ *              Catalunya (i2CAT). i2CAT is a non-profit research and innovation centre that
+ *              promotes mission-driven knowledge to solve business challenges, co-create solutions
+ *              with a transformative impact, empower citizens through open and participative
+ *              digital social innovation with territorial capillarity, and promote pioneering and
+ *              strategic initiatives. i2CAT *aims to transfer* research project results to private
+ *              companies in order to create social and economic impact via the out-licensing of
+ *              intellectual property and the creation of spin-offs.
+ *              Find more information of i2CAT projects and IP rights at:
+ *              https://i2cat.net/tech-transfer/
+ **************************************************************************************************/
+
+#include "ElementSetStore.hpp"
+#include "SGP4OrbitTrajectory.hpp"
+
+#include <algorithm>
+#include <sstream>
+
+LOG_COMPONENT_DEFINE("ElementSetStore");
+
+/* Epochs closer than this (in propagation time units) are considered the same. */
+#define ELEMENT_SET_SAME_EPOCH  1.0e-6
+
+ElementSetStore::ElementSetStore(double jd_start, gravconsttype constType, char opsMode)
+    : m_jd_start(jd_start)
+    , m_const_type(constType)
+    , m_ops_mode(opsMode)
+    , m_revision(0)
+{ }
+
+bool ElementSetStore::addTLE(const TLE& tle)
+{
+    elsetrec satrec;
+
+    if(!SGP4OrbitTrajectory::initSatrec(tle, m_const_type, m_ops_mode, satrec)) {
+        std::stringstream message;
+        message << "TLE " << tle.tle_number << " of satellite " << tle.sat_number
+            << " could not be initialised; it is not stored.";
+        LOG_WARN(message.str());
+        return false;
+    }
+    return addSatrec(satrec);
+}
+
+bool ElementSetStore::addSatrec(const elsetrec& satrec)
+{
+    if(satrec.error != 0) {
+        LOG_WARN("Element set with an SGP4 error; it is not stored.");
+        return false;
+    }
+
+    /* The Julian date is split in two parts by SGP4; they are subtracted separately from the
+     * reference to keep the precision. */
+    double epoch = ((satrec.jdsatepoch - m_jd_start) + satrec.jdsatepochF)
+        / ELEMENT_SET_TIME_UNIT_DAYS;
+    std::vector<double>::iterator it = std::lower_bound(m_epochs.begin(), m_epochs.end(),
+        epoch - ELEMENT_SET_SAME_EPOCH);
+    std::size_t index = it - m_epochs.begin();
+
+    if(it != m_epochs.end() && *it <= epoch + ELEMENT_SET_SAME_EPOCH) {
+        m_satrecs[index] = satrec;
+    } else {
+        m_epochs.insert(it, epoch);
+        m_satrecs.insert(m_satrecs.begin() + index, satrec);
+    }
+    m_revision++;
+    return true;
+}
+
+std::size_t ElementSetStore::select(double time) const
+{
+    if(m_epochs.empty()) {
+        return 0;
+    }
+
+    /* First epoch after the time, compared with the previous one. */
+    std::size_t next = std::upper_bound(m_epochs.begin(), m_epochs.end(), time) - m_epochs.begin();
+    if(next == 0) {
+        return 0;
+    }
+    if(next == m_epochs.size()) {
+        return next - 1;
+    }
+    return (m_epochs[next] - time <= time - m_epochs[next - 1]) ? next : next - 1;
+}
@@ -0,0 +1,132 @@
+/***********************************************************************************************//**
+ *  Time-indexed store of the successive element sets of a satellite
+ *  @class      ElementSetStore
+ *  @author     DSS-SIM development team, i2CAT
+ *  @date       2026-oct-16
+ *  @copyright  This code has been developed by Fundació Privada Internet i Innovació Digital a
+ *              Catalunya (i2CAT). i2CAT is a non-profit research and innovation centre that
+ *              promotes mission-driven knowledge to solve business challenges, co-create solutions
+ *              with a transformative impact, empower citizens through open and participative
+ *              digital social innovation with territorial capillarity, and promote pioneering and
+ *              strategic initiatives. i2CAT *aims to transfer* research project results to private
+ *              companies in order to create social and economic impact via the out-licensing of
+ *              intellectual property and the creation of spin-offs.
+ *              Find more information of i2CAT projects and IP rights at:
+ *              https://i2cat.net/tech-transfer/
+ **************************************************************************************************/
+
+#ifndef __ELEMENT_SET_STORE_HPP__
+#define __ELEMENT_SET_STORE_HPP__
+
+/* Global libraries */
+#include "dss.hpp"
+
+/* External Libraries */
+#include <vector>
+#include "SGP4.h"
+
+/* Internal Libraries */
+
+#define ELEMENT_SET_TIME_UNIT_DAYS  (1.0 / 1440.0)  /**< Days per unit of propagation time (SGP4
+                                                         uses minutes) */
+
+/***********************************************************************************************//**
+ * Store of the successive TLEs of one satellite, ordered by epoch. Every TLE is initialised with
+ * SGP4 when it is ingested, and select finds the element set whose epoch is the nearest to a
+ * propagation time with a binary search, so SGP4OrbitTrajectory can swap its element set in place
+ * while a long simulation goes through the epochs.
+ *
+ * Propagation times are measured from a reference Julian date common to all the element sets
+ * (instead of from the epoch of a single TLE), in the same units as sgp4Propagate.
+ *
+ * The store is not synchronised: TLEs shall not be ingested while a trajectory that uses it is
+ * being propagated from another thread.
+ *
+ * @see     SGP4OrbitTrajectory
+ **************************************************************************************************/
+class ElementSetStore
+{
+public:
+    /*******************************************************************************************//**
+     * Constructs an empty store.
+     *
+     * @param  jd_start     Julian date at propagation time 0
+     * @param  constType    Sgp4 gravitational constants set type
+     * @param  opsMode      Mode of operation afspc or improved ('a' or 'i')
+     **********************************************************************************************/
+    ElementSetStore(double jd_start, gravconsttype constType = wgs84, char opsMode = 'a');
+
+    /*******************************************************************************************//**
+     * Auto-generated destructor.
+     **********************************************************************************************/
+    ~ElementSetStore(void) = default;
+
+    /*******************************************************************************************//**
+     * Ingests a TLE. A TLE with the same epoch as a stored one replaces it.
+     *
+     * @param  tle  TLE of the satellite
+     * @return      True if SGP4 has been initialised without errors and the TLE has been stored
+     **********************************************************************************************/
+    bool addTLE(const TLE& tle);
+
+    /*******************************************************************************************//**
+     * Ingests an element set already initialised with sgp4init (for instance, by
+     * TLECatalogLoader). An element set with the same epoch as a stored one replaces it.
+     *
+     * @param  satrec   Initialised element set
+     * @return          True if the element set has been stored
+     **********************************************************************************************/
+    bool addSatrec(const elsetrec& satrec);
+
+    /*******************************************************************************************//**
+     * Retrieves the number of stored element sets.
+     **********************************************************************************************/
+    std::size_t size(void) const { return m_satrecs.size(); }
+
+    /*******************************************************************************************//**
+     * Retrieves the revision of the store, which changes every time an element set is ingested.
+     **********************************************************************************************/
+    uint64_t getRevision(void) const { return m_revision; }
+
+    /*******************************************************************************************//**
+     * Retrieves the gravitational constants set type of the store.
+     **********************************************************************************************/
+    gravconsttype getConstType(void) const { return m_const_type; }
+
+    /*******************************************************************************************//**
+     * Retrieves the Julian date at propagation time 0.
+     **********************************************************************************************/
+    double getStartDate(void) const { return m_jd_start; }
+
+    /*******************************************************************************************//**
+     * Selects the element set whose epoch is the nearest to a time. Ties go to the newest one.
+     *
+     * @param  time     Propagation time, measured from the reference Julian date
+     * @return          Index of the element set (size() if the store is empty)
+     **********************************************************************************************/
+    std::size_t select(double time) const;
+
+    /*******************************************************************************************//**
+     * Retrieves an element set, in epoch order.
+     *
+     * @param  index    Index of the element set
+     **********************************************************************************************/
+    const elsetrec& getSatrec(std::size_t index) const { return m_satrecs[index]; }
+
+    /*******************************************************************************************//**
+     * Retrieves the propagation time of the epoch of an element set.
+     *
+     * @param  index    Index of the element set
+     **********************************************************************************************/
+    double getEpochTime(std::size_t index) const { return m_epochs[index]; }
+
+private:
+    double m_jd_start;                  /**< Julian date at propagation time 0 */
+    gravconsttype m_const_type;         /**< Gravity model of the element sets */
+    char m_ops_mode;                    /**< SGP4 mode of operation */
+    std::vector<double> m_epochs;       /**< Propagation time of each epoch (ascending) */
+    std::vector<elsetrec> m_satrecs;    /**< Element sets, in the order of m_epochs */
+    uint64_t m_revision;                /**< Number of ingested element sets */
+};
+
+#endif /* __ELEMENT_SET_STORE_HPP__ */
@@ -0,0 +1,304 @@
+/***********************************************************************************************//**
+ *  Classes that record and replay constellation ephemerides through memory-mapped files
+ *  @class      EphemerisFile
+ *  @author     DSS-SIM development team, i2CAT
+ *  @date       2026-oct-16
+ *  @copyright  This code has been developed by Fundació Privada Internet i Innovació Digital a
+ *              Catalunya (i2CAT). i2CAT is a non-profit research and innovation centre that
+ *              promotes mission-driven knowledge to solve business challenges, co-create solutions
+ *              with a transformative impact, empower citizens through open and participative
+ *              digital social innovation with territorial capillarity, and promote pioneering and
+ *              strategic initiatives. i2CAT *aims to transfer* research project results to private
+ *              companies in order to create social and economic impact via the out-licensing of
+ *              intellectual property and the creation of spin-offs.
+ *              Find more information of i2CAT projects and IP rights at:
+ *              https://i2cat.net/tech-transfer/
+ **************************************************************************************************/
+
+#include "EphemerisFile.hpp"
+#include "ConstellationPropagationService.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+LOG_COMPONENT_DEFINE("EphemerisFile");
+
+#define EPHEMERIS_FILE_WRITE_BLOCK  64      /**< Time steps propagated per write block */
+
+static_assert(sizeof(EphemerisFileHeader) == 128, "Unexpected ephemeris file header size");
+
+/* Rounds a size up to a multiple of an alignment. */
+static uint64_t alignUp(uint64_t size, uint64_t alignment)
+{
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+/* Copies the state of a satellite into a sample of the file. */
+template<typename Real>
+static void storeSample(Real* sample, const BatchStates& states, std::size_t sat)
+{
+    sample[0] = states.x[sat];
+    sample[1] = states.y[sat];
+    sample[2] = states.z[sat];
+    sample[3] = states.vx[sat];
+    sample[4] = states.vy[sat];
+    sample[5] = states.vz[sat];
+}
+
+bool EphemerisFileWriter::write(
+    const std::string& path,
+    std::shared_ptr<const SGP4BatchPropagator> propagator,
+    const std::vector<std::string>& ids,
+    double start,
+    double step,
+    std::size_t steps,
+    unsigned int threads,
+    bool single_precision
+)
+{
+    std::size_t satellites = propagator->size();
+    std::string tmp_path = path + ".tmp";
+    EphemerisFileHeader header;
+
+    if(ids.size() != satellites || steps == 0) {
+        LOG_WARN("Ephemeris file needs one identifier per satellite and at least one step.");
+        return false;
+    }
+    if(!std::isfinite(step) || step <= 0) {
+        LOG_WARN("Ephemeris file needs a positive and finite time step.");
+        return false;
+    }
+
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, EPHEMERIS_FILE_MAGIC, sizeof(header.magic));
+    header.version = EPHEMERIS_FILE_VERSION;
+    header.endian_tag = EPHEMERIS_FILE_ENDIAN_TAG;
+    header.satellites = satellites;
+    header.steps = steps;
+    header.start = start;
+    header.step = step;
+    header.jd_reference = propagator->getReferenceEpoch();
+    header.ids_offset = sizeof(EphemerisFileHeader);
+    header.data_offset = alignUp(header.ids_offset + satellites * EPHEMERIS_FILE_ID_LENGTH,
+        EPHEMERIS_FILE_PAGE);
+    header.component_size = single_precision ? sizeof(float) : sizeof(double);
+    header.record_stride = alignUp(steps * 6 * header.component_size, EPHEMERIS_FILE_ALIGNMENT);
+
+    uint64_t size = header.data_offset + satellites * header.record_stride;
+    int fd = ::open(tmp_path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if(fd < 0 || ::ftruncate(fd, size) != 0) {
+        std::stringstream ss;
+        ss << "Cannot create ephemeris file " << tmp_path;
+        LOG_WARN(ss.str());
+        if(fd >= 0) {
+            ::close(fd);
+        }
+        return false;
+    }
+    void* map = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if(map == MAP_FAILED) {
+        LOG_WARN("Cannot map the ephemeris file for writing.");
+        ::unlink(tmp_path.c_str());
+        return false;
+    }
+
+    char* base = static_cast<char*>(map);
+    std::memcpy(base, &header, sizeof(header));
+    for(std::size_t i = 0; i < satellites; i++) {
+        std::strncpy(base + header.ids_offset + i * EPHEMERIS_FILE_ID_LENGTH, ids[i].c_str(),
+            EPHEMERIS_FILE_ID_LENGTH - 1);
+    }
+
+    /* Propagate blocks of steps and scatter them into the satellite records. */
+    ConstellationPropagationService service(propagator, threads);
+    for(std::size_t first = 0; first < steps; first += EPHEMERIS_FILE_WRITE_BLOCK) {
+        std::size_t count = std::min<std::size_t>(EPHEMERIS_FILE_WRITE_BLOCK, steps - first);
+        service.propagate(start + first * step, step, count);
+
+        service.getPool().parallelFor(satellites, [&](std::size_t sat) {
+            char* record = base + header.data_offset + sat * header.record_stride;
+            for(std::size_t k = 0; k < count; k++) {
+                const BatchStates& states = service.getStates(k);
+                if(single_precision) {
+                    storeSample(reinterpret_cast<float*>(record) + (first + k) * 6, states, sat);
+                } else {
+                    storeSample(reinterpret_cast<double*>(record) + (first + k) * 6, states, sat);
+                }
+            }
+        });
+    }
+
+    bool success = ::msync(map, size, MS_SYNC) == 0;
+    ::munmap(map, size);
+    success = success && std::rename(tmp_path.c_str(), path.c_str()) == 0;
+    if(!success) {
+        std::stringstream ss;
+        ss << "Cannot write ephemeris file " << path;
+        LOG_WARN(ss.str());
+        ::unlink(tmp_path.c_str());
+    }
+    return success;
+}
+
+EphemerisFileReader::EphemerisFileReader(void)
+    : m_header(nullptr)
+    , m_size(0)
+    , m_component_size(sizeof(double))
+{ }
+
+EphemerisFileReader::~EphemerisFileReader(void)
+{
+    close();
+}
+
+void EphemerisFileReader::close(void)
+{
+    if(m_header != nullptr) {
+        ::munmap(const_cast<EphemerisFileHeader*>(m_header), m_size);
+        m_header = nullptr;
+        m_size = 0;
+    }
+}
+
+bool EphemerisFileReader::open(const std::string& path)
+{
+    struct stat info;
+    int fd = ::open(path.c_str(), O_RDONLY);
+
+    close();
+    if(fd < 0 || ::fstat(fd, &info) != 0 || (std::size_t)info.st_size < sizeof(EphemerisFileHeader)) {
+        std::stringstream ss;
+        ss << "Cannot open ephemeris file " << path;
+        LOG_WARN(ss.str());
+        if(fd >= 0) {
+            ::close(fd);
+        }
+        return false;
+    }
+
+    void* map = ::mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if(map == MAP_FAILED) {
+        LOG_WARN("Cannot map the ephemeris file.");
+        return false;
+    }
+
+    /* The identifier table and the records shall lie inside the file. Sizes are compared by
+     * division, so that no product of header fields can overflow. */
+    const EphemerisFileHeader* header = static_cast<const EphemerisFileHeader*>(map);
+    uint64_t size = info.st_size;
+    bool valid = std::memcmp(header->magic, EPHEMERIS_FILE_MAGIC, sizeof(header->magic)) == 0
+        && header->version == EPHEMERIS_FILE_VERSION
+        && header->endian_tag == EPHEMERIS_FILE_ENDIAN_TAG
+        && (header->component_size == sizeof(double) || header->component_size == sizeof(float))
+        && header->steps > 0
+        && std::isfinite(header->start) && std::isfinite(header->step) && header->step > 0
+        && header->record_stride / 6 / header->component_size >= header->steps
+        && header->record_stride % header->component_size == 0
+        && header->data_offset % header->component_size == 0
+        && header->ids_offset >= sizeof(EphemerisFileHeader) && header->ids_offset <= size
+        && header->satellites <= (size - header->ids_offset) / EPHEMERIS_FILE_ID_LENGTH
+        && header->data_offset <= size
+        && (header->satellites == 0
+            || header->record_stride <= (size - header->data_offset) / header->satellites);
+    if(!valid) {
+        std::stringstream ss;
+        ss << "Invalid or incompatible ephemeris file " << path;
+        LOG_WARN(ss.str());
+        ::munmap(map, info.st_size);
+        return false;
+    }
+
+    m_header = header;
+    m_size = info.st_size;
+    m_component_size = header->component_size;
+    return true;
+}
+
+bool EphemerisFileReader::findSatellite(const std::string& id, std::size_t& index) const
+{
+    const char* ids = reinterpret_cast<const char*>(m_header) + m_header->ids_offset;
+
+    for(std::size_t i = 0; i < m_header->satellites; i++) {
+        if(std::strncmp(ids + i * EPHEMERIS_FILE_ID_LENGTH, id.c_str(),
+            EPHEMERIS_FILE_ID_LENGTH) == 0) {
+            index = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool EphemerisFileReader::covers(double time) const
+{
+    return m_header != nullptr && time >= m_header->start
+        && time <= m_header->start + m_header->step * (m_header->steps - 1);
+}
+
+void EphemerisFileReader::getSample(std::size_t satellite, std::size_t step, double sample[6]) const
+{
+    const char* record = reinterpret_cast<const char*>(m_header) + m_header->data_offset
+        + satellite * m_header->record_stride;
+
+    if(m_component_size == sizeof(float)) {
+        const float* values = reinterpret_cast<const float*>(record) + step * 6;
+        std::copy(values, values + 6, sample);
+    } else {
+        const double* values = reinterpret_cast<const double*>(record) + step * 6;
+        std::copy(values, values + 6, sample);
+    }
+}
+
+std::tuple<ECICoordinates, ECICoordinates> EphemerisFileReader::getState(
+    std::size_t satellite,
+    double time
+) const
+{
+    double state[6];
+    int64_t steps = m_header->steps;
+    double u = (time - m_header->start) / m_header->step;
+    int64_t k = (int64_t)std::floor(u);
+
+    if(steps < 4) {
+        /* Too few samples for a cubic: interpolate linearly. */
+        int64_t k0 = std::min<int64_t>(std::max<int64_t>(k, 0), std::max<int64_t>(steps - 2, 0));
+        int64_t k1 = std::min<int64_t>(k0 + 1, steps - 1);
+        double s = u - k0;
+        double a[6];
+        double b[6];
+        getSample(satellite, k0, a);
+        getSample(satellite, k1, b);
+        for(int c = 0; c < 6; c++) {
+            state[c] = a[c] + (b[c] - a[c]) * s;
+        }
+    } else {
+        /* Four-point Lagrange interpolation on samples k-1 .. k+2, shifted at the edges. */
+        int64_t first = std::min<int64_t>(std::max<int64_t>(k - 1, 0), steps - 4);
+        double s = u - first;
+        double w0 = -(s - 1) * (s - 2) * (s - 3) / 6.0;
+        double w1 = s * (s - 2) * (s - 3) / 2.0;
+        double w2 = -s * (s - 1) * (s - 3) / 2.0;
+        double w3 = s * (s - 1) * (s - 2) / 6.0;
+        double p0[6];
+        double p1[6];
+        double p2[6];
+        double p3[6];
+        getSample(satellite, first, p0);
+        getSample(satellite, first + 1, p1);
+        getSample(satellite, first + 2, p2);
+        getSample(satellite, first + 3, p3);
+        for(int c = 0; c < 6; c++) {
+            state[c] = w0 * p0[c] + w1 * p1[c] + w2 * p2[c] + w3 * p3[c];
+        }
+    }
+
+    return std::make_tuple(ECICoordinates(state[0], state[1], state[2]),
+        ECICoordinates(state[3], state[4], state[5]));
+}
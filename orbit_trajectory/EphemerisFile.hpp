@@ -0,0 +1,183 @@
+/***********************************************************************************************//**
+ *  Classes that record and replay constellation ephemerides through memory-mapped files
+ *  @class      EphemerisFile
+ *  @author     DSS-SIM development team, i2CAT
+ *  @date       2026-oct-16
+ *  @copyright  This code has been developed by Fundació Privada Internet i Innovació Digital a
+ *              Catalunya (i2CAT). i2CAT is a non-profit research and innovation centre that
+ *              promotes mission-driven knowledge to solve business challenges, co-create solutions
+ *              with a transformative impact, empower citizens through open and participative
+ *              digital social innovation with territorial capillarity, and promote pioneering and
+ *              strategic initiatives. i2CAT *aims to transfer* research project results to private
+ *              companies in order to create social and economic impact via the out-licensing of
+ *              intellectual property and the creation of spin-offs.
+ *              Find more information of i2CAT projects and IP rights at:
+ *              https://i2cat.net/tech-transfer/
+ **************************************************************************************************/
+
+#ifndef __EPHEMERIS_FILE_HPP__
+#define __EPHEMERIS_FILE_HPP__
+
+/* Global libraries */
+#include "dss.hpp"
+
+/* External Libraries */
+#include <memory>
+#include <string>
+#include <vector>
+
+/* Internal Libraries */
+#include "ECICoordinates.hpp"
+#include "SGP4BatchPropagator.hpp"
+
+#define EPHEMERIS_FILE_MAGIC        "DSSEPHEM"  /**< Identifier at the start of the file */
+#define EPHEMERIS_FILE_VERSION      1           /**< Version of the file layout */
+#define EPHEMERIS_FILE_ENDIAN_TAG   0x01020304  /**< Detects files written with other endianness */
+#define EPHEMERIS_FILE_ID_LENGTH    32          /**< Bytes of each satellite identifier */
+#define EPHEMERIS_FILE_ALIGNMENT    64          /**< Alignment of each satellite record (bytes) */
+#define EPHEMERIS_FILE_PAGE         4096        /**< Alignment of the data section (bytes) */
+
+/***********************************************************************************************//**
+ * Header at the beginning of an ephemeris file. The file continues with a table of satellite
+ * identifiers (EPHEMERIS_FILE_ID_LENGTH bytes each, null padded) and, at data_offset, one record
+ * per satellite. Each record holds, for every time step, the position (km) and the velocity (km/s)
+ * as six consecutive components of component_size bytes (doubles, or floats in single-precision
+ * files), and it is padded to record_stride bytes. Times are measured from the reference epoch of
+ * the propagator that wrote the file.
+ **************************************************************************************************/
+struct EphemerisFileHeader
+{
+    char magic[8];              /**< EPHEMERIS_FILE_MAGIC, without null terminator */
+    uint32_t version;           /**< EPHEMERIS_FILE_VERSION */
+    uint32_t endian_tag;        /**< EPHEMERIS_FILE_ENDIAN_TAG */
+    uint64_t satellites;        /**< Number of satellites */
+    uint64_t steps;             /**< Number of time steps per satellite */
+    double start;               /**< Time of the first step */
+    double step;                /**< Time between consecutive steps */
+    uint64_t ids_offset;        /**< Offset of the identifier table (bytes) */
+    uint64_t data_offset;       /**< Offset of the first satellite record (bytes) */
+    uint64_t record_stride;     /**< Bytes between consecutive satellite records */
+    double jd_reference;        /**< Julian date of time 0 */
+    uint32_t component_size;    /**< Bytes of each state component (8 or 4) */
+    uint8_t reserved[44];       /**< Reserved for future versions (zero) */
+};
+
+/***********************************************************************************************//**
+ * Writer of ephemeris files. The constellation is propagated in blocks of time steps on a thread
+ * pool and scattered into the memory-mapped output file, so the memory used does not grow with
+ * the length of the series. The file is written under a temporary name and renamed at the end, so
+ * concurrent readers never map a partially written file.
+ *
+ * @see     EphemerisFileReader
+ **************************************************************************************************/
+class EphemerisFileWriter
+{
+public:
+    /*******************************************************************************************//**
+     * Propagates a constellation and writes its ephemeris file.
+     *
+     * @param  path         Path of the output file
+     * @param  propagator   Batch propagator of the constellation
+     * @param  ids          Identifier of each satellite, in the order of the propagator
+     * @param  start        Time of the first step, from the reference epoch of the propagator
+     * @param  step         Time between consecutive steps (positive and finite)
+     * @param  steps        Number of time steps
+     * @param  threads      Number of worker threads (0 to use all the hardware threads)
+     * @param  single_precision Store the states as floats, which halves the size of the file
+     * @return              True if the file has been written
+     **********************************************************************************************/
+    static bool write(
+        const std::string& path,
+        std::shared_ptr<const SGP4BatchPropagator> propagator,
+        const std::vector<std::string>& ids,
+        double start,
+        double step,
+        std::size_t steps,
+        unsigned int threads = 0,
+        bool single_precision = false
+    );
+};
+
+/***********************************************************************************************//**
+ * Read-only view of an ephemeris file. The file is mapped as shared and read-only, so many
+ * simulation processes can replay the same file while the operating system keeps a single copy
+ * of it in memory. States between steps are interpolated with four-point Lagrange polynomials.
+ *
+ * @see     EphemerisFileWriter
+ **************************************************************************************************/
+class EphemerisFileReader
+{
+public:
+    /*******************************************************************************************//**
+     * Constructs a reader without any file. Use open to map a file.
+     **********************************************************************************************/
+    EphemerisFileReader(void);
+
+    /*******************************************************************************************//**
+     * Destructor. It unmaps the file.
+     **********************************************************************************************/
+    ~EphemerisFileReader(void);
+
+    EphemerisFileReader(const EphemerisFileReader&) = delete;
+    EphemerisFileReader& operator=(const EphemerisFileReader&) = delete;
+
+    /*******************************************************************************************//**
+     * Maps an ephemeris file and validates its header.
+     *
+     * @param  path     Path of the ephemeris file
+     * @return          True if the file is valid and has been mapped
+     **********************************************************************************************/
+    bool open(const std::string& path);
+
+    /*******************************************************************************************//**
+     * Retrieves the number of satellites of the file.
+     **********************************************************************************************/
+    std::size_t getSatelliteCount(void) const { return m_header ? m_header->satellites : 0; }
+
+    /*******************************************************************************************//**
+     * Finds the index of a satellite given its identifier.
+     *
+     * @param  id       Satellite identifier
+     * @param  index    Output index of the satellite
+     * @return          True if the satellite is in the file
+     **********************************************************************************************/
+    bool findSatellite(const std::string& id, std::size_t& index) const;
+
+    /*******************************************************************************************//**
+     * Retrieves the Julian date of time 0 of the recorded series.
+     **********************************************************************************************/
+    double getReferenceEpoch(void) const { return m_header ? m_header->jd_reference : 0; }
+
+    /*******************************************************************************************//**
+     * Checks if a time is covered by the recorded series.
+     *
+     * @param  time     Propagation time from the reference epoch of the file
+     **********************************************************************************************/
+    bool covers(double time) const;
+
+    /*******************************************************************************************//**
+     * Retrieves the interpolated state of a satellite. The time shall be covered by the file.
+     *
+     * @param  satellite    Index of the satellite
+     * @param  time         Propagation time from the reference epoch of the file
+     * @return              Tuple with the ECI position and velocity
+     **********************************************************************************************/
+    std::tuple<ECICoordinates, ECICoordinates> getState(std::size_t satellite, double time) const;
+
+private:
+    const EphemerisFileHeader* m_header;    /**< Mapped header, or null if no file is open */
+    std::size_t m_size;                     /**< Size of the mapping (bytes) */
+    std::size_t m_component_size;           /**< Bytes of each state component (8 or 4) */
+
+    /*******************************************************************************************//**
+     * Unmaps the current file, if any.
+     **********************************************************************************************/
+    void close(void);
+
+    /*******************************************************************************************//**
+     * Retrieves the six state components of a satellite at a time step, as doubles.
+     **********************************************************************************************/
+    void getSample(std::size_t satellite, std::size_t step, double sample[6]) const;
+};
+
+#endif /* __EPHEMERIS_FILE_HPP__ */
@@ -0,0 +1,203 @@
+/***********************************************************************************************//**
+ *  Two-body propagator with a J2 correction, anchored to the states of an SGP4 trajectory
+ *  @class      KeplerianPropagator
+ *  @author     DSS-SIM development team, i2CAT
+ *  @date       2026-oct-16
+ *  @copyright  This code has been developed by Fundació Privada Internet i Innovació Digital a
+ *              Catalunya (i2CAT). i2CAT is a non-profit research and innovation centre that
+ *              promotes mission-driven knowledge to solve business challenges, co-create solutions
+ *              with a transformative impact, empower citizens through open and participative
+ *              digital social innovation with territorial capillarity, and promote pioneering and
+ *              strategic initiatives. i2CAT *aims to transfer* research project results to private
+ *              companies in order to create social and economic impact via the out-licensing of
+ *              intellectual property and the creation of spin-offs.
+ *              Find more information of i2CAT projects and IP rights at:
+ *              https://i2cat.net/tech-transfer/
+ **************************************************************************************************/
+
+#include "KeplerianPropagator.hpp"
+#include "SGP4OrbitTrajectory.hpp"
+
+#include <algorithm>
+
+LOG_COMPONENT_DEFINE("KeplerianPropagator");
+
+/* Iterations and tolerance of the universal-variable Kepler equation. */
+#define KEPLERIAN_MAX_ITERATIONS    50
+#define KEPLERIAN_TOLERANCE         1.0e-12
+
+/* Weight of a new measurement that lowers the calibration factor, and margin applied to the
+ * measured ratios, since the error rate changes along the orbit. */
+#define KEPLERIAN_CALIBRATION_GAIN      0.05
+#define KEPLERIAN_CALIBRATION_MARGIN    1.5
+
+KeplerianPropagator::KeplerianPropagator(SGP4OrbitTrajectory* trajectory, double max_error)
+    : m_trajectory(trajectory)
+    , m_max_error(max_error)
+    , m_anchored(false)
+    , m_anchor_time(0)
+    , m_error_rate(0)
+    , m_scale(1.0)
+    , m_queries(0)
+    , m_switches(0)
+    , m_max_estimate(0)
+    , m_max_measured(0)
+    , m_sum_squared(0)
+    , m_measurements(0)
+{ }
+
+void KeplerianPropagator::invalidate(void)
+{
+    m_anchored = false;
+    m_scale = 1.0;
+}
+
+double KeplerianPropagator::getHorizon(void) const
+{
+    if(!m_anchored || m_error_rate <= 0) {
+        return 0.0;
+    }
+    return std::cbrt(m_max_error / (m_scale * m_error_rate)) / KEPLERIAN_SECONDS_PER_UNIT;
+}
+
+std::tuple<ECICoordinates, ECICoordinates> KeplerianPropagator::getState(double time)
+{
+    m_queries++;
+    if(m_anchored && m_error_rate > 0) {
+        double dt = (time - m_anchor_time) * KEPLERIAN_SECONDS_PER_UNIT;
+        double estimate = m_scale * m_error_rate * std::fabs(dt * dt * dt);
+
+        if(estimate <= m_max_error) {
+            double r[3], v[3];
+            propagate(dt, r, v);
+            m_max_estimate = std::max(m_max_estimate, estimate);
+            return std::make_tuple(ECICoordinates(r[0], r[1], r[2]),
+                ECICoordinates(v[0], v[1], v[2]));
+        }
+    }
+
+    std::tuple<ECICoordinates, ECICoordinates> state = m_trajectory->sgp4Propagate(time);
+    anchor(time, std::get<0>(state), std::get<1>(state));
+    return state;
+}
+
+/* Stumpff functions c2 and c3 of the universal variable formulation. */
+static void stumpff(double psi, double& c2, double& c3)
+{
+    if(psi > 1.0e-6) {
+        double s = std::sqrt(psi);
+        c2 = (1.0 - std::cos(s)) / psi;
+        c3 = (s - std::sin(s)) / (s * psi);
+    } else if(psi < -1.0e-6) {
+        double s = std::sqrt(-psi);
+        c2 = (1.0 - std::cosh(s)) / psi;
+        c3 = (std::sinh(s) - s) / (s * -psi);
+    } else {
+        c2 = 0.5 - psi / 24.0;
+        c3 = 1.0 / 6.0 - psi / 120.0;
+    }
+}
+
+void KeplerianPropagator::propagate(double dt, double r[3], double v[3]) const
+{
+    const double mu = Globals::constants.earth_mu;
+    const double* r0 = m_position;
+    const double* v0 = m_velocity;
+    double r0_norm = std::sqrt(r0[0] * r0[0] + r0[1] * r0[1] + r0[2] * r0[2]);
+    double v0_squared = v0[0] * v0[0] + v0[1] * v0[1] + v0[2] * v0[2];
+    double sigma = (r0[0] * v0[0] + r0[1] * v0[1] + r0[2] * v0[2]) / std::sqrt(mu);
+    double alpha = 2.0 / r0_norm - v0_squared / mu;
+    double sqrt_mu_dt = std::sqrt(mu) * dt;
+
+    /* Newton iterations on the universal Kepler equation, from the elliptic first guess. */
+    double x = sqrt_mu_dt * alpha;
+    double psi = 0, c2 = 0.5, c3 = 1.0 / 6.0, r_norm = r0_norm;
+    for(int i = 0; i < KEPLERIAN_MAX_ITERATIONS; i++) {
+        psi = x * x * alpha;
+        stumpff(psi, c2, c3);
+        r_norm = x * x * c2 + sigma * x * (1.0 - psi * c3) + r0_norm * (1.0 - psi * c2);
+        double dx = (sqrt_mu_dt - x * x * x * c3 - sigma * x * x * c2
+            - r0_norm * x * (1.0 - psi * c3)) / r_norm;
+        x += dx;
+        if(std::fabs(dx) < KEPLERIAN_TOLERANCE) {
+            break;
+        }
+    }
+
+    double f = 1.0 - x * x / r0_norm * c2;
+    double g = dt - x * x * x / std::sqrt(mu) * c3;
+    double f_dot = std::sqrt(mu) / (r_norm * r0_norm) * x * (psi * c3 - 1.0);
+    double g_dot = 1.0 - x * x / r_norm * c2;
+
+    for(int c = 0; c < 3; c++) {
+        r[c] = f * r0[c] + g * v0[c] + 0.5 * m_acceleration[c] * dt * dt;
+        v[c] = f_dot * r0[c] + g_dot * v0[c] + m_acceleration[c] * dt;
+    }
+}
+
+void KeplerianPropagator::anchor(
+    double time,
+    const ECICoordinates& position,
+    const ECICoordinates& velocity
+)
+{
+    m_switches++;
+
+    /* Calibration with the prediction of the previous anchor, if it is close enough for the
+     * cubic growth to hold (up to twice the horizon). */
+    if(m_anchored) {
+        double dt = (time - m_anchor_time) * KEPLERIAN_SECONDS_PER_UNIT;
+        double bound = m_error_rate * std::fabs(dt * dt * dt);
+
+        if(bound > 0 && m_scale * bound <= 8.0 * m_max_error) {
+            double r[3], v[3];
+            propagate(dt, r, v);
+            double dx = r[0] - position.x;
+            double dy = r[1] - position.y;
+            double dz = r[2] - position.z;
+            double measured = std::sqrt(dx * dx + dy * dy + dz * dz);
+            double ratio = KEPLERIAN_CALIBRATION_MARGIN * measured / bound;
+
+            m_max_measured = std::max(m_max_measured, measured);
+            m_sum_squared += measured * measured;
+            m_measurements++;
+            if(ratio > m_scale) {
+                m_scale = ratio;
+            } else {
+                m_scale = std::max(1.0, m_scale + KEPLERIAN_CALIBRATION_GAIN * (ratio - m_scale));
+            }
+        }
+    }
+
+    m_anchored = true;
+    m_anchor_time = time;
+    m_position[0] = position.x;
+    m_position[1] = position.y;
+    m_position[2] = position.z;
+    m_velocity[0] = velocity.x;
+    m_velocity[1] = velocity.y;
+    m_velocity[2] = velocity.z;
+
+    /* J2 acceleration at the anchor, with the constants of the SGP4 gravity model. */
+    const elsetrec& satrec = m_trajectory->getSatrec();
+    const double mu = Globals::constants.earth_mu;
+    double r2 = position.x * position.x + position.y * position.y + position.z * position.z;
+    double r_norm = std::sqrt(r2);
+    double factor = -1.5 * satrec.j2 * mu * satrec.radiusearthkm * satrec.radiusearthkm
+        / (r2 * r2 * r_norm);
+    double z2 = 5.0 * position.z * position.z / r2;
+
+    m_acceleration[0] = factor * position.x * (1.0 - z2);
+    m_acceleration[1] = factor * position.y * (1.0 - z2);
+    m_acceleration[2] = factor * position.z * (3.0 - z2);
+
+    /* The neglected change of the J2 acceleration follows the orbit, at the mean motion, so the
+     * position error grows as |a_J2| n dt^3 / 3 at most. */
+    double v2 = velocity.x * velocity.x + velocity.y * velocity.y + velocity.z * velocity.z;
+    double alpha = std::max(2.0 / r_norm - v2 / mu, 1.0e-12);
+    double mean_motion = std::sqrt(mu * alpha * alpha * alpha);
+    double acceleration = std::sqrt(m_acceleration[0] * m_acceleration[0]
+        + m_acceleration[1] * m_acceleration[1] + m_acceleration[2] * m_acceleration[2]);
+
+    m_error_rate = acceleration * mean_motion / 3.0;
+}
@@ -0,0 +1,161 @@
+/***********************************************************************************************//**
+ *  Two-body propagator with a J2 correction, anchored to the states of an SGP4 trajectory
+ *  @class      KeplerianPropagator
+ *  @author     DSS-SIM development team, i2CAT
+ *  @date       2026-oct-16
+ *  @copyright  This code has been developed by Fundació Privada Internet i Innovació Digital a
+ *              Catalunya (i2CAT). i2CAT is a non-profit research and innovation centre that
+ *              promotes mission-driven knowledge to solve business challenges, co-create solutions
+ *              with a transformative impact, empower citizens through open and participative
+ *              digital social innovation with territorial capillarity, and promote pioneering and
+ *              strategic initiatives. i2CAT *aims to transfer* research project results to private
+ *              companies in order to create social and economic impact via the out-licensing of
+ *              intellectual property and the creation of spin-offs.
+ *              Find more information of i2CAT projects and IP rights at:
+ *              https://i2cat.net/tech-transfer/
+ **************************************************************************************************/
+
+#ifndef __KEPLERIAN_PROPAGATOR_HPP__
+#define __KEPLERIAN_PROPAGATOR_HPP__
+
+/* Global libraries */
+#include "dss.hpp"
+
+/* External Libraries */
+#include <cmath>
+#include <tuple>
+
+/* Internal Libraries */
+#include "ECICoordinates.hpp"
+
+#define KEPLERIAN_SECONDS_PER_UNIT  60.0    /**< Seconds per unit of propagation time (SGP4 uses
+                                                 minutes) */
+
+class SGP4OrbitTrajectory;      /* Needed to create a bidirectional relationship */
+
+/***********************************************************************************************//**
+ * Low-fidelity mode of an SGP4 trajectory for short-horizon queries. The SGP4 state at an anchor
+ * time is propagated with the two-body solution (universal-variable Kepler equation and Lagrange
+ * f and g coefficients) plus the J2 acceleration at the anchor, which costs a few iterations of
+ * a scalar equation instead of a full SGP4 evaluation.
+ *
+ * The position error of this model grows with the cube of the distance to the anchor, at a rate
+ * bounded by the J2 acceleration and the mean motion. The bound is scaled by a factor calibrated
+ * at every re-anchoring, where the prediction of the previous anchor is compared with SGP4. When
+ * the estimated error of a query crosses the budget, SGP4 is evaluated at the query time, which
+ * becomes the new anchor.
+ *
+ * Budgets below a metre are limited by the small mismatch between the SGP4 velocity and the rate
+ * of change of the SGP4 position, which the calibration only absorbs after the first anchors.
+ *
+ * @see     SGP4OrbitTrajectory
+ **************************************************************************************************/
+class KeplerianPropagator
+{
+public:
+    /*******************************************************************************************//**
+     * Constructs the propagator in front of an SGP4 trajectory. The first query anchors it.
+     *
+     * @param  trajectory   Trajectory whose sgp4Propagate provides the anchors
+     * @param  max_error    Error budget of the answered positions (in km)
+     **********************************************************************************************/
+    KeplerianPropagator(SGP4OrbitTrajectory* trajectory, double max_error = 1.0e-3);
+
+    /*******************************************************************************************//**
+     * Auto-generated destructor.
+     **********************************************************************************************/
+    ~KeplerianPropagator(void) = default;
+
+    /*******************************************************************************************//**
+     * Retrieves the position and the velocity of the satellite at a given time, from the analytic
+     * model if its estimated error is within the budget and from SGP4 otherwise.
+     *
+     * @param  time     Propagation time, with the same meaning as in sgp4Propagate
+     * @return          Tuple with the ECI position and velocity
+     **********************************************************************************************/
+    std::tuple<ECICoordinates, ECICoordinates> getState(double time);
+
+    /*******************************************************************************************//**
+     * Drops the anchor and the calibration. It shall be called when the element set of the
+     * trajectory changes.
+     **********************************************************************************************/
+    void invalidate(void);
+
+    /*******************************************************************************************//**
+     * Retrieves the distance to the anchor up to which the analytic model is used, according to
+     * the current error estimate.
+     **********************************************************************************************/
+    double getHorizon(void) const;
+
+    /*******************************************************************************************//**
+     * Retrieves the number of queries.
+     **********************************************************************************************/
+    uint64_t getQueries(void) const { return m_queries; }
+
+    /*******************************************************************************************//**
+     * Retrieves the number of switches to SGP4, that is, the number of anchors.
+     **********************************************************************************************/
+    uint64_t getSwitches(void) const { return m_switches; }
+
+    /*******************************************************************************************//**
+     * Retrieves the fraction of the queries that switched to SGP4.
+     **********************************************************************************************/
+    double getSwitchRate(void) const
+    {
+        return m_queries ? (double)m_switches / m_queries : 0.0;
+    }
+
+    /*******************************************************************************************//**
+     * Retrieves the largest estimated error of the positions answered by the analytic model, that
+     * is, the part of the error budget used in the run (in km).
+     **********************************************************************************************/
+    double getMaxEstimatedError(void) const { return m_max_estimate; }
+
+    /*******************************************************************************************//**
+     * Retrieves the largest error of the analytic model measured against SGP4 at the re-anchoring
+     * points (in km).
+     **********************************************************************************************/
+    double getMaxMeasuredError(void) const { return m_max_measured; }
+
+    /*******************************************************************************************//**
+     * Retrieves the root mean square of the errors measured at the re-anchoring points (in km).
+     **********************************************************************************************/
+    double getRMSMeasuredError(void) const
+    {
+        return m_measurements ? std::sqrt(m_sum_squared / m_measurements) : 0.0;
+    }
+
+private:
+    SGP4OrbitTrajectory* m_trajectory;  /**< Trajectory that provides the anchors */
+    double m_max_error;                 /**< Error budget (in km) */
+    bool m_anchored;                    /**< An anchor state is available */
+    double m_anchor_time;               /**< Time of the anchor */
+    double m_position[3];               /**< Position at the anchor (in km) */
+    double m_velocity[3];               /**< Velocity at the anchor (in km/s) */
+    double m_acceleration[3];           /**< J2 acceleration at the anchor (in km/s^2) */
+    double m_error_rate;                /**< Analytic bound of the error growth (in km/s^3) */
+    double m_scale;                     /**< Calibration factor of the bound */
+    uint64_t m_queries;                 /**< Queries */
+    uint64_t m_switches;                /**< Re-anchorings with SGP4 */
+    double m_max_estimate;              /**< Largest estimated error of an analytic answer */
+    double m_max_measured;              /**< Largest error measured at a re-anchoring */
+    double m_sum_squared;               /**< Sum of the squared measured errors */
+    uint64_t m_measurements;            /**< Measured errors */
+
+    /*******************************************************************************************//**
+     * Propagates the anchor state with the analytic model.
+     *
+     * @param  dt   Time from the anchor (in s)
+     * @param  r    Output position (in km)
+     * @param  v    Output velocity (in km/s)
+     **********************************************************************************************/
+    void propagate(double dt, double r[3], double v[3]) const;
+
+    /*******************************************************************************************//**
+     * Sets the SGP4 state at a time as the new anchor, calibrating the error bound with the
+     * prediction of the previous anchor.
+     **********************************************************************************************/
+    void anchor(double time, const ECICoordinates& position, const ECICoordinates& velocity);
+};
+
+#endif /* __KEPLERIAN_PROPAGATOR_HPP__ */
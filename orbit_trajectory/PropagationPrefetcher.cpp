@@ -0,0 +1,179 @@
+/***********************************************************************************************//**
+ *  Background thread that propagates a constellation ahead of the simulation time
+ *  @class      PropagationPrefetcher
+ *  @author     DSS-SIM development team, i2CAT
+ *  @date       2026-oct-16
+ *  @copyright  This code has been developed by Fundació Privada Internet i Innovació Digital a
+ *              Catalunya (i2CAT). i2CAT is a non-profit research and innovation centre that
+ *              promotes mission-driven knowledge to solve business challenges, co-create solutions
+ *              with a transformative impact, empower citizens through open and participative
+ *              digital social innovation with territorial capillarity, and promote pioneering and
+ *              strategic initiatives. i2CAT *aims to transfer* research project results to private
+ *              companies in order to create social and economic impact via the out-licensing of
+ *              intellectual property and the creation of spin-offs.
+ *              Find more information of i2CAT projects and IP rights at:
+ *              https://i2cat.net/tech-transfer/
+ **************************************************************************************************/
+
+#include "PropagationPrefetcher.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+LOG_COMPONENT_DEFINE("PropagationPrefetcher");
+
+PropagationPrefetcher::PropagationPrefetcher(
+    std::shared_ptr<const SGP4BatchPropagator> propagator,
+    double start,
+    double step,
+    std::size_t horizon
+)
+    : m_propagator(propagator)
+    , m_start(start)
+    , m_step(step)
+    , m_capacity(std::max<std::size_t>(horizon, 1) + 2)
+    , m_ring(m_capacity)
+    , m_produced(0)
+    , m_released(0)
+    , m_stop(false)
+    , m_producer_parked(false)
+    , m_consumer_parked(false)
+    , m_requests(0)
+    , m_waits(0)
+    , m_wait_time(0)
+    , m_fallbacks(0)
+{
+    m_producer = std::thread(&PropagationPrefetcher::produce, this);
+}
+
+PropagationPrefetcher::~PropagationPrefetcher(void)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wakeup.notify_all();
+    m_producer.join();
+}
+
+void PropagationPrefetcher::wakeUp(const std::atomic<bool>& parked)
+{
+    /* The parked side checks its condition under the mutex, so the notification is not lost. */
+    if(parked.load()) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_wakeup.notify_all();
+    }
+}
+
+void PropagationPrefetcher::produce(void)
+{
+    while(!m_stop.load()) {
+        /* Steps already released by a jump of the consumer are skipped. */
+        std::size_t next = std::max(m_produced.load(std::memory_order_relaxed), m_released.load());
+
+        if(next - m_released.load() >= m_capacity) {
+            /* Ring full: wait until the consumer releases a slot. */
+            m_producer_parked.store(true);
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeup.wait(lock, [&] {
+                return m_stop.load() || next - m_released.load() < m_capacity;
+            });
+            m_producer_parked.store(false);
+            continue;
+        }
+
+        /* The slot belongs to a released step, so the consumer does not read it. */
+        m_propagator->propagate(getTime(next), m_ring[next % m_capacity]);
+        m_produced.store(next + 1);
+        wakeUp(m_consumer_parked);
+    }
+}
+
+void PropagationPrefetcher::acquire(std::size_t first, std::size_t last)
+{
+    /* Release first, so that a full ring does not block the steps being waited for. */
+    if(first > m_released.load(std::memory_order_relaxed)) {
+        m_released.store(first);
+        wakeUp(m_producer_parked);
+    }
+
+    if(m_produced.load() <= last) {
+        auto begin = std::chrono::steady_clock::now();
+        m_waits++;
+        m_consumer_parked.store(true);
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wakeup.wait(lock, [&] { return m_produced.load() > last; });
+        }
+        m_consumer_parked.store(false);
+        std::chrono::duration<double> waited = std::chrono::steady_clock::now() - begin;
+        m_wait_time += waited.count();
+    }
+}
+
+const BatchStates& PropagationPrefetcher::getStates(std::size_t step)
+{
+    std::size_t released = m_released.load(std::memory_order_relaxed);
+
+    if(step < released) {
+        LOG_WARN("Requested snapshot already released; the oldest retained one is returned.");
+        step = released;
+    }
+    acquire(step, step);
+    return m_ring[step % m_capacity];
+}
+
+/* Two-body acceleration at a position (km/s^2), used as the derivative of the velocity. */
+static void gravity(const double r[3], double a[3])
+{
+    double norm = std::sqrt(r[0] * r[0] + r[1] * r[1] + r[2] * r[2]);
+    double factor = -Globals::constants.earth_mu / (norm * norm * norm);
+
+    for(int c = 0; c < 3; c++) {
+        a[c] = factor * r[c];
+    }
+}
+
+bool PropagationPrefetcher::getState(
+    std::size_t satellite,
+    double time,
+    std::tuple<ECICoordinates, ECICoordinates>& state
+)
+{
+    double u = (time - m_start) / m_step;
+
+    m_requests++;
+    if(u < 0 || (std::size_t)u < m_released.load(std::memory_order_relaxed)) {
+        m_fallbacks++;
+        return false;
+    }
+
+    std::size_t k = (std::size_t)u;
+    acquire(k, k + 1);
+
+    /* Cubic Hermite interpolation between steps k and k + 1. */
+    const BatchStates& a = m_ring[k % m_capacity];
+    const BatchStates& b = m_ring[(k + 1) % m_capacity];
+    double s = u - k;
+    double h = m_step * PREFETCH_SECONDS_PER_UNIT;
+    double s2 = s * s;
+    double s3 = s2 * s;
+    double h00 = 2 * s3 - 3 * s2 + 1;
+    double h10 = (s3 - 2 * s2 + s) * h;
+    double h01 = -2 * s3 + 3 * s2;
+    double h11 = (s3 - s2) * h;
+    double p0[3] = {a.x[satellite], a.y[satellite], a.z[satellite]};
+    double p1[3] = {b.x[satellite], b.y[satellite], b.z[satellite]};
+    double v0[3] = {a.vx[satellite], a.vy[satellite], a.vz[satellite]};
+    double v1[3] = {b.vx[satellite], b.vy[satellite], b.vz[satellite]};
+    double a0[3], a1[3], r[3], v[3];
+
+    gravity(p0, a0);
+    gravity(p1, a1);
+    for(int c = 0; c < 3; c++) {
+        r[c] = h00 * p0[c] + h10 * v0[c] + h01 * p1[c] + h11 * v1[c];
+        v[c] = h00 * v0[c] + h10 * a0[c] + h01 * v1[c] + h11 * a1[c];
+    }
+    state = std::make_tuple(ECICoordinates(r[0], r[1], r[2]), ECICoordinates(v[0], v[1], v[2]));
+    return true;
+}
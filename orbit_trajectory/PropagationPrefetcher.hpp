@@ -0,0 +1,184 @@
+/***********************************************************************************************//**
+ *  Background thread that propagates a constellation ahead of the simulation time
+ *  @class      PropagationPrefetcher
+ *  @author     DSS-SIM development team, i2CAT
+ *  @date       2026-oct-16
+ *  @copyright  This code has been developed by Fundació Privada Internet i Innovació Digital a
+ *              Catalunya (i2CAT). i2CAT is a non-profit research and innovation centre that
+ *              promotes mission-driven knowledge to solve business challenges, co-create solutions
+ *              with a transformative impact, empower citizens through open and participative
+ *              digital social innovation with territorial capillarity, and promote pioneering and
+ *              strategic initiatives. i2CAT *aims to transfer* research project results to private
+ *              companies in order to create social and economic impact via the out-licensing of
+ *              intellectual property and the creation of spin-offs.
+ *              Find more information of i2CAT projects and IP rights at:
+ *              https://i2cat.net/tech-transfer/
+ **************************************************************************************************/
+
+#ifndef __PROPAGATION_PREFETCHER_HPP__
+#define __PROPAGATION_PREFETCHER_HPP__
+
+/* Global libraries */
+#include "dss.hpp"
+
+/* External Libraries */
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+/* Internal Libraries */
+#include "ECICoordinates.hpp"
+#include "SGP4BatchPropagator.hpp"
+
+#define PREFETCH_HORIZON            64      /**< Default number of steps propagated ahead */
+#define PREFETCH_SECONDS_PER_UNIT   60.0    /**< Seconds per unit of propagation time (SGP4
+                                              *  evaluates its time argument in minutes) */
+
+/***********************************************************************************************//**
+ * Asynchronous propagation pipeline. A producer thread propagates the whole constellation at
+ * equally spaced time steps and stores each snapshot in a ring of horizon + 2 slots, up to
+ * horizon steps ahead of the step being read. The event thread only reads finished snapshots and
+ * interpolates between the two that enclose the requested time, so on-demand SGP4 evaluations
+ * leave the event loop. Positions use cubic Hermite interpolation with the SGP4 velocities, and
+ * velocities use the same interpolation with the two-body acceleration as their derivative.
+ *
+ * The ring is a single-producer single-consumer queue: the producer publishes a step by advancing
+ * an atomic counter, and the consumer releases the slots of older steps by advancing another one,
+ * so neither side takes a lock while there is work to do. A side only parks on a condition
+ * variable when the ring is full (producer) or the requested step is not ready yet (consumer);
+ * the latter case is counted, so the horizon can be tuned until the event loop never waits.
+ *
+ * Times shall be requested in non-decreasing order, as the simulation clock advances. Requests
+ * before the oldest retained step are refused and counted as fallbacks, so the caller propagates
+ * them itself. All the query methods shall be called from a single thread.
+ *
+ * @see     SGP4BatchPropagator
+ **************************************************************************************************/
+class PropagationPrefetcher
+{
+public:
+    /*******************************************************************************************//**
+     * Constructs the pipeline and starts the producer thread.
+     *
+     * @param  propagator   Batch propagator of the constellation
+     * @param  start        Time of the first step, from the reference epoch of the propagator
+     * @param  step         Time between consecutive steps
+     * @param  horizon      Number of steps propagated ahead of the step being read
+     **********************************************************************************************/
+    PropagationPrefetcher(
+        std::shared_ptr<const SGP4BatchPropagator> propagator,
+        double start,
+        double step,
+        std::size_t horizon = PREFETCH_HORIZON
+    );
+
+    /*******************************************************************************************//**
+     * Destructor. It stops the producer thread.
+     **********************************************************************************************/
+    ~PropagationPrefetcher(void);
+
+    PropagationPrefetcher(const PropagationPrefetcher&) = delete;
+    PropagationPrefetcher& operator=(const PropagationPrefetcher&) = delete;
+
+    /*******************************************************************************************//**
+     * Retrieves the number of satellites of the constellation.
+     **********************************************************************************************/
+    std::size_t size(void) const { return m_propagator->size(); }
+
+    /*******************************************************************************************//**
+     * Retrieves the Julian date of time 0, that is, the reference epoch of the batch propagator.
+     **********************************************************************************************/
+    double getReferenceEpoch(void) const { return m_propagator->getReferenceEpoch(); }
+
+    /*******************************************************************************************//**
+     * Retrieves the interpolated state of a satellite. It waits for the producer only if the
+     * snapshots around the time are not finished yet.
+     *
+     * @param  satellite    Index of the satellite in the batch propagator
+     * @param  time         Propagation time from the reference epoch of the propagator
+     * @param  state        Output tuple with the ECI position and velocity
+     * @return              False if the time is before the oldest retained step
+     **********************************************************************************************/
+    bool getState(std::size_t satellite, double time,
+        std::tuple<ECICoordinates, ECICoordinates>& state);
+
+    /*******************************************************************************************//**
+     * Retrieves the snapshot of the whole constellation at a time step, waiting for it if needed.
+     * Older steps are released. The step shall not be older than the oldest retained step.
+     *
+     * @param  step     Index of the time step
+     **********************************************************************************************/
+    const BatchStates& getStates(std::size_t step);
+
+    /*******************************************************************************************//**
+     * Retrieves the time of a step.
+     *
+     * @param  step     Index of the time step
+     **********************************************************************************************/
+    double getTime(std::size_t step) const { return m_start + m_step * step; }
+
+    /*******************************************************************************************//**
+     * Retrieves the number of state requests.
+     **********************************************************************************************/
+    std::size_t getRequestCount(void) const { return m_requests; }
+
+    /*******************************************************************************************//**
+     * Retrieves the number of requests that had to wait for the producer.
+     **********************************************************************************************/
+    std::size_t getWaitCount(void) const { return m_waits; }
+
+    /*******************************************************************************************//**
+     * Retrieves the total time spent waiting for the producer (s of wall-clock time).
+     **********************************************************************************************/
+    double getWaitTime(void) const { return m_wait_time; }
+
+    /*******************************************************************************************//**
+     * Retrieves the number of requests refused because they were before the oldest retained step.
+     **********************************************************************************************/
+    std::size_t getFallbackCount(void) const { return m_fallbacks; }
+
+private:
+    std::shared_ptr<const SGP4BatchPropagator> m_propagator;    /**< Constellation propagator */
+    double m_start;                                             /**< Time of the first step */
+    double m_step;                                              /**< Time between steps */
+    std::size_t m_capacity;                                     /**< Slots of the ring */
+    std::vector<BatchStates> m_ring;                            /**< Snapshots, by step % slots */
+    std::atomic<std::size_t> m_produced;                        /**< Steps published */
+    std::atomic<std::size_t> m_released;                        /**< Oldest step still in use */
+    std::atomic<bool> m_stop;                                   /**< Producer shall finish */
+    std::atomic<bool> m_producer_parked;                        /**< Producer waits for space */
+    std::atomic<bool> m_consumer_parked;                        /**< Consumer waits for a step */
+    std::mutex m_mutex;                                         /**< Mutex of the parking */
+    std::condition_variable m_wakeup;                           /**< Wakes up a parked side */
+    std::thread m_producer;                                     /**< Producer thread */
+    std::size_t m_requests;                                     /**< State requests */
+    std::size_t m_waits;                                        /**< Requests that waited */
+    double m_wait_time;                                         /**< Time spent waiting (s) */
+    std::size_t m_fallbacks;                                    /**< Requests out of the ring */
+
+    /*******************************************************************************************//**
+     * Body of the producer thread.
+     **********************************************************************************************/
+    void produce(void);
+
+    /*******************************************************************************************//**
+     * Waits until a range of steps has been published and releases the steps before it.
+     *
+     * @param  first    Index of the first step of the range
+     * @param  last     Index of the last step of the range
+     **********************************************************************************************/
+    void acquire(std::size_t first, std::size_t last);
+
+    /*******************************************************************************************//**
+     * Wakes up the other side if it is parked.
+     *
+     * @param  parked   Parking flag of the other side
+     **********************************************************************************************/
+    void wakeUp(const std::atomic<bool>& parked);
+};
+
+#endif /* __PROPAGATION_PREFETCHER_HPP__ */
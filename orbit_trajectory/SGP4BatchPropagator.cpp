@@ -0,0 +1,385 @@
+/***********************************************************************************************//**
+ *  Class that propagates a whole constellation with a vectorised SGP4 model
+ *  @class      SGP4BatchPropagator
+ *  @author     DSS-SIM development team, i2CAT
+ *  @date       2026-oct-16
+ *  @copyright  This code has been developed by Fundació Privada Internet i Innovació Digital a
+ *              Catalunya (i2CAT). i2CAT is a non-profit research and innovation centre that
+ *              promotes mission-driven knowledge to solve business challenges, co-create solutions
+ *              with a transformative impact, empower citizens through open and participative
+ *              digital social innovation with territorial capillarity, and promote pioneering and
+ *              strategic initiatives. i2CAT *aims to transfer* research project results to private
+ *              companies in order to create social and economic impact via the out-licensing of
+ *              intellectual property and the creation of spin-offs.
+ *              Find more information of i2CAT projects and IP rights at:
+ *              https://i2cat.net/tech-transfer/
+ **************************************************************************************************/
+
+#include "SGP4BatchPropagator.hpp"
+
+LOG_COMPONENT_DEFINE("SGP4BatchPropagator");
+
+void BatchStates::resize(std::size_t count)
+{
+    x.resize(count);
+    y.resize(count);
+    z.resize(count);
+    vx.resize(count);
+    vy.resize(count);
+    vz.resize(count);
+    error.resize(count);
+}
+
+SGP4BatchPropagator::SGP4BatchPropagator(void)
+    : m_size(0)
+    , m_jd_reference(0)
+    , m_single_precision(false)
+{ }
+
+void SGP4BatchPropagator::setReferenceEpoch(double jd)
+{
+    m_jd_reference = jd;
+    for(std::size_t i = 0; i < m_size; i++) {
+        m_epoch_offset[i] = ((m_jd_epoch[i] - m_jd_reference) + m_jd_epoch_fraction[i])
+            / SGP4_TIME_UNIT_DAYS;
+    }
+}
+
+std::size_t SGP4BatchPropagator::addSatellite(const elsetrec& satrec)
+{
+    const double x2o3 = 2.0 / 3.0;
+    double cosio = std::cos(satrec.inclo);
+
+    m_no_unkozai.push_back(satrec.no_unkozai);
+    m_aobase.push_back(std::pow(satrec.xke / satrec.no_unkozai, x2o3));
+    m_xke.push_back(satrec.xke);
+    m_radius.push_back(satrec.radiusearthkm);
+    m_vkmpersec.push_back(satrec.radiusearthkm * satrec.xke / 60.0);
+    m_j2.push_back(satrec.j2);
+    m_mo.push_back(satrec.mo);
+    m_mdot.push_back(satrec.mdot);
+    m_argpo.push_back(satrec.argpo);
+    m_argpdot.push_back(satrec.argpdot);
+    m_nodeo.push_back(satrec.nodeo);
+    m_nodedot.push_back(satrec.nodedot);
+    m_nodecf.push_back(satrec.nodecf);
+    m_cc1.push_back(satrec.cc1);
+    m_cc4.push_back(satrec.cc4);
+    m_cc5.push_back(satrec.cc5);
+    m_bstar.push_back(satrec.bstar);
+    m_t2cof.push_back(satrec.t2cof);
+    m_t3cof.push_back(satrec.t3cof);
+    m_t4cof.push_back(satrec.t4cof);
+    m_t5cof.push_back(satrec.t5cof);
+    m_omgcof.push_back(satrec.omgcof);
+    m_eta.push_back(satrec.eta);
+    m_xmcof.push_back(satrec.xmcof);
+    m_delmo.push_back(satrec.delmo);
+    m_sinmao.push_back(satrec.sinmao);
+    m_d2.push_back(satrec.d2);
+    m_d3.push_back(satrec.d3);
+    m_d4.push_back(satrec.d4);
+    m_ecco.push_back(satrec.ecco);
+    m_sinio.push_back(std::sin(satrec.inclo));
+    m_cosio.push_back(cosio);
+    m_inclo.push_back(satrec.inclo);
+    m_aycof.push_back(satrec.aycof);
+    m_xlcof.push_back(satrec.xlcof);
+    m_con41.push_back(satrec.con41);
+    m_x1mth2.push_back(satrec.x1mth2);
+    m_x7thm1.push_back(satrec.x7thm1);
+    m_nonsimple.push_back(satrec.isimp == 1 ? 0.0 : 1.0);
+
+    /* The integer and fractional parts are subtracted separately to keep the sub-second
+     * resolution of the epochs. */
+    if(m_size == 0 && m_jd_reference == 0) {
+        m_jd_reference = satrec.jdsatepoch + satrec.jdsatepochF;
+    }
+    m_jd_epoch.push_back(satrec.jdsatepoch);
+    m_jd_epoch_fraction.push_back(satrec.jdsatepochF);
+    m_epoch_offset.push_back(((satrec.jdsatepoch - m_jd_reference) + satrec.jdsatepochF)
+        / SGP4_TIME_UNIT_DAYS);
+
+    /* Deep-space satellites keep their full element set for the scalar fallback. */
+    if(satrec.method == 'd') {
+        m_deep_index.push_back(m_size);
+        m_deep_satrec.push_back(satrec);
+    }
+
+    return m_size++;
+}
+
+std::size_t SGP4BatchPropagator::addSatellite(const SGP4OrbitTrajectory& trajectory)
+{
+    return addSatellite(trajectory.getSatrec());
+}
+
+void SGP4BatchPropagator::propagate(
+    double time,
+    double* x, double* y, double* z,
+    double* vx, double* vy, double* vz,
+    int* error
+) const
+{
+    propagate(time, 0, m_size, x, y, z, vx, vy, vz, error);
+}
+
+void SGP4BatchPropagator::propagate(double time, BatchStates& states) const
+{
+    if(states.size() != m_size) {
+        states.resize(m_size);
+    }
+    propagate(time, 0, m_size, states.x.data(), states.y.data(), states.z.data(),
+        states.vx.data(), states.vy.data(), states.vz.data(), states.error.data());
+}
+
+void SGP4BatchPropagator::propagate(
+    double time,
+    std::size_t begin,
+    std::size_t end,
+    double* x, double* y, double* z,
+    double* vx, double* vy, double* vz,
+    int* error
+) const
+{
+    end = std::min(end, m_size);
+
+    if(m_single_precision) {
+        const std::size_t lanes = 2 * SGP4_BATCH_LANES;
+        for(std::size_t first = begin; first < end; first += lanes) {
+            std::size_t count = std::min<std::size_t>(lanes, end - first);
+            propagateBlock<float>(time, first, count, x, y, z, vx, vy, vz, error);
+        }
+    } else {
+        for(std::size_t first = begin; first < end; first += SGP4_BATCH_LANES) {
+            std::size_t count = std::min<std::size_t>(SGP4_BATCH_LANES, end - first);
+            propagateBlock<double>(time, first, count, x, y, z, vx, vy, vz, error);
+        }
+    }
+
+    /* Overwrite the lanes of deep-space satellites with the scalar SGP4 routine. */
+    std::vector<std::size_t>::const_iterator it =
+        std::lower_bound(m_deep_index.begin(), m_deep_index.end(), begin);
+    for(; it != m_deep_index.end() && *it < end; ++it) {
+        double r[3] = {0, 0, 0};
+        double v[3] = {0, 0, 0};
+        std::size_t i = *it;
+        elsetrec satrec = m_deep_satrec[it - m_deep_index.begin()];
+
+        SGP4Funcs::sgp4(satrec, time - m_epoch_offset[i], r, v);
+        x[i] = r[0];  y[i] = r[1];  z[i] = r[2];
+        vx[i] = v[0]; vy[i] = v[1]; vz[i] = v[2];
+        if(error != nullptr) {
+            error[i] = satrec.error;
+        }
+    }
+}
+
+template<typename Real>
+void SGP4BatchPropagator::propagateBlock(
+    double time,
+    std::size_t first,
+    std::size_t count,
+    double* x, double* y, double* z,
+    double* vx, double* vy, double* vz,
+    int* error
+) const
+{
+    const int lanes = SGP4_BATCH_LANES * sizeof(double) / sizeof(Real);
+    const double twopi = 2.0 * Globals::constants.pi;
+    const Real kepler_tolerance = sizeof(Real) < sizeof(double) ? Real(1.0e-6) : Real(1.0e-12);
+
+    /* Lane-local working arrays. Unused lanes replicate the last satellite of the block. The
+     * secular angles grow with time and are kept in double until they are reduced to [0, 2pi). */
+    std::size_t idx[lanes];
+    double mm[lanes], argpm[lanes], nodem[lanes];
+    Real am[lanes], nm[lanes], em[lanes];
+    Real axnl[lanes], aynl[lanes], u[lanes], eo1[lanes], sineo1[lanes], coseo1[lanes];
+    Real mrt[lanes], su[lanes], xnode[lanes], xinc[lanes], mvt[lanes], rvdot[lanes];
+    int err[lanes];
+    bool active[lanes];
+
+    for(int l = 0; l < lanes; l++) {
+        idx[l] = first + std::min<std::size_t>(l, count - 1);
+    }
+
+    /* Secular gravity and atmospheric drag, at the time since the epoch of each lane. */
+    for(int l = 0; l < lanes; l++) {
+        std::size_t i = idx[l];
+        double t = time - m_epoch_offset[i];
+        double t2 = t * t;
+        double t3 = t2 * t;
+        double t4 = t3 * t;
+        double xmdf = m_mo[i] + m_mdot[i] * t;
+        double argpdf = m_argpo[i] + m_argpdot[i] * t;
+        double delmtemp = 1.0 + m_eta[i] * std::cos(xmdf);
+        double delm = m_xmcof[i] * (delmtemp * delmtemp * delmtemp - m_delmo[i]);
+        double temp = m_nonsimple[i] * (m_omgcof[i] * t + delm);
+        double tempa = 1.0 - m_cc1[i] * t
+            - m_nonsimple[i] * (m_d2[i] * t2 + m_d3[i] * t3 + m_d4[i] * t4);
+        double templ = m_t2cof[i] * t2
+            + m_nonsimple[i] * (m_t3cof[i] * t3 + t4 * (m_t4cof[i] + t * m_t5cof[i]));
+        double tempe;
+        double a;
+        double e;
+
+        mm[l] = xmdf + temp;
+        argpm[l] = argpdf - temp;
+        tempe = m_bstar[i] * m_cc4[i] * t
+            + m_nonsimple[i] * m_bstar[i] * m_cc5[i] * (std::sin(mm[l]) - m_sinmao[i]);
+        nodem[l] = m_nodeo[i] + m_nodedot[i] * t + m_nodecf[i] * t2;
+
+        a = m_aobase[i] * tempa * tempa;
+        e = m_ecco[i] - tempe;
+        am[l] = a;
+        nm[l] = m_xke[i] / (a * std::sqrt(a));
+        err[l] = (m_no_unkozai[i] <= 0.0) ? 2 : ((e >= 1.0 || e < -0.001) ? 1 : 0);
+        em[l] = std::max(e, 1.0e-6);
+        mm[l] = mm[l] + m_no_unkozai[i] * templ;
+    }
+
+    /* Angle reduction (same result as std::fmod) and long period periodics. */
+    for(int l = 0; l < lanes; l++) {
+        std::size_t i = idx[l];
+        double xlm = mm[l] + argpm[l] + nodem[l];
+        Real temp;
+        Real xl;
+
+        nodem[l] = nodem[l] - twopi * std::trunc(nodem[l] / twopi);
+        argpm[l] = argpm[l] - twopi * std::trunc(argpm[l] / twopi);
+        xlm = xlm - twopi * std::trunc(xlm / twopi);
+        mm[l] = xlm - argpm[l] - nodem[l];
+        mm[l] = mm[l] - twopi * std::trunc(mm[l] / twopi);
+
+        axnl[l] = em[l] * std::cos(Real(argpm[l]));
+        temp = Real(1.0) / (am[l] * (Real(1.0) - em[l] * em[l]));
+        aynl[l] = em[l] * std::sin(Real(argpm[l])) + temp * Real(m_aycof[i]);
+        xl = Real(mm[l] + argpm[l] + nodem[l]) + temp * Real(m_xlcof[i]) * axnl[l];
+        u[l] = xl - Real(nodem[l]);
+        u[l] = u[l] - Real(twopi) * std::trunc(u[l] / Real(twopi));
+        eo1[l] = u[l];
+        sineo1[l] = 0.0;
+        coseo1[l] = 0.0;
+        active[l] = true;
+    }
+
+    /* Kepler's equation. Converged lanes are frozen until every lane has converged. */
+    for(int ktr = 1; ktr <= 10; ktr++) {
+        bool any_active = false;
+        for(int l = 0; l < lanes; l++) {
+            Real s = std::sin(eo1[l]);
+            Real c = std::cos(eo1[l]);
+            Real tem5 = Real(1.0) - c * axnl[l] - s * aynl[l];
+            tem5 = (u[l] - aynl[l] * c + axnl[l] * s - eo1[l]) / tem5;
+            tem5 = std::min(std::max(tem5, Real(-0.95)), Real(0.95));
+
+            sineo1[l] = active[l] ? s : sineo1[l];
+            coseo1[l] = active[l] ? c : coseo1[l];
+            eo1[l] = active[l] ? eo1[l] + tem5 : eo1[l];
+            active[l] = active[l] && std::fabs(tem5) >= kepler_tolerance;
+            any_active = any_active || active[l];
+        }
+        if(!any_active) {
+            break;
+        }
+    }
+
+    /* Short period periodics. */
+    for(int l = 0; l < lanes; l++) {
+        std::size_t i = idx[l];
+        Real ecose = axnl[l] * coseo1[l] + aynl[l] * sineo1[l];
+        Real esine = axnl[l] * sineo1[l] - aynl[l] * coseo1[l];
+        Real el2 = axnl[l] * axnl[l] + aynl[l] * aynl[l];
+        Real pl = am[l] * (Real(1.0) - el2);
+        Real rl = am[l] * (Real(1.0) - ecose);
+        Real rdotl = std::sqrt(am[l]) * esine / rl;
+        Real rvdotl = std::sqrt(std::fabs(pl)) / rl;
+        Real betal = std::sqrt(Real(1.0) - el2);
+        Real temp = esine / (Real(1.0) + betal);
+        Real sinu = am[l] / rl * (sineo1[l] - aynl[l] - axnl[l] * temp);
+        Real cosu = am[l] / rl * (coseo1[l] - axnl[l] + aynl[l] * temp);
+        Real sin2u = (cosu + cosu) * sinu;
+        Real cos2u = Real(1.0) - Real(2.0) * sinu * sinu;
+        Real temp1 = Real(0.5 * m_j2[i]) / pl;
+        Real temp2 = temp1 / pl;
+        Real con41 = m_con41[i];
+        Real x1mth2 = m_x1mth2[i];
+        Real cosio = m_cosio[i];
+        Real xke = m_xke[i];
+
+        err[l] = (err[l] == 0 && pl < Real(0.0)) ? 4 : err[l];
+        su[l] = std::atan2(sinu, cosu) - Real(0.25) * temp2 * Real(m_x7thm1[i]) * sin2u;
+        mrt[l] = rl * (Real(1.0) - Real(1.5) * temp2 * betal * con41)
+            + Real(0.5) * temp1 * x1mth2 * cos2u;
+        xnode[l] = Real(nodem[l]) + Real(1.5) * temp2 * cosio * sin2u;
+        xinc[l] = Real(m_inclo[i]) + Real(1.5) * temp2 * cosio * Real(m_sinio[i]) * cos2u;
+        mvt[l] = rdotl - nm[l] * temp1 * x1mth2 * sin2u / xke;
+        rvdot[l] = rvdotl + nm[l] * temp1 * (x1mth2 * cos2u + Real(1.5) * con41) / xke;
+    }
+
+    /* Orientation vectors and output. */
+    for(int l = 0; l < (int)count; l++) {
+        std::size_t i = idx[l];
+        Real sinsu = std::sin(su[l]);
+        Real cossu = std::cos(su[l]);
+        Real snod = std::sin(xnode[l]);
+        Real cnod = std::cos(xnode[l]);
+        Real sini = std::sin(xinc[l]);
+        Real cosi = std::cos(xinc[l]);
+        Real xmx = -snod * cosi;
+        Real xmy = cnod * cosi;
+        Real ux = xmx * sinsu + cnod * cossu;
+        Real uy = xmy * sinsu + snod * cossu;
+        Real uz = sini * sinsu;
+        Real wx = xmx * cossu - cnod * sinsu;
+        Real wy = xmy * cossu - snod * sinsu;
+        Real wz = sini * cossu;
+
+        if(err[l] == 0 && mrt[l] < Real(1.0)) {
+            err[l] = 6;
+        }
+        if(err[l] != 0 && err[l] != 6) {
+            x[i] = y[i] = z[i] = vx[i] = vy[i] = vz[i] = 0.0;
+        } else {
+            x[i] = mrt[l] * ux * m_radius[i];
+            y[i] = mrt[l] * uy * m_radius[i];
+            z[i] = mrt[l] * uz * m_radius[i];
+            vx[i] = (mvt[l] * ux + rvdot[l] * wx) * m_vkmpersec[i];
+            vy[i] = (mvt[l] * uy + rvdot[l] * wy) * m_vkmpersec[i];
+            vz[i] = (mvt[l] * uz + rvdot[l] * wz) * m_vkmpersec[i];
+        }
+        if(error != nullptr) {
+            error[i] = err[l];
+        }
+    }
+}
+
+double SGP4BatchPropagator::validate(double time, std::vector<elsetrec> satrecs, double tolerance) const
+{
+    double max_diff = 0.0;
+    BatchStates states;
+
+    if(satrecs.size() != m_size) {
+        LOG_WARN("Number of element sets does not match the number of propagated satellites.");
+        return -1.0;
+    }
+    propagate(time, states);
+
+    for(std::size_t i = 0; i < m_size; i++) {
+        double r[3] = {0, 0, 0};
+        double v[3] = {0, 0, 0};
+        SGP4Funcs::sgp4(satrecs[i], time - m_epoch_offset[i], r, v);
+
+        double dx = states.x[i] - r[0];
+        double dy = states.y[i] - r[1];
+        double dz = states.z[i] - r[2];
+        double diff = std::sqrt(dx * dx + dy * dy + dz * dz);
+        if(diff > tolerance) {
+            std::stringstream ss;
+            ss << "Satellite " << i << " differs " << diff << " km from the scalar SGP4 path.";
+            LOG_WARN(ss.str());
+        }
+        max_diff = std::max(max_diff, diff);
+    }
+    return max_diff;
+}
@@ -0,0 +1,273 @@
+/***********************************************************************************************//**
+ *  Class that propagates a whole constellation with a vectorised SGP4 model
+ *  @class      SGP4BatchPropagator
+ *  @author     DSS-SIM development team, i2CAT
+ *  @date       2026-oct-16
+ *  @copyright  This code has been developed by Fundació Privada Internet i Innovació Digital a
+ *              Catalunya (i2CAT). i2CAT is a non-profit research and innovation centre that
+ *              promotes mission-driven knowledge to solve business challenges, co-create solutions
+ *              with a transformative impact, empower citizens through open and participative
+ *              digital social innovation with territorial capillarity, and promote pioneering and
+ *              strategic initiatives. i2CAT *aims to transfer* research project results to private
+ *              companies in order to create social and economic impact via the out-licensing of
+ *              intellectual property and the creation of spin-offs.
+ *              Find more information of i2CAT projects and IP rights at:
+ *              https://i2cat.net/tech-transfer/
+ **************************************************************************************************/
+
+#ifndef __SGP4_BATCH_PROPAGATOR_HPP__
+#define __SGP4_BATCH_PROPAGATOR_HPP__
+
+/* Global libraries */
+#include "dss.hpp"
+
+/* External Libraries */
+#include <cmath>
+#include <vector>
+#include "SGP4.h"
+
+/* Internal Libraries */
+#include "SGP4OrbitTrajectory.hpp"
+
+/* Number of satellites evaluated together. It matches the doubles that fit in a vector register. */
+#if defined(__AVX512F__)
+#define SGP4_BATCH_LANES 8
+#elif defined(__AVX__)
+#define SGP4_BATCH_LANES 4
+#else
+#define SGP4_BATCH_LANES 2
+#endif
+
+/***********************************************************************************************//**
+ * Positions and velocities of a constellation in structure-of-arrays layout. The i-th element of
+ * each array belongs to the i-th satellite of the propagator that filled it. Positions are given
+ * in km and velocities in km/s, in the same ECI frame as SGP4OrbitTrajectory::sgp4Propagate.
+ **************************************************************************************************/
+struct BatchStates
+{
+    std::vector<double> x;      /**< Position along the X axis (in km) */
+    std::vector<double> y;      /**< Position along the Y axis (in km) */
+    std::vector<double> z;      /**< Position along the Z axis (in km) */
+    std::vector<double> vx;     /**< Velocity along the X axis (in km/s) */
+    std::vector<double> vy;     /**< Velocity along the Y axis (in km/s) */
+    std::vector<double> vz;     /**< Velocity along the Z axis (in km/s) */
+    std::vector<int> error;     /**< SGP4 error code of each satellite (0 if no error) */
+
+    /*******************************************************************************************//**
+     * Resizes all the arrays to hold the states of a given number of satellites.
+     *
+     * @param  count    Number of satellites
+     **********************************************************************************************/
+    void resize(std::size_t count);
+
+    /*******************************************************************************************//**
+     * Retrieves the number of satellites whose state can be stored.
+     **********************************************************************************************/
+    std::size_t size(void) const { return x.size(); }
+};
+
+/***********************************************************************************************//**
+ * Constellation-level SGP4 propagator. The element sets of all satellites are kept in a
+ * structure-of-arrays layout and the near-Earth SGP4 equations are evaluated for
+ * SGP4_BATCH_LANES satellites at a time, so that the compiler can map each lane to a slot of a
+ * SIMD register. Deep-space satellites (periods of 225 min or longer) are not vectorised and are
+ * propagated with the scalar SGP4Funcs::sgp4 routine instead.
+ *
+ * Satellites may have different TLE epochs. Propagation times are measured from a reference epoch
+ * common to the whole constellation, so every state of a call belongs to the same instant: each
+ * satellite is evaluated at the time minus the offset of its own epoch. The reference is the epoch
+ * of the first satellite added, unless it is set with setReferenceEpoch.
+ *
+ * The propagation methods are const and do not modify the propagator, so the same instance can be
+ * shared by several threads as long as each of them writes into different output ranges.
+ *
+ * @see     SGP4OrbitTrajectory
+ **************************************************************************************************/
+class SGP4BatchPropagator
+{
+public:
+    /*******************************************************************************************//**
+     * Constructs an empty propagator. Satellites are added with addSatellite.
+     **********************************************************************************************/
+    SGP4BatchPropagator(void);
+
+    /*******************************************************************************************//**
+     * Auto-generated destructor.
+     **********************************************************************************************/
+    ~SGP4BatchPropagator(void) = default;
+
+    /*******************************************************************************************//**
+     * Adds a satellite given its SGP4 element set, already initialised with SGP4Funcs::sgp4init.
+     *
+     * @param  satrec   Initialised SGP4 element set
+     * @return          Index of the satellite in the output arrays
+     **********************************************************************************************/
+    std::size_t addSatellite(const elsetrec& satrec);
+
+    /*******************************************************************************************//**
+     * Adds a satellite from an SGP4 trajectory on which sgp4Init has already been called.
+     *
+     * @param  trajectory   SGP4 trajectory of the satellite
+     * @return              Index of the satellite in the output arrays
+     **********************************************************************************************/
+    std::size_t addSatellite(const SGP4OrbitTrajectory& trajectory);
+
+    /*******************************************************************************************//**
+     * Retrieves the number of satellites of the constellation.
+     **********************************************************************************************/
+    std::size_t size(void) const { return m_size; }
+
+    /*******************************************************************************************//**
+     * Sets the epoch from which the propagation times are measured, e.g. the Julian date of the
+     * start of the scenario, so that the times match the Earth rotation of the stages that use
+     * the states. It can be called before or after adding the satellites.
+     *
+     * @param  jd       Julian date of propagation time 0
+     **********************************************************************************************/
+    void setReferenceEpoch(double jd);
+
+    /*******************************************************************************************//**
+     * Retrieves the Julian date of propagation time 0 (0 if no satellite has been added yet).
+     **********************************************************************************************/
+    double getReferenceEpoch(void) const { return m_jd_reference; }
+
+    /*******************************************************************************************//**
+     * Retrieves the propagation time of the epoch of a satellite, that is, the time that SGP4
+     * subtracts to evaluate it.
+     *
+     * @param  satellite    Index of the satellite
+     * @return              Time of the epoch (in min)
+     **********************************************************************************************/
+    double getEpochOffset(std::size_t satellite) const { return m_epoch_offset[satellite]; }
+
+    /*******************************************************************************************//**
+     * Enables the mixed-precision mode. The secular terms, which grow with the time since epoch,
+     * and their reduction to [0, 2pi) stay in double; the periodics, Kepler's equation and the
+     * orientation vectors are evaluated in float, so twice as many satellites fit in each SIMD
+     * register. Position errors stay at the kilometre level over a month of propagation (see the
+     * accuracy report of the benchmark suite). Deep-space satellites keep the double-precision
+     * scalar path.
+     *
+     * @param  enable   True to evaluate in mixed precision
+     **********************************************************************************************/
+    void setSinglePrecision(bool enable) { m_single_precision = enable; }
+
+    /*******************************************************************************************//**
+     * Checks if the mixed-precision mode is enabled.
+     **********************************************************************************************/
+    bool isSinglePrecision(void) const { return m_single_precision; }
+
+    /*******************************************************************************************//**
+     * Propagates all the satellites to a given time. The states are written in place into the
+     * caller-provided arrays, which shall hold at least size() elements.
+     *
+     * @param  time     Propagation time from the reference epoch (in min)
+     * @param  x,y,z    Output positions (in km)
+     * @param  vx,vy,vz Output velocities (in km/s)
+     * @param  error    Optional output SGP4 error codes (0 if no error)
+     **********************************************************************************************/
+    void propagate(double time, double* x, double* y, double* z,
+        double* vx, double* vy, double* vz, int* error = nullptr) const;
+
+    /*******************************************************************************************//**
+     * Propagates the satellites with indices in [begin, end) to a given time. The i-th satellite is
+     * written at the i-th position of the output arrays.
+     *
+     * @param  time     Propagation time from the reference epoch (in min)
+     * @param  begin    First satellite index to propagate
+     * @param  end      Index past the last satellite to propagate
+     * @param  x,y,z    Output positions (in km)
+     * @param  vx,vy,vz Output velocities (in km/s)
+     * @param  error    Optional output SGP4 error codes (0 if no error)
+     **********************************************************************************************/
+    void propagate(double time, std::size_t begin, std::size_t end, double* x, double* y, double* z,
+        double* vx, double* vy, double* vz, int* error = nullptr) const;
+
+    /*******************************************************************************************//**
+     * Propagates all the satellites to a given time, resizing the output states if needed.
+     *
+     * @param  time     Propagation time from the reference epoch (in min)
+     * @param  states   Output states of the constellation
+     **********************************************************************************************/
+    void propagate(double time, BatchStates& states) const;
+
+    /*******************************************************************************************//**
+     * Validates the vectorised propagation against the scalar SGP4Funcs::sgp4 routine. Each
+     * satellite whose position differs more than the tolerance is reported with a warning.
+     *
+     * @param  time         Propagation time from the reference epoch (in min)
+     * @param  satrecs      Element sets used to add the satellites, in the same order
+     * @param  tolerance    Maximum accepted position difference (in km)
+     * @return              Maximum position difference found (in km)
+     **********************************************************************************************/
+    double validate(double time, std::vector<elsetrec> satrecs, double tolerance) const;
+
+private:
+    std::size_t m_size;                     /**< Number of satellites */
+    double m_jd_reference;                  /**< Julian date of propagation time 0 */
+    std::vector<double> m_jd_epoch;         /**< Julian date of the epoch (integer part) */
+    std::vector<double> m_jd_epoch_fraction;    /**< Julian date of the epoch (fraction) */
+    std::vector<double> m_epoch_offset;     /**< Propagation time of the epoch (in min) */
+    /* Near-Earth element set in structure-of-arrays layout (one entry per satellite) */
+    std::vector<double> m_no_unkozai;       /**< Un-Kozai'd mean motion (in rad/min) */
+    std::vector<double> m_aobase;           /**< Semi-major axis at epoch, (xke/n)^(2/3) */
+    std::vector<double> m_xke;              /**< Gravity constant (in 1/min) */
+    std::vector<double> m_radius;           /**< Earth radius of the gravity model (in km) */
+    std::vector<double> m_vkmpersec;        /**< Conversion from Earth radii/min to km/s */
+    std::vector<double> m_j2;               /**< J2 zonal harmonic of the gravity model */
+    std::vector<double> m_mo;               /**< Mean anomaly at epoch (in rad) */
+    std::vector<double> m_mdot;             /**< Mean anomaly rate (in rad/min) */
+    std::vector<double> m_argpo;            /**< Argument of perigee at epoch (in rad) */
+    std::vector<double> m_argpdot;          /**< Argument of perigee rate (in rad/min) */
+    std::vector<double> m_nodeo;            /**< RAAN at epoch (in rad) */
+    std::vector<double> m_nodedot;          /**< RAAN rate (in rad/min) */
+    std::vector<double> m_nodecf;           /**< RAAN drag coefficient */
+    std::vector<double> m_cc1;              /**< Drag coefficient C1 */
+    std::vector<double> m_cc4;              /**< Drag coefficient C4 */
+    std::vector<double> m_cc5;              /**< Drag coefficient C5 */
+    std::vector<double> m_bstar;            /**< Drag term */
+    std::vector<double> m_t2cof;            /**< Drag coefficient of the t^2 term */
+    std::vector<double> m_t3cof;            /**< Drag coefficient of the t^3 term */
+    std::vector<double> m_t4cof;            /**< Drag coefficient of the t^4 term */
+    std::vector<double> m_t5cof;            /**< Drag coefficient of the t^5 term */
+    std::vector<double> m_omgcof;           /**< Argument of perigee drag coefficient */
+    std::vector<double> m_eta;              /**< Eta coefficient */
+    std::vector<double> m_xmcof;            /**< Mean anomaly drag coefficient */
+    std::vector<double> m_delmo;            /**< (1 + eta cos(mo))^3 */
+    std::vector<double> m_sinmao;           /**< Sine of the mean anomaly at epoch */
+    std::vector<double> m_d2;               /**< Drag coefficient D2 */
+    std::vector<double> m_d3;               /**< Drag coefficient D3 */
+    std::vector<double> m_d4;               /**< Drag coefficient D4 */
+    std::vector<double> m_ecco;             /**< Eccentricity at epoch */
+    std::vector<double> m_sinio;            /**< Sine of the inclination */
+    std::vector<double> m_cosio;            /**< Cosine of the inclination */
+    std::vector<double> m_inclo;            /**< Inclination (in rad) */
+    std::vector<double> m_aycof;            /**< Long period coefficient (y component) */
+    std::vector<double> m_xlcof;            /**< Long period coefficient (longitude) */
+    std::vector<double> m_con41;            /**< 3 cos^2(i) - 1 */
+    std::vector<double> m_x1mth2;           /**< 1 - cos^2(i) */
+    std::vector<double> m_x7thm1;           /**< 7 cos^2(i) - 1 */
+    std::vector<double> m_nonsimple;        /**< 1 if the full drag model applies, 0 otherwise */
+    std::vector<std::size_t> m_deep_index;  /**< Indices of deep-space satellites (ascending) */
+    std::vector<elsetrec> m_deep_satrec;    /**< Element sets of the deep-space satellites */
+    bool m_single_precision;                /**< Mixed-precision mode enabled */
+
+    /*******************************************************************************************//**
+     * Evaluates the near-Earth SGP4 equations for a block of consecutive satellites. The block
+     * holds the satellites that fit in SGP4_BATCH_LANES doubles, that is, SGP4_BATCH_LANES of
+     * them with Real = double and twice as many with Real = float.
+     *
+     * @tparam Real     Type of the periodic terms
+     * @param  time     Propagation time from the reference epoch (in min)
+     * @param  first    Index of the first satellite of the block
+     * @param  count    Number of satellites of the block
+     * @param  x,y,z    Output positions (in km)
+     * @param  vx,vy,vz Output velocities (in km/s)
+     * @param  error    Optional output SGP4 error codes
+     **********************************************************************************************/
+    template<typename Real>
+    void propagateBlock(double time, std::size_t first, std::size_t count, double* x, double* y,
+        double* z, double* vx, double* vy, double* vz, int* error) const;
+};
+
+#endif /* __SGP4_BATCH_PROPAGATOR_HPP__ */
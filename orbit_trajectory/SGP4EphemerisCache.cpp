@@ -0,0 +1,179 @@
+/***********************************************************************************************//**
+ *  Class that caches the SGP4 states of a satellite as piecewise Chebyshev series
+ *  @class      SGP4EphemerisCache
+ *  @author     DSS-SIM development team, i2CAT
+ *  @date       2026-oct-16
+ *  @copyright  This code has been developed by Fundació Privada Internet i Innovació Digital a
+ *              Catalunya (i2CAT). i2CAT is a non-profit research and innovation centre that
+ *              promotes mission-driven knowledge to solve business challenges, co-create solutions
+ *              with a transformative impact, empower citizens through open and participative
+ *              digital social innovation with territorial capillarity, and promote pioneering and
+ *              strategic initiatives. i2CAT *aims to transfer* research project results to private
+ *              companies in order to create social and economic impact via the out-licensing of
+ *              intellectual property and the creation of spin-offs.
+ *              Find more information of i2CAT projects and IP rights at:
+ *              https://i2cat.net/tech-transfer/
+ **************************************************************************************************/
+
+#include "SGP4EphemerisCache.hpp"
+#include "SGP4OrbitTrajectory.hpp"
+
+LOG_COMPONENT_DEFINE("SGP4EphemerisCache");
+
+/* Halvings of a coarse segment that the error bounds can force. */
+#define EPHEMERIS_CACHE_MAX_DEPTH   16
+
+SGP4EphemerisCache::SGP4EphemerisCache(
+    SGP4OrbitTrajectory* trajectory,
+    double segment,
+    double max_error,
+    double max_velocity_error,
+    unsigned int degree
+)
+    : m_trajectory(trajectory)
+    , m_segment(segment)
+    , m_max_error(max_error)
+    , m_max_velocity_error(max_velocity_error)
+    , m_degree(std::max(degree, 2u))
+    , m_max_depth(0)
+    , m_last(nullptr)
+    , m_hits(0)
+    , m_misses(0)
+{ }
+
+void SGP4EphemerisCache::invalidate(void)
+{
+    m_segments.clear();
+    m_depths.clear();
+    m_max_depth = 0;
+    m_last = nullptr;
+}
+
+std::tuple<ECICoordinates, ECICoordinates> SGP4EphemerisCache::getState(double time)
+{
+    const Segment* segment = m_last;
+    unsigned int n = m_degree + 1;
+
+    if(segment == nullptr || time < segment->start || time >= segment->mid + segment->half) {
+        segment = &getSegment(time);
+        m_last = segment;
+    } else {
+        m_hits++;
+    }
+
+    const double* c = segment->coeffs.data();
+    double x = (time - segment->mid) / segment->half;
+    ECICoordinates position(evaluate(c, x), evaluate(c + n, x), evaluate(c + 2 * n, x));
+    ECICoordinates velocity(evaluate(c + 3 * n, x), evaluate(c + 4 * n, x), evaluate(c + 5 * n, x));
+
+    return std::make_tuple(position, velocity);
+}
+
+const SGP4EphemerisCache::Segment& SGP4EphemerisCache::getSegment(double time)
+{
+    std::map<double, Segment>::iterator it = m_segments.upper_bound(time);
+    if(it != m_segments.begin()) {
+        --it;
+        if(time < it->second.mid + it->second.half) {
+            m_hits++;
+            return it->second;
+        }
+    }
+
+    /* The segments of a coarse segment are dyadic halves of it. Starting at the deepest level
+     * that it has needed, the segment containing the time cannot overlap the fitted ones. */
+    int64_t coarse = (int64_t)std::floor(time / m_segment);
+    std::map<int64_t, int>::iterator depth_it = m_depths.find(coarse);
+    int depth = (depth_it != m_depths.end()) ? depth_it->second : 0;
+    Segment segment;
+    double length, start, error;
+
+    while(true) {
+        length = m_segment / (double)(1 << depth);
+        start = coarse * m_segment
+            + std::min(std::floor((time - coarse * m_segment) / length), (double)(1 << depth) - 1)
+            * length;
+        error = fitSegment(start, length, segment);
+        if(error <= 1.0 || depth == EPHEMERIS_CACHE_MAX_DEPTH) {
+            break;
+        }
+        depth++;
+    }
+    if(error > 1.0) {
+        std::stringstream ss;
+        ss << "Ephemeris cache cannot reach the error bounds of " << m_max_error << " km and "
+           << m_max_velocity_error << " km/s (estimated error " << error << " times the bound).";
+        LOG_WARN(ss.str());
+    }
+    if(depth > 0) {
+        m_depths[coarse] = depth;
+        m_max_depth = std::max(m_max_depth, depth);
+    }
+
+    m_misses++;
+    return m_segments.emplace(start, segment).first->second;
+}
+
+double SGP4EphemerisCache::fitSegment(double start, double length, Segment& segment)
+{
+    const double pi = Globals::constants.pi;
+    unsigned int n = m_degree + 1;
+    std::vector<double> samples(6 * n);
+    double position_error = 0.0;
+    double velocity_error = 0.0;
+
+    segment.start = start;
+    segment.half = length / 2.0;
+    segment.mid = start + segment.half;
+    segment.coeffs.assign(6 * n, 0.0);
+
+    /* Sample the SGP4 state at the Chebyshev nodes of the segment. */
+    for(unsigned int j = 0; j < n; j++) {
+        double node = std::cos(pi * (j + 0.5) / n);
+        ECICoordinates r, v;
+        std::tie(r, v) = m_trajectory->sgp4Propagate(segment.mid + segment.half * node);
+        samples[j] = r.x;
+        samples[n + j] = r.y;
+        samples[2 * n + j] = r.z;
+        samples[3 * n + j] = v.x;
+        samples[4 * n + j] = v.y;
+        samples[5 * n + j] = v.z;
+    }
+
+    /* Discrete Chebyshev transform of each component. */
+    for(unsigned int comp = 0; comp < 6; comp++) {
+        for(unsigned int m = 0; m < n; m++) {
+            double sum = 0.0;
+            for(unsigned int j = 0; j < n; j++) {
+                sum += samples[comp * n + j] * std::cos(pi * m * (j + 0.5) / n);
+            }
+            segment.coeffs[comp * n + m] = (m == 0 ? 1.0 : 2.0) * sum / n;
+        }
+    }
+
+    /* The two highest-order coefficients bound the truncation error of a smooth series. */
+    for(unsigned int comp = 0; comp < 6; comp++) {
+        double error = std::fabs(segment.coeffs[comp * n + n - 1])
+            + std::fabs(segment.coeffs[comp * n + n - 2]);
+        if(comp < 3) {
+            position_error = std::max(position_error, error);
+        } else {
+            velocity_error = std::max(velocity_error, error);
+        }
+    }
+    return std::max(position_error / m_max_error, velocity_error / m_max_velocity_error);
+}
+
+double SGP4EphemerisCache::evaluate(const double* coeffs, double x) const
+{
+    double b1 = 0.0;
+    double b2 = 0.0;
+    double x2 = 2.0 * x;
+
+    for(int k = (int)m_degree; k >= 1; k--) {
+        double b0 = coeffs[k] + x2 * b1 - b2;
+        b2 = b1;
+        b1 = b0;
+    }
+    return coeffs[0] + x * b1 - b2;
+}
@@ -0,0 +1,167 @@
+/***********************************************************************************************//**
+ *  Class that caches the SGP4 states of a satellite as piecewise Chebyshev series
+ *  @class      SGP4EphemerisCache
+ *  @author     DSS-SIM development team, i2CAT
+ *  @date       2026-oct-16
+ *  @copyright  This code has been developed by Fundació Privada Internet i Innovació Digital a
+ *              Catalunya (i2CAT). i2CAT is a non-profit research and innovation centre that
+ *              promotes mission-driven knowledge to solve business challenges, co-create solutions
+ *              with a transformative impact, empower citizens through open and participative
+ *              digital social innovation with territorial capillarity, and promote pioneering and
+ *              strategic initiatives. i2CAT *aims to transfer* research project results to private
+ *              companies in order to create social and economic impact via the out-licensing of
+ *              intellectual property and the creation of spin-offs.
+ *              Find more information of i2CAT projects and IP rights at:
+ *              https://i2cat.net/tech-transfer/
+ **************************************************************************************************/
+
+#ifndef __SGP4_EPHEMERIS_CACHE_HPP__
+#define __SGP4_EPHEMERIS_CACHE_HPP__
+
+/* Global libraries */
+#include "dss.hpp"
+
+/* External Libraries */
+#include <cmath>
+#include <map>
+#include <vector>
+
+/* Internal Libraries */
+#include "ECICoordinates.hpp"
+
+#define EPHEMERIS_CACHE_SEGMENT         1.0     /**< Default segment length (min) */
+#define EPHEMERIS_CACHE_MAX_ERROR       1.0e-3  /**< Default position error bound (km) */
+#define EPHEMERIS_CACHE_MAX_VEL_ERROR   1.0e-6  /**< Default velocity error bound (km/s) */
+
+class SGP4OrbitTrajectory;      /* Needed to create a bidirectional relationship */
+
+/***********************************************************************************************//**
+ * Ephemeris cache of an SGP4 trajectory. The time axis is split in segments of a fixed length and,
+ * the first time a segment is queried, the SGP4 state is evaluated at the Chebyshev nodes of the
+ * segment and fitted with a Chebyshev series for each position and velocity component. Further
+ * queries inside the segment only evaluate the series (a few multiply-adds per component).
+ *
+ * The truncation error of each fitted segment is estimated from the two highest-order
+ * coefficients of its position and velocity series. If either exceeds its bound, the segment is
+ * split in halves, and so on, until both bounds are met, so the answered states stay within the
+ * bounds of the SGP4 ones. Only the part of the time axis that needs it is refined: the segments
+ * already fitted are kept, and later segments of the same coarse segment start at the depth that
+ * it needed.
+ *
+ * @see     SGP4OrbitTrajectory
+ **************************************************************************************************/
+class SGP4EphemerisCache
+{
+public:
+    /*******************************************************************************************//**
+     * Constructs an empty cache in front of an SGP4 trajectory.
+     *
+     * @param  trajectory   Trajectory whose sgp4Propagate feeds the cache
+     * @param  segment      Length of each fitted segment, as sgp4Propagate times (in min)
+     * @param  max_error    Maximum position error accepted for the fitted series (in km)
+     * @param  max_velocity_error   Maximum velocity error accepted for the series (in km/s)
+     * @param  degree       Degree of the Chebyshev series of each segment
+     **********************************************************************************************/
+    SGP4EphemerisCache(
+        SGP4OrbitTrajectory* trajectory,
+        double segment = EPHEMERIS_CACHE_SEGMENT,
+        double max_error = EPHEMERIS_CACHE_MAX_ERROR,
+        double max_velocity_error = EPHEMERIS_CACHE_MAX_VEL_ERROR,
+        unsigned int degree = 7
+    );
+
+    /*******************************************************************************************//**
+     * Auto-generated destructor.
+     **********************************************************************************************/
+    ~SGP4EphemerisCache(void) = default;
+
+    /*******************************************************************************************//**
+     * Retrieves the position and the velocity of the satellite at a given time. The segment that
+     * contains the time is fitted first if it is not in the cache yet.
+     *
+     * @param  time     Propagation time, with the same meaning as in sgp4Propagate
+     * @return          Tuple with the ECI position and velocity
+     **********************************************************************************************/
+    std::tuple<ECICoordinates, ECICoordinates> getState(double time);
+
+    /*******************************************************************************************//**
+     * Drops all the fitted segments. It shall be called when the element set of the trajectory
+     * changes.
+     **********************************************************************************************/
+    void invalidate(void);
+
+    /*******************************************************************************************//**
+     * Retrieves the configured segment length (in min).
+     **********************************************************************************************/
+    double getSegmentLength(void) const { return m_segment; }
+
+    /*******************************************************************************************//**
+     * Retrieves the shortest segment fitted so far (in min). It is lower than the configured
+     * length if the error bounds forced the cache to refine part of the time axis.
+     **********************************************************************************************/
+    double getMinSegmentLength(void) const { return m_segment / (double)(1 << m_max_depth); }
+
+    /*******************************************************************************************//**
+     * Retrieves the number of queries answered without evaluating SGP4.
+     **********************************************************************************************/
+    uint64_t getHits(void) const { return m_hits; }
+
+    /*******************************************************************************************//**
+     * Retrieves the number of segments that have been fitted.
+     **********************************************************************************************/
+    uint64_t getMisses(void) const { return m_misses; }
+
+private:
+    /*******************************************************************************************//**
+     * Chebyshev coefficients of one segment. The coefficients of the six components (x, y, z, vx,
+     * vy, vz) are stored consecutively, degree + 1 values each.
+     **********************************************************************************************/
+    struct Segment
+    {
+        double start;                   /**< Time at the start of the segment */
+        double mid;                     /**< Time at the middle of the segment */
+        double half;                    /**< Half of the segment length */
+        std::vector<double> coeffs;     /**< Coefficients of the six components */
+    };
+
+    SGP4OrbitTrajectory* m_trajectory;      /**< Trajectory that feeds the cache */
+    double m_segment;                       /**< Length of the coarse segments (in min) */
+    double m_max_error;                     /**< Maximum position error (in km) */
+    double m_max_velocity_error;            /**< Maximum velocity error (in km/s) */
+    unsigned int m_degree;                  /**< Degree of the Chebyshev series */
+    std::map<double, Segment> m_segments;   /**< Fitted segments, keyed by their start time */
+    std::map<int64_t, int> m_depths;        /**< Halvings needed by each refined coarse segment */
+    int m_max_depth;                        /**< Deepest refinement so far */
+    const Segment* m_last;                  /**< Last segment used, to skip the map look-up */
+    uint64_t m_hits;                        /**< Queries answered from fitted segments */
+    uint64_t m_misses;                      /**< Segments fitted */
+
+    /*******************************************************************************************//**
+     * Retrieves the segment that contains a given time, fitting it if needed.
+     *
+     * @param  time     Propagation time, with the same meaning as in sgp4Propagate
+     * @return          Fitted segment
+     **********************************************************************************************/
+    const Segment& getSegment(double time);
+
+    /*******************************************************************************************//**
+     * Fits the SGP4 states of a segment.
+     *
+     * @param  start    Time at the start of the segment
+     * @param  length   Length of the segment
+     * @param  segment  Output segment
+     * @return          Largest estimated truncation error, relative to its bound (1 at the bound)
+     **********************************************************************************************/
+    double fitSegment(double start, double length, Segment& segment);
+
+    /*******************************************************************************************//**
+     * Evaluates a Chebyshev series with Clenshaw's recurrence.
+     *
+     * @param  coeffs   Coefficients of the series
+     * @param  x        Normalised time, in [-1, 1]
+     * @return          Value of the series
+     **********************************************************************************************/
+    double evaluate(const double* coeffs, double x) const;
+};
+
+#endif /* __SGP4_EPHEMERIS_CACHE_HPP__ */
@@ -0,0 +1,48 @@
+/***********************************************************************************************//**
+ *  SGP4 propagation kernels specialised at compile time for near-Earth element sets
+ *  @class      SGP4Kernels
+ *  @author     DSS-SIM development team, i2CAT
+ *  @date       2026-oct-16
+ *  @copyright  This code has been developed by Fundació Privada Internet i Innovació Digital a
+ *              Catalunya (i2CAT). i2CAT is a non-profit research and innovation centre that
+ *              promotes mission-driven knowledge to solve business challenges, co-create solutions
+ *              with a transformative impact, empower citizens through open and participative
+ *              digital social innovation with territorial capillarity, and promote pioneering and
+ *              strategic initiatives. i2CAT *aims to transfer* research project results to private
+ *              companies in order to create social and economic impact via the out-licensing of
+ *              intellectual property and the creation of spin-offs.
+ *              Find more information of i2CAT projects and IP rights at:
+ *              https://i2cat.net/tech-transfer/
+ **************************************************************************************************/
+
+#include "SGP4Kernels.hpp"
+
+/* Picks the instantiation of a gravity model for the drag model and precision. */
+template<gravconsttype G>
+static SGP4Kernel selectForGravity(bool simple, bool singlePrecision)
+{
+    if(singlePrecision) {
+        return simple ? &sgp4NearEarth<G, true, float> : &sgp4NearEarth<G, false, float>;
+    }
+    return simple ? &sgp4NearEarth<G, true> : &sgp4NearEarth<G, false>;
+}
+
+SGP4Kernel selectSGP4Kernel(const elsetrec& satrec, gravconsttype constType, bool singlePrecision)
+{
+    bool simple = satrec.isimp == 1;
+
+    if(satrec.method == 'd') {
+        return &SGP4Funcs::sgp4;
+    }
+
+    switch(constType) {
+        case wgs72old:
+            return selectForGravity<wgs72old>(simple, singlePrecision);
+        case wgs72:
+            return selectForGravity<wgs72>(simple, singlePrecision);
+        case wgs84:
+            return selectForGravity<wgs84>(simple, singlePrecision);
+        default:
+            return &SGP4Funcs::sgp4;
+    }
+}
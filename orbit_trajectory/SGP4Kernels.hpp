@@ -0,0 +1,264 @@
+/***********************************************************************************************//**
+ *  SGP4 propagation kernels specialised at compile time for near-Earth element sets
+ *  @class      SGP4Kernels
+ *  @author     DSS-SIM development team, i2CAT
+ *  @date       2026-oct-16
+ *  @copyright  This code has been developed by Fundació Privada Internet i Innovació Digital a
+ *              Catalunya (i2CAT). i2CAT is a non-profit research and innovation centre that
+ *              promotes mission-driven knowledge to solve business challenges, co-create solutions
+ *              with a transformative impact, empower citizens through open and participative
+ *              digital social innovation with territorial capillarity, and promote pioneering and
+ *              strategic initiatives. i2CAT *aims to transfer* research project results to private
+ *              companies in order to create social and economic impact via the out-licensing of
+ *              intellectual property and the creation of spin-offs.
+ *              Find more information of i2CAT projects and IP rights at:
+ *              https://i2cat.net/tech-transfer/
+ **************************************************************************************************/
+
+#ifndef __SGP4_KERNELS_HPP__
+#define __SGP4_KERNELS_HPP__
+
+/* Global libraries */
+#include "dss.hpp"
+
+/* External Libraries */
+#include <cmath>
+#include "SGP4.h"
+
+/***********************************************************************************************//**
+ * Propagation routine with the same interface and results as SGP4Funcs::sgp4.
+ **************************************************************************************************/
+typedef bool (*SGP4Kernel)(elsetrec& satrec, double tsince, double r[3], double v[3]);
+
+/***********************************************************************************************//**
+ * Gravitational constants of each model, as returned by SGP4Funcs::getgravconst. They are
+ * compile-time constants so that the kernels do not load them from the element set.
+ **************************************************************************************************/
+template<gravconsttype G> struct SGP4Gravity;
+
+template<> struct SGP4Gravity<wgs72old>
+{
+    static constexpr double radius = 6378.135;                  /**< Earth radius (km) */
+    static constexpr double xke = 0.0743669161;                 /**< sqrt(mu) (earth radii^1.5/min) */
+    static constexpr double j2 = 0.001082616;                   /**< Second zonal harmonic */
+    static constexpr double vkmpersec = 6378.135 * 0.0743669161 / 60.0;    /**< km/s per unit */
+};
+
+template<> struct SGP4Gravity<wgs72>
+{
+    static constexpr double radius = 6378.135;
+    static constexpr double xke = 0.07436691613317342;
+    static constexpr double j2 = 0.001082616;
+    static constexpr double vkmpersec = 6378.135 * 0.07436691613317342 / 60.0;
+};
+
+template<> struct SGP4Gravity<wgs84>
+{
+    static constexpr double radius = 6378.137;
+    static constexpr double xke = 0.07436685316871385;
+    static constexpr double j2 = 0.00108262998905;
+    static constexpr double vkmpersec = 6378.137 * 0.07436685316871385 / 60.0;
+};
+
+/***********************************************************************************************//**
+ * Near-Earth SGP4 propagation for one gravity model and one drag model. It follows
+ * SGP4Funcs::sgp4 step by step, but the deep-space branches are removed and the simplified drag
+ * branch (perigee below 220 km, isimp = 1) is resolved at compile time. The operation mode only
+ * affects the deep-space lunar-solar periodics, so it does not take part in the specialisation.
+ *
+ * With Real = float the kernel runs in mixed precision: the secular terms, which grow with the
+ * time since epoch, and their reduction to [0, 2pi) stay in double, and the periodics, Kepler's
+ * equation and the orientation vectors are evaluated in float.
+ *
+ * @tparam G        Gravity model used by sgp4init
+ * @tparam Simple   True for element sets with isimp = 1
+ * @tparam Real     Type of the periodic terms (double or float)
+ * @param  satrec   Near-Earth element set initialised with the same gravity model
+ * @param  tsince   Time since the epoch of the element set, as in SGP4Funcs::sgp4
+ * @param  r        Output position (km)
+ * @param  v        Output velocity (km/s)
+ * @return          False if SGP4 reports an error (see satrec.error)
+ **************************************************************************************************/
+template<gravconsttype G, bool Simple, typename Real = double>
+bool sgp4NearEarth(elsetrec& satrec, double tsince, double r[3], double v[3])
+{
+    typedef SGP4Gravity<G> Gravity;
+    const double twopi = 2.0 * M_PI;
+    const double x2o3 = 2.0 / 3.0;
+    const double t = tsince;
+    const double t2 = t * t;
+
+    satrec.t = t;
+    satrec.error = 0;
+
+    /* Secular gravity and atmospheric drag. */
+    double xmdf = satrec.mo + satrec.mdot * t;
+    double argpdf = satrec.argpo + satrec.argpdot * t;
+    double nodedf = satrec.nodeo + satrec.nodedot * t;
+    double argpm = argpdf;
+    double mm = xmdf;
+    double nodem = nodedf + satrec.nodecf * t2;
+    double tempa = 1.0 - satrec.cc1 * t;
+    double tempe = satrec.bstar * satrec.cc4 * t;
+    double templ = satrec.t2cof * t2;
+
+    if(!Simple) {
+        double delomg = satrec.omgcof * t;
+        double delmtemp = 1.0 + satrec.eta * std::cos(xmdf);
+        double delm = satrec.xmcof * (delmtemp * delmtemp * delmtemp - satrec.delmo);
+        double temp = delomg + delm;
+        double t3 = t2 * t;
+        double t4 = t3 * t;
+        mm = xmdf + temp;
+        argpm = argpdf - temp;
+        tempa = tempa - satrec.d2 * t2 - satrec.d3 * t3 - satrec.d4 * t4;
+        tempe = tempe + satrec.bstar * satrec.cc5 * (std::sin(mm) - satrec.sinmao);
+        templ = templ + satrec.t3cof * t3 + t4 * (satrec.t4cof + t * satrec.t5cof);
+    }
+
+    double nm = satrec.no_unkozai;
+    double em = satrec.ecco;
+    double inclm = satrec.inclo;
+    if(nm <= 0.0) {
+        satrec.error = 2;
+        return false;
+    }
+    double am = std::pow(Gravity::xke / nm, x2o3) * tempa * tempa;
+    nm = Gravity::xke / std::pow(am, 1.5);
+    em = em - tempe;
+    if(em >= 1.0 || em < -0.001) {
+        satrec.error = 1;
+        return false;
+    }
+    if(em < 1.0e-6) {
+        em = 1.0e-6;
+    }
+    mm = mm + satrec.no_unkozai * templ;
+    double xlm = mm + argpm + nodem;
+
+    nodem = std::fmod(nodem, twopi);
+    argpm = std::fmod(argpm, twopi);
+    xlm = std::fmod(xlm, twopi);
+    mm = std::fmod(xlm - argpm - nodem, twopi);
+
+    satrec.am = am;
+    satrec.em = em;
+    satrec.im = inclm;
+    satrec.Om = nodem;
+    satrec.om = argpm;
+    satrec.mm = mm;
+    satrec.nm = nm;
+
+    /* From here on, all the angles are reduced and the terms can be evaluated in Real. */
+    const Real one = 1.0;
+    const Real kepler_tolerance = sizeof(Real) < sizeof(double) ? Real(1.0e-6) : Real(1.0e-12);
+    const Real xke = Gravity::xke;
+    Real sinip = std::sin(Real(inclm));
+    Real cosip = std::cos(Real(inclm));
+
+    /* Long period periodics. */
+    Real ep = em;
+    Real amr = am;
+    Real axnl = ep * std::cos(Real(argpm));
+    Real temp = one / (amr * (one - ep * ep));
+    Real aynl = ep * std::sin(Real(argpm)) + temp * Real(satrec.aycof);
+    Real xl = Real(mm + argpm + nodem) + temp * Real(satrec.xlcof) * axnl;
+
+    /* Kepler's equation. */
+    Real u = std::fmod(xl - Real(nodem), Real(twopi));
+    Real eo1 = u;
+    Real tem5 = 9999.9;
+    Real sineo1 = 0.0;
+    Real coseo1 = 0.0;
+    for(int ktr = 1; std::fabs(tem5) >= kepler_tolerance && ktr <= 10; ktr++) {
+        sineo1 = std::sin(eo1);
+        coseo1 = std::cos(eo1);
+        tem5 = one - coseo1 * axnl - sineo1 * aynl;
+        tem5 = (u - aynl * coseo1 + axnl * sineo1 - eo1) / tem5;
+        if(std::fabs(tem5) >= Real(0.95)) {
+            tem5 = tem5 > Real(0.0) ? Real(0.95) : Real(-0.95);
+        }
+        eo1 = eo1 + tem5;
+    }
+
+    /* Short period preliminary quantities. */
+    Real ecose = axnl * coseo1 + aynl * sineo1;
+    Real esine = axnl * sineo1 - aynl * coseo1;
+    Real el2 = axnl * axnl + aynl * aynl;
+    Real pl = amr * (one - el2);
+    if(pl < Real(0.0)) {
+        satrec.error = 4;
+        return false;
+    }
+
+    Real rl = amr * (one - ecose);
+    Real rdotl = std::sqrt(amr) * esine / rl;
+    Real rvdotl = std::sqrt(pl) / rl;
+    Real betal = std::sqrt(one - el2);
+    temp = esine / (one + betal);
+    Real sinu = amr / rl * (sineo1 - aynl - axnl * temp);
+    Real cosu = amr / rl * (coseo1 - axnl + aynl * temp);
+    Real su = std::atan2(sinu, cosu);
+    Real sin2u = (cosu + cosu) * sinu;
+    Real cos2u = one - Real(2.0) * sinu * sinu;
+    temp = one / pl;
+    Real temp1 = Real(0.5 * Gravity::j2) * temp;
+    Real temp2 = temp1 * temp;
+    Real con41 = satrec.con41;
+    Real x1mth2 = satrec.x1mth2;
+    Real nmr = nm;
+
+    /* Short period periodics. */
+    Real mrt = rl * (one - Real(1.5) * temp2 * betal * con41)
+        + Real(0.5) * temp1 * x1mth2 * cos2u;
+    su = su - Real(0.25) * temp2 * Real(satrec.x7thm1) * sin2u;
+    Real xnode = Real(nodem) + Real(1.5) * temp2 * cosip * sin2u;
+    Real xinc = Real(inclm) + Real(1.5) * temp2 * cosip * sinip * cos2u;
+    Real mvt = rdotl - nmr * temp1 * x1mth2 * sin2u / xke;
+    Real rvdot = rvdotl + nmr * temp1 * (x1mth2 * cos2u + Real(1.5) * con41) / xke;
+
+    /* Orientation vectors. */
+    Real sinsu = std::sin(su);
+    Real cossu = std::cos(su);
+    Real snod = std::sin(xnode);
+    Real cnod = std::cos(xnode);
+    Real sini = std::sin(xinc);
+    Real cosi = std::cos(xinc);
+    Real xmx = -snod * cosi;
+    Real xmy = cnod * cosi;
+    Real ux = xmx * sinsu + cnod * cossu;
+    Real uy = xmy * sinsu + snod * cossu;
+    Real uz = sini * sinsu;
+    Real vx = xmx * cossu - cnod * sinsu;
+    Real vy = xmy * cossu - snod * sinsu;
+    Real vz = sini * cossu;
+
+    r[0] = (mrt * ux) * Gravity::radius;
+    r[1] = (mrt * uy) * Gravity::radius;
+    r[2] = (mrt * uz) * Gravity::radius;
+    v[0] = (mvt * ux + rvdot * vx) * Gravity::vkmpersec;
+    v[1] = (mvt * uy + rvdot * vy) * Gravity::vkmpersec;
+    v[2] = (mvt * uz + rvdot * vz) * Gravity::vkmpersec;
+
+    /* Decayed satellite. */
+    if(mrt < one) {
+        satrec.error = 6;
+        return false;
+    }
+    return true;
+}
+
+/***********************************************************************************************//**
+ * Selects the propagation kernel of an initialised element set: a near-Earth kernel specialised
+ * for its gravity model and drag model, or the generic SGP4Funcs::sgp4 for deep-space sets.
+ *
+ * @param  satrec           Element set initialised with sgp4init
+ * @param  constType        Gravity model used by sgp4init
+ * @param  singlePrecision  Select the mixed-precision near-Earth kernel (deep-space sets always
+ *                          use the double-precision generic routine)
+ * @return                  Propagation kernel
+ **************************************************************************************************/
+SGP4Kernel selectSGP4Kernel(const elsetrec& satrec, gravconsttype constType,
+    bool singlePrecision = false);
+
+#endif /* __SGP4_KERNELS_HPP__ */
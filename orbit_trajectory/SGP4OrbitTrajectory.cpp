@@ -16,6 +16,10 @@
  **************************************************************************************************/
 
 #include "SGP4OrbitTrajectory.hpp"
+#include "ElementSetStore.hpp"
+#include "EphemerisFile.hpp"
+#include "PropagationPrefetcher.hpp"
+#include "TrajectoryRecorder.hpp"
 
 LOG_COMPONENT_DEFINE("SGP4OrbitTrajectory");
 
@@ -27,6 +31,12 @@ SGP4OrbitTrajectory::SGP4OrbitTrajectory(
     : OrbitTrajectory(params, sat_id, record)
     , m_init_mean_anomaly(MathUtils::degToRad(init_mean_anomaly))
     , m_angular_speed(std::sqrt(Globals::constants.earth_mu / std::pow(params.semimajor_axis, 3)))
+    , m_kernel(&SGP4Funcs::sgp4)
+    , m_const_type(wgs84)
+    , m_single_precision(false)
+    , m_element_index(0)
+    , m_element_revision(0)
+    , m_epoch_time(0)
 { }
 
 SGP4OrbitTrajectory::SGP4OrbitTrajectory(TLE tle, std::string sat_id, bool record)
@@ -35,6 +45,12 @@ SGP4OrbitTrajectory::SGP4OrbitTrajectory(TLE tle, std::string sat_id, bool recor
 
 SGP4OrbitTrajectory::SGP4OrbitTrajectory(ECICoordinates position)
     : OrbitTrajectory(position)
+    , m_kernel(&SGP4Funcs::sgp4)
+    , m_const_type(wgs84)
+    , m_single_precision(false)
+    , m_element_index(0)
+    , m_element_revision(0)
+    , m_epoch_time(0)
 { }
 
 bool SGP4OrbitTrajectory::sgp4Init(
@@ -44,10 +60,36 @@ bool SGP4OrbitTrajectory::sgp4Init(
     char opsMode
 )
 { 
+    elsetrec satrec;
+    bool success = initSatrec(tle, constType, opsMode, satrec);
+
+    m_satrec = satrec;
+    m_const_type = constType;
+    m_kernel = selectSGP4Kernel(m_satrec, m_const_type, m_single_precision);
+    if(m_ephemeris_cache) {
+        m_ephemeris_cache->invalidate();
+    }
+    if(m_keplerian) {
+        m_keplerian->invalidate();
+    }
+    m_ephemeris_file.reset();
+    m_prefetcher.reset();
+    m_element_sets.reset();
+    m_epoch_time = 0;
+
+    return success;
+}
+
+bool SGP4OrbitTrajectory::initSatrec(
+    const TLE& tle,
+    gravconsttype constType,
+    char opsMode,
+    elsetrec& satrec
+)
+{
     double sec;
     int year, mon, day, hr, minute;
     const double xpdotp = 1440.0 / (2.0 * Globals::constants.pi);
-    elsetrec satrec;
 
     /* First initiliaze satrec and convert units */
     satrec.satnum    = tle.sat_number;
@@ -79,9 +121,7 @@ bool SGP4OrbitTrajectory::sgp4Init(
         - 2433281.5, satrec.bstar, satrec.ndot, satrec.nddot, satrec.ecco, satrec.argpo,
         satrec.inclo, satrec.mo, satrec.no_kozai, satrec.nodeo, satrec);
 
-    m_satrec = satrec;
-
-    return true;
+    return satrec.error == 0;
 }
 
 std::tuple<ECICoordinates, ECICoordinates> SGP4OrbitTrajectory::sgp4Propagate(double time)
@@ -90,7 +130,10 @@ std::tuple<ECICoordinates, ECICoordinates> SGP4OrbitTrajectory::sgp4Propagate(do
     ECICoordinates eci_position;
     ECICoordinates eci_velocity;
 
-    SGP4Funcs::sgp4(m_satrec, time, r, v);
+    if(m_element_sets) {
+        selectElementSet(time);
+    }
+    m_kernel(m_satrec, time - m_epoch_time, r, v);
 
     eci_position = ECICoordinates(r[0], r[1], r[2]);
     eci_velocity = ECICoordinates(v[0], v[1], v[2]);
@@ -98,6 +141,137 @@ std::tuple<ECICoordinates, ECICoordinates> SGP4OrbitTrajectory::sgp4Propagate(do
     return std::make_tuple(eci_position, eci_velocity);
 }
 
+std::tuple<ECICoordinates, ECICoordinates> SGP4OrbitTrajectory::propagateOrbit(double time)
+{
+    std::tuple<ECICoordinates, ECICoordinates> state;
+
+    /* New element sets in the store invalidate the caches before they answer. */
+    if(m_element_sets && m_element_sets->getRevision() != m_element_revision) {
+        selectElementSet(time);
+    }
+    double file_time = m_ephemeris_file
+        ? getSourceTime(time, m_ephemeris_file->getReferenceEpoch()) : time;
+    if(m_ephemeris_file && m_ephemeris_file->covers(file_time)) {
+        state = m_ephemeris_file->getState(m_ephemeris_index, file_time);
+    } else if(m_prefetcher && m_prefetcher->getState(m_prefetch_index,
+        getSourceTime(time, m_prefetcher->getReferenceEpoch()), state)) {
+        /* State read from the propagation pipeline. */
+    } else if(m_keplerian) {
+        state = m_keplerian->getState(time);
+    } else if(m_ephemeris_cache) {
+        state = m_ephemeris_cache->getState(time);
+    } else {
+        state = sgp4Propagate(time);
+    }
+
+    if(m_recorder) {
+        m_recorder->record(m_recorder_index, time, std::get<0>(state), std::get<1>(state));
+    }
+    return state;
+}
+
+void SGP4OrbitTrajectory::setEphemerisSource(
+    std::shared_ptr<const EphemerisFileReader> file,
+    std::size_t index
+)
+{
+    if(file && index >= file->getSatelliteCount()) {
+        LOG_WARN("Satellite index out of the ephemeris file; the source is ignored.");
+        m_ephemeris_file.reset();
+        return;
+    }
+    m_ephemeris_file = file;
+    m_ephemeris_index = index;
+}
+
+void SGP4OrbitTrajectory::setPrefetchSource(
+    std::shared_ptr<PropagationPrefetcher> prefetcher,
+    std::size_t index
+)
+{
+    if(prefetcher && index >= prefetcher->size()) {
+        LOG_WARN("Satellite index out of the propagation pipeline; the source is ignored.");
+        m_prefetcher.reset();
+        return;
+    }
+    m_prefetcher = prefetcher;
+    m_prefetch_index = index;
+}
+
+void SGP4OrbitTrajectory::setElementSetStore(std::shared_ptr<const ElementSetStore> store)
+{
+    if(store && store->size() == 0) {
+        LOG_WARN("Empty element set store; the current element set is kept until it is filled.");
+    }
+    m_element_sets = store;
+    m_element_index = 0;
+    /* Forces the selection, and the invalidation of the caches, at the next evaluation. */
+    m_element_revision = store ? store->getRevision() - 1 : 0;
+}
+
+void SGP4OrbitTrajectory::selectElementSet(double time)
+{
+    if(m_element_sets->getRevision() != m_element_revision) {
+        /* The cached states may come from element sets that are no longer selected. */
+        m_element_revision = m_element_sets->getRevision();
+        m_element_index = m_element_sets->size();
+        if(m_ephemeris_cache) {
+            m_ephemeris_cache->invalidate();
+        }
+        if(m_keplerian) {
+            m_keplerian->invalidate();
+        }
+    }
+
+    /* The selection only depends on the time, so swapping does not invalidate the caches. */
+    std::size_t index = m_element_sets->select(time);
+    if(index != m_element_index && index < m_element_sets->size()) {
+        m_satrec = m_element_sets->getSatrec(index);
+        m_epoch_time = m_element_sets->getEpochTime(index);
+        m_const_type = m_element_sets->getConstType();
+        m_kernel = selectSGP4Kernel(m_satrec, m_const_type, m_single_precision);
+        m_element_index = index;
+    }
+}
+
+double SGP4OrbitTrajectory::getSourceTime(double time, double jd_reference) const
+{
+    if(jd_reference == 0) {
+        return time;
+    }
+
+    /* Time since the epoch of the current element set, plus the epoch from the reference. */
+    return time - m_epoch_time
+        + ((m_satrec.jdsatepoch - jd_reference) + m_satrec.jdsatepochF) / SGP4_TIME_UNIT_DAYS;
+}
+
+void SGP4OrbitTrajectory::setSinglePrecision(bool enable)
+{
+    m_single_precision = enable;
+
+    /* Before sgp4Init, and for deep-space sets, the generic routine is kept. */
+    if(m_kernel != &SGP4Funcs::sgp4) {
+        m_kernel = selectSGP4Kernel(m_satrec, m_const_type, m_single_precision);
+    }
+    if(m_ephemeris_cache) {
+        m_ephemeris_cache->invalidate();
+    }
+    if(m_keplerian) {
+        m_keplerian->invalidate();
+    }
+}
+
+void SGP4OrbitTrajectory::enableEphemerisCache(
+    double segment,
+    double max_error,
+    double max_velocity_error,
+    unsigned int degree
+)
+{
+    m_ephemeris_cache.reset(new SGP4EphemerisCache(this, segment, max_error, max_velocity_error,
+        degree));
+}
+
 double SGP4OrbitTrajectory::computeMean(double t) const
 {
     /* radians */
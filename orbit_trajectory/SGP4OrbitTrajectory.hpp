@@ -23,6 +23,7 @@
 
 /* External Libraries */
 #include <cmath>
+#include <memory>
 #include "SGP4.h" 
 
 /* Internal Libraries */
@@ -31,6 +32,16 @@
 #include "Globals.hpp"
 #include "CoordinateSystemUtils.hpp"
 #include "TimeUtils.hpp"
+#include "SGP4EphemerisCache.hpp"
+#include "SGP4Kernels.hpp"
+#include "KeplerianPropagator.hpp"
+
+#define SGP4_TIME_UNIT_DAYS     (1.0 / 1440.0)  /**< Days per unit of propagation time (min) */
+
+class ElementSetStore;
+class EphemerisFileReader;
+class PropagationPrefetcher;
+class TrajectoryRecorder;
 
 using namespace SGP4Funcs;
 
@@ -114,14 +125,160 @@ public:
     ***********************************************************************************************/
     bool sgp4Init(TLE tle, std::string sat_id, gravconsttype constType = wgs84, char opsMode = 'a');
 
+    /*******************************************************************************************//**
+    *  Builds and initialises an SGP4 element set from a TLE, converting units and the TLE epoch in
+    *  the same way as sgp4Init. It does not modify any trajectory, so it can be used to initialise
+    *  many satellites in parallel.
+    * 
+    *  @param tle          TLE object that represents the orbit of the satellite
+    *  @param constType    Sgp4 gravitational constants set type
+    *  @param opsMode      Mode of operation afspc or improved ('a' or 'i')
+    *  @param satrec       Output SGP4 element set
+    *  @return             True if SGP4 has been initialised without errors, false otherwise
+    ***********************************************************************************************/
+    static bool initSatrec(const TLE& tle, gravconsttype constType, char opsMode, elsetrec& satrec);
+
     /*******************************************************************************************//**
      * Method that performs the propagation of a step. This method uses the SGP4 model to
-     * propagate the satellite position.
+     * propagate the satellite position, through the kernel selected by sgp4Init.
      *
      * @param time  Simulation time in which the satellite position shall be propagated (in seconds)
      **********************************************************************************************/
     std::tuple<ECICoordinates, ECICoordinates> sgp4Propagate(double time);
 
+    /*******************************************************************************************//**
+     * Propagates from a store of successive element sets instead of the single one of sgp4Init.
+     * Before every SGP4 evaluation, the element set with the nearest epoch is selected and, if it
+     * is not the current one, swapped in place. Propagation times are then measured from the
+     * reference date of the store. The store is dropped when sgp4Init is called again.
+     *
+     * @param store     Element sets of this satellite, which may be extended during the run
+     **********************************************************************************************/
+    void setElementSetStore(std::shared_ptr<const ElementSetStore> store);
+
+    /*******************************************************************************************//**
+     * Stops propagating from the element set store. The current element set is kept, with its
+     * propagation times measured from the reference date of the store.
+     **********************************************************************************************/
+    void clearElementSetStore(void) { m_element_sets.reset(); }
+
+    /*******************************************************************************************//**
+     * Retrieves the SGP4 element set built by sgp4Init. It is used by the constellation-level
+     * propagators to copy the initialised orbital parameters.
+     *
+     * @return      Initialised SGP4 element set
+     **********************************************************************************************/
+    const elsetrec& getSatrec(void) const { return m_satrec; }
+
+    /*******************************************************************************************//**
+     * Enables the ephemeris cache. From then on, propagateOrbit answers with piecewise Chebyshev
+     * series fitted to the SGP4 states instead of evaluating SGP4 on every call.
+     *
+     * @param segment      Length of each fitted segment, as sgp4Propagate times (in min)
+     * @param max_error    Maximum position error of the interpolated states (in km)
+     * @param max_velocity_error   Maximum velocity error of the interpolated states (in km/s)
+     * @param degree       Degree of the Chebyshev series of each segment
+     **********************************************************************************************/
+    void enableEphemerisCache(double segment = EPHEMERIS_CACHE_SEGMENT,
+        double max_error = EPHEMERIS_CACHE_MAX_ERROR,
+        double max_velocity_error = EPHEMERIS_CACHE_MAX_VEL_ERROR, unsigned int degree = 7);
+
+    /*******************************************************************************************//**
+     * Disables the ephemeris cache. propagateOrbit evaluates SGP4 directly again.
+     **********************************************************************************************/
+    void disableEphemerisCache(void) { m_ephemeris_cache.reset(); }
+
+    /*******************************************************************************************//**
+     * Retrieves the ephemeris cache, or a null pointer if it is not enabled.
+     **********************************************************************************************/
+    const SGP4EphemerisCache* getEphemerisCache(void) const { return m_ephemeris_cache.get(); }
+
+    /*******************************************************************************************//**
+     * Enables the multi-fidelity mode. From then on, propagateOrbit answers queries close to the
+     * last SGP4 evaluation (such as MAC timeouts) with a two-body model plus J2 anchored to it,
+     * and switches back to SGP4, re-anchoring, when the estimated error crosses the budget. It
+     * takes precedence over the ephemeris cache.
+     *
+     * @param max_error    Error budget of the analytic positions (in km)
+     **********************************************************************************************/
+    void enableMultiFidelity(double max_error = 1.0e-3)
+    {
+        m_keplerian.reset(new KeplerianPropagator(this, max_error));
+    }
+
+    /*******************************************************************************************//**
+     * Disables the multi-fidelity mode. propagateOrbit uses SGP4 for all the queries again.
+     **********************************************************************************************/
+    void disableMultiFidelity(void) { m_keplerian.reset(); }
+
+    /*******************************************************************************************//**
+     * Retrieves the analytic propagator of the multi-fidelity mode, which reports the switch rate
+     * and the error budget of the run, or a null pointer if the mode is not enabled.
+     **********************************************************************************************/
+    const KeplerianPropagator* getMultiFidelity(void) const { return m_keplerian.get(); }
+
+    /*******************************************************************************************//**
+     * Enables the mixed-precision propagation mode of near-Earth satellites: the time since epoch
+     * and the secular terms stay in double and the rest of SGP4 is evaluated in float. It is meant
+     * for studies that need kilometre-level accuracy only; deep-space satellites are not affected.
+     * It can be called before or after sgp4Init.
+     *
+     * @param enable    True to propagate in mixed precision
+     **********************************************************************************************/
+    void setSinglePrecision(bool enable);
+
+    /*******************************************************************************************//**
+     * Replays a recorded ephemeris file. propagateOrbit answers from the file for the times that
+     * it covers, and falls back to the ephemeris cache or to SGP4 outside of them. The source is
+     * dropped when sgp4Init is called again, since the file belongs to the previous element set.
+     * Times are translated from the epoch of this trajectory to the reference epoch of the file.
+     *
+     * @param file     Mapped ephemeris file, which may be shared by many trajectories
+     * @param index    Index of this satellite in the file
+     **********************************************************************************************/
+    void setEphemerisSource(std::shared_ptr<const EphemerisFileReader> file, std::size_t index);
+
+    /*******************************************************************************************//**
+     * Stops replaying the ephemeris file.
+     **********************************************************************************************/
+    void clearEphemerisSource(void) { m_ephemeris_file.reset(); }
+
+    /*******************************************************************************************//**
+     * Reads the states from a background propagation pipeline, so that mobility queries do not
+     * evaluate SGP4 in the event loop. A recorded ephemeris file still takes precedence, and times
+     * already released by the pipeline fall back to the ephemeris cache or to SGP4. The
+     * source is dropped when sgp4Init is called again, since the pipeline was built with the
+     * previous element set. Times are translated to the reference epoch of the pipeline.
+     *
+     * @param prefetcher    Pipeline of the constellation, which may be shared by many trajectories
+     * @param index         Index of this satellite in the batch propagator of the pipeline
+     **********************************************************************************************/
+    void setPrefetchSource(std::shared_ptr<PropagationPrefetcher> prefetcher, std::size_t index);
+
+    /*******************************************************************************************//**
+     * Stops reading from the background propagation pipeline.
+     **********************************************************************************************/
+    void clearPrefetchSource(void) { m_prefetcher.reset(); }
+
+    /*******************************************************************************************//**
+     * Streams every propagated state to a compressed trajectory record on disk. For long runs
+     * with many satellites, construct the trajectory with record = false and attach a recorder,
+     * so the history does not stay in memory.
+     *
+     * @param recorder  Trajectory recorder, which may be shared by many trajectories
+     * @param index     Index of this satellite in the record
+     **********************************************************************************************/
+    void setRecorder(std::shared_ptr<TrajectoryRecorder> recorder, std::size_t index)
+    {
+        m_recorder = recorder;
+        m_recorder_index = index;
+    }
+
+    /*******************************************************************************************//**
+     * Stops streaming the propagated states to the trajectory record.
+     **********************************************************************************************/
+    void clearRecorder(void) { m_recorder.reset(); }
+
 protected:
     /*******************************************************************************************//**
      * Method that performs the propagation of a step. This method is related to the trajectory
@@ -130,9 +287,7 @@ protected:
      *
      * @param      time     time at which the position is computed (in s)
      **********************************************************************************************/
-    virtual std::tuple<ECICoordinates, ECICoordinates> propagateOrbit(double time) {
-        return sgp4Propagate(time);
-    }
+    virtual std::tuple<ECICoordinates, ECICoordinates> propagateOrbit(double time);
 
 private:
     OrbitalCoordinates m_position;  /**< Satellite position in the Orbital frame. It represents thus
@@ -144,7 +299,40 @@ private:
     elsetrec m_satrec;              /**< Embedded structure from SGP4 library which includes all
                                      * orbital parameters needed to propagate with SPG4 model
                                      **/
-    
+    SGP4Kernel m_kernel;            /**< Propagation routine specialised for m_satrec */
+    gravconsttype m_const_type;     /**< Gravity model used by sgp4Init */
+    bool m_single_precision;        /**< Mixed-precision propagation enabled */
+    std::unique_ptr<SGP4EphemerisCache> m_ephemeris_cache;  /**< Optional ephemeris cache */
+    std::unique_ptr<KeplerianPropagator> m_keplerian;       /**< Optional multi-fidelity mode */
+    std::shared_ptr<const EphemerisFileReader> m_ephemeris_file;    /**< Optional recorded file */
+    std::size_t m_ephemeris_index;  /**< Index of the satellite in the recorded file */
+    std::shared_ptr<PropagationPrefetcher> m_prefetcher;    /**< Optional propagation pipeline */
+    std::size_t m_prefetch_index;   /**< Index of the satellite in the pipeline */
+    std::shared_ptr<TrajectoryRecorder> m_recorder;     /**< Optional trajectory record */
+    std::size_t m_recorder_index;   /**< Index of the satellite in the trajectory record */
+    std::shared_ptr<const ElementSetStore> m_element_sets;  /**< Optional element set store */
+    std::size_t m_element_index;    /**< Index of m_satrec in the element set store */
+    uint64_t m_element_revision;    /**< Revision of the store when m_satrec was selected */
+    double m_epoch_time;            /**< Propagation time of the epoch of m_satrec */
+
+    /*******************************************************************************************//**
+     * Swaps in the element set of the store with the nearest epoch to a time, if it is not the
+     * current one. Ingesting new element sets in the store invalidates the caches.
+     *
+     * @param  time     Propagation time, measured from the reference date of the store
+     **********************************************************************************************/
+    void selectElementSet(double time);
+
+    /*******************************************************************************************//**
+     * Translates a propagation time of this trajectory to the time of a constellation-level
+     * source, measured from another reference epoch, so that both refer to the same instant.
+     *
+     * @param  time         Propagation time of this trajectory
+     * @param  jd_reference Julian date of time 0 of the source (0 if it is not known)
+     * @return              Propagation time of the source
+     **********************************************************************************************/
+    double getSourceTime(double time, double jd_reference) const;
+
     /*******************************************************************************************//**
      *  Compute the Mean Anomaly of an orbit given the current time.
      *  @param  current_time    Current simulation time (in s).
@@ -0,0 +1,357 @@
+/***********************************************************************************************//**
+ *  Class that loads a whole TLE catalog and initialises SGP4 for every object
+ *  @class      TLECatalogLoader
+ *  @author     DSS-SIM development team, i2CAT
+ *  @date       2026-oct-16
+ *  @copyright  This code has been developed by Fundació Privada Internet i Innovació Digital a
+ *              Catalunya (i2CAT). i2CAT is a non-profit research and innovation centre that
+ *              promotes mission-driven knowledge to solve business challenges, co-create solutions
+ *              with a transformative impact, empower citizens through open and participative
+ *              digital social innovation with territorial capillarity, and promote pioneering and
+ *              strategic initiatives. i2CAT *aims to transfer* research project results to private
+ *              companies in order to create social and economic impact via the out-licensing of
+ *              intellectual property and the creation of spin-offs.
+ *              Find more information of i2CAT projects and IP rights at:
+ *              https://i2cat.net/tech-transfer/
+ **************************************************************************************************/
+
+#include "TLECatalogLoader.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+LOG_COMPONENT_DEFINE("TLECatalogLoader");
+
+#define TLE_LINE_LENGTH 69      /**< Characters of a TLE line, including the checksum */
+
+/* Parses the columns [first, last] (1-based, as in the TLE format) of a line as a number. */
+static bool parseColumns(const char* line, int first, int last, double& value)
+{
+    char buffer[24];
+    int length = last - first + 1;
+    char* end;
+
+    std::memcpy(buffer, line + first - 1, length);
+    buffer[length] = '\0';
+    value = std::strtod(buffer, &end);
+    while(*end == ' ') {
+        end++;
+    }
+    return end != buffer && *end == '\0';
+}
+
+/* Parses a field with an implied leading decimal point and exponent, such as " 12345-4". */
+static bool parseImpliedDecimal(const char* line, int first, double& value)
+{
+    double mantissa, exponent;
+    char buffer[10];
+
+    buffer[0] = line[first - 1] == '-' ? '-' : '+';
+    buffer[1] = '.';
+    std::memcpy(buffer + 2, line + first, 5);
+    buffer[7] = '\0';
+    mantissa = std::strtod(buffer, nullptr);
+    if(!parseColumns(line, first + 6, first + 7, exponent)) {
+        return false;
+    }
+    value = mantissa * std::pow(10.0, exponent);
+    return true;
+}
+
+/* Parses a satellite number, including the Alpha-5 scheme for numbers above 99999. */
+static bool parseSatelliteNumber(const char* line, int& number)
+{
+    double value;
+    char first = line[2];
+
+    if(first >= 'A' && first <= 'Z' && first != 'I' && first != 'O') {
+        int prefix = first - 'A' + 10 - (first > 'I' ? 1 : 0) - (first > 'O' ? 1 : 0);
+        if(!parseColumns(line, 4, 7, value)) {
+            return false;
+        }
+        number = prefix * 10000 + (int)value;
+        return true;
+    }
+    if(!parseColumns(line, 3, 7, value)) {
+        return false;
+    }
+    number = (int)value;
+    return true;
+}
+
+TLECatalogLoader::TLECatalogLoader(unsigned int threads, gravconsttype constType, char opsMode)
+    : m_pool(threads)
+    , m_const_type(constType)
+    , m_ops_mode(opsMode)
+{ }
+
+bool TLECatalogLoader::load(const std::string& path)
+{
+    struct stat info;
+    int fd = ::open(path.c_str(), O_RDONLY);
+
+    if(fd < 0 || ::fstat(fd, &info) != 0) {
+        std::stringstream ss;
+        ss << "Cannot open TLE catalog " << path;
+        LOG_WARN(ss.str());
+        if(fd >= 0) {
+            ::close(fd);
+        }
+        return false;
+    }
+    if(info.st_size == 0) {
+        ::close(fd);
+        load(nullptr, 0);
+        return true;
+    }
+
+    void* data = ::mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if(data == MAP_FAILED) {
+        std::stringstream ss;
+        ss << "Cannot map TLE catalog " << path;
+        LOG_WARN(ss.str());
+        return false;
+    }
+    ::madvise(data, info.st_size, MADV_SEQUENTIAL);
+
+    load(static_cast<const char*>(data), info.st_size);
+    ::munmap(data, info.st_size);
+    return true;
+}
+
+void TLECatalogLoader::load(const char* data, std::size_t size)
+{
+    m_names.clear();
+    m_tles.clear();
+    m_satrecs.clear();
+    m_failures.clear();
+
+    std::vector<Record> records = splitRecords(data, size);
+    std::vector<TLE> tles(records.size());
+    std::vector<elsetrec> satrecs(records.size());
+    std::vector<std::string> reasons(records.size());
+
+    /* Parse and initialise every record in parallel. */
+    m_pool.parallelFor(records.size(), [&](std::size_t i) {
+        const Record& record = records[i];
+        if(record.line1_length < TLE_LINE_LENGTH || record.line2_length < TLE_LINE_LENGTH) {
+            reasons[i] = "truncated line";
+            return;
+        }
+        if(!parseTLE(record.line1, record.line2, tles[i], reasons[i])) {
+            return;
+        }
+        if(!SGP4OrbitTrajectory::initSatrec(tles[i], m_const_type, m_ops_mode, satrecs[i])) {
+            std::stringstream ss;
+            ss << "sgp4init error " << satrecs[i].error;
+            reasons[i] = ss.str();
+        }
+    });
+
+    /* Gather the results in catalog order. */
+    for(std::size_t i = 0; i < records.size(); i++) {
+        const Record& record = records[i];
+        std::string name = getRecordName(record.name, record.name_length);
+        if(!reasons[i].empty()) {
+            m_failures.push_back(TLELoadFailure{record.line, name, reasons[i]});
+            continue;
+        }
+        if(name.empty()) {
+            name = std::to_string(tles[i].sat_number);
+        }
+        m_names.push_back(name);
+        m_tles.push_back(tles[i]);
+        m_satrecs.push_back(satrecs[i]);
+    }
+
+    /* Records split apart are reported first; failures are listed in catalog order. */
+    std::stable_sort(m_failures.begin(), m_failures.end(),
+        [](const TLELoadFailure& a, const TLELoadFailure& b) { return a.line < b.line; });
+    if(!m_failures.empty()) {
+        std::stringstream ss;
+        ss << m_failures.size() << " catalog objects failed to load.";
+        LOG_WARN(ss.str());
+    }
+}
+
+std::shared_ptr<SGP4BatchPropagator> TLECatalogLoader::createPropagator(void) const
+{
+    std::shared_ptr<SGP4BatchPropagator> propagator = std::make_shared<SGP4BatchPropagator>();
+    for(const elsetrec& satrec : m_satrecs) {
+        propagator->addSatellite(satrec);
+    }
+    return propagator;
+}
+
+bool TLECatalogLoader::verifyChecksum(const char* line)
+{
+    int sum = 0;
+
+    for(int i = 0; i < TLE_LINE_LENGTH - 1; i++) {
+        if(line[i] >= '0' && line[i] <= '9') {
+            sum += line[i] - '0';
+        } else if(line[i] == '-') {
+            sum += 1;
+        }
+    }
+    return line[TLE_LINE_LENGTH - 1] - '0' == sum % 10;
+}
+
+bool TLECatalogLoader::parseTLE(const char* line1, const char* line2, TLE& tle, std::string& reason)
+{
+    double value;
+    int number1, number2;
+
+    if(line1[0] != '1' || line2[0] != '2') {
+        reason = "unexpected line numbers";
+        return false;
+    }
+    if(!verifyChecksum(line1)) {
+        reason = "checksum error in line 1";
+        return false;
+    }
+    if(!verifyChecksum(line2)) {
+        reason = "checksum error in line 2";
+        return false;
+    }
+    if(!parseSatelliteNumber(line1, number1) || !parseSatelliteNumber(line2, number2)
+        || number1 != number2) {
+        reason = "satellite number mismatch";
+        return false;
+    }
+    tle.sat_number = number1;
+
+    /* Line 1 */
+    bool valid = parseColumns(line1, 19, 20, value);
+    tle.epoch_year = (int)value;
+    valid = valid && parseColumns(line1, 21, 32, value);
+    tle.epoch_doy = value;
+    valid = valid && parseColumns(line1, 34, 43, value);
+    tle.first_time = value;
+    valid = valid && parseImpliedDecimal(line1, 45, value);
+    tle.second_time = value;
+    /* sgp4Init divides the drag term by 1e5 (five mantissa digits). */
+    valid = valid && parseImpliedDecimal(line1, 54, value);
+    tle.bstar = value * 100000;
+    valid = valid && parseColumns(line1, 65, 68, value);
+    tle.tle_number = (int)value;
+
+    /* Line 2 */
+    valid = valid && parseColumns(line2, 9, 16, value);
+    tle.orbit_params.inclination = value;
+    valid = valid && parseColumns(line2, 18, 25, value);
+    tle.orbit_params.raan = value;
+    valid = valid && parseColumns(line2, 27, 33, value);
+    tle.orbit_params.eccentricity = value * 1.0e-7;
+    valid = valid && parseColumns(line2, 35, 42, value);
+    tle.orbit_params.arg_perigee = value;
+    valid = valid && parseColumns(line2, 44, 51, value);
+    tle.mean_anomaly = value;
+    valid = valid && parseColumns(line2, 53, 63, value);
+    tle.mean_motion = value;
+    valid = valid && parseColumns(line2, 64, 68, value);
+    tle.revolutions = (int)value;
+
+    if(!valid) {
+        reason = "malformed field";
+        return false;
+    }
+    if(tle.mean_motion <= 0) {
+        reason = "non-positive mean motion";
+        return false;
+    }
+
+    /* Semi-major axis from the mean motion, as used by the SGP4OrbitTrajectory constructors. */
+    double n = tle.mean_motion * 2.0 * Globals::constants.pi / 86400.0;
+    tle.orbit_params.semimajor_axis = std::cbrt(Globals::constants.earth_mu / (n * n));
+    return true;
+}
+
+std::string TLECatalogLoader::getRecordName(const char* line, std::size_t length)
+{
+    std::string name;
+
+    if(line != nullptr) {
+        name.assign(line, length);
+        name.erase(name.find_last_not_of(" \t\r") + 1);
+        if(name.compare(0, 2, "0 ") == 0) {
+            name.erase(0, 2);
+        }
+    }
+    return name;
+}
+
+std::vector<TLECatalogLoader::Record> TLECatalogLoader::splitRecords(
+    const char* data,
+    std::size_t size
+)
+{
+    std::vector<Record> records;
+    const char* pending_name = nullptr;
+    std::size_t pending_length = 0;
+    std::size_t pending_line = 0;
+    const char* line1 = nullptr;
+    std::size_t line1_length = 0;
+    std::size_t line_number = 0;
+    std::size_t offset = 0;
+
+    while(offset < size) {
+        const char* line = data + offset;
+        const char* newline = static_cast<const char*>(std::memchr(line, '\n', size - offset));
+        std::size_t length = newline ? newline - line : size - offset;
+        offset += length + 1;
+        line_number++;
+
+        if(length > 0 && line[length - 1] == '\r') {
+            length--;
+        }
+        if(length == 0) {
+            continue;
+        }
+
+        if(line[0] == '1' && length > 1 && line[1] == ' ') {
+            /* A first line after another one: the previous object has no second line. */
+            if(line1 != nullptr) {
+                m_failures.push_back(TLELoadFailure{pending_line,
+                    getRecordName(pending_name, pending_length), "missing line 2"});
+                pending_name = nullptr;
+            }
+            line1 = line;
+            line1_length = length;
+            if(pending_name == nullptr) {
+                pending_line = line_number;
+            }
+        } else if(line[0] == '2' && length > 1 && line[1] == ' ') {
+            if(line1 != nullptr) {
+                records.push_back(Record{pending_line, pending_name, pending_length,
+                    line1, line1_length, line, length});
+            } else {
+                m_failures.push_back(TLELoadFailure{pending_name ? pending_line : line_number,
+                    getRecordName(pending_name, pending_length), "orphan line 2"});
+            }
+            pending_name = nullptr;
+            line1 = nullptr;
+        } else {
+            /* A name line (3LE). A first line without its second line is discarded. */
+            if(line1 != nullptr) {
+                m_failures.push_back(TLELoadFailure{pending_line,
+                    getRecordName(pending_name, pending_length), "missing line 2"});
+                line1 = nullptr;
+            }
+            pending_name = line;
+            pending_length = length;
+            pending_line = line_number;
+        }
+    }
+    if(line1 != nullptr) {
+        m_failures.push_back(TLELoadFailure{pending_line,
+            getRecordName(pending_name, pending_length), "missing line 2"});
+    }
+    return records;
+}
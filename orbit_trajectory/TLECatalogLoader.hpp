@@ -0,0 +1,183 @@
+/***********************************************************************************************//**
+ *  Class that loads a whole TLE catalog and initialises SGP4 for every object
+ *  @class      TLECatalogLoader
+ *  @author     DSS-SIM development team, i2CAT
+ *  @date       2026-oct-16
+ *  @copyright  This code has been developed by Fundació Privada Internet i Innovació Digital a
+ *              Catalunya (i2CAT). i2CAT is a non-profit research and innovation centre that
+ *              promotes mission-driven knowledge to solve business challenges, co-create solutions
+ *              with a transformative impact, empower citizens through open and participative
+ *              digital social innovation with territorial capillarity, and promote pioneering and
+ *              strategic initiatives. i2CAT *aims to transfer* research project results to private
+ *              companies in order to create social and economic impact via the out-licensing of
+ *              intellectual property and the creation of spin-offs.
+ *              Find more information of i2CAT projects and IP rights at:
+ *              https://i2cat.net/tech-transfer/
+ **************************************************************************************************/
+
+#ifndef __TLE_CATALOG_LOADER_HPP__
+#define __TLE_CATALOG_LOADER_HPP__
+
+/* Global libraries */
+#include "dss.hpp"
+
+/* External Libraries */
+#include <memory>
+#include <string>
+#include <vector>
+#include "SGP4.h"
+
+/* Internal Libraries */
+#include "SGP4OrbitTrajectory.hpp"
+#include "SGP4BatchPropagator.hpp"
+#include "WorkStealingPool.hpp"
+
+/***********************************************************************************************//**
+ * Object of a catalog that could not be loaded.
+ **************************************************************************************************/
+struct TLELoadFailure
+{
+    std::size_t line;       /**< Line of the file where the object starts (starting at 1) */
+    std::string name;       /**< Name of the object, if the catalog provides it */
+    std::string reason;     /**< Reason of the failure */
+};
+
+/***********************************************************************************************//**
+ * Bulk loader of TLE catalogs in two-line (2LE) or three-line (3LE) format. The file is memory
+ * mapped and split in records sequentially, then the records are parsed, checksum-validated and
+ * initialised with SGP4 in parallel. Objects that fail are reported and skipped, so one malformed
+ * entry does not abort the whole catalog.
+ *
+ * TLE fields are stored with the same conventions that SGP4OrbitTrajectory::sgp4Init expects.
+ *
+ * @see     SGP4OrbitTrajectory
+ * @see     SGP4BatchPropagator
+ **************************************************************************************************/
+class TLECatalogLoader
+{
+public:
+    /*******************************************************************************************//**
+     * Constructs the loader.
+     *
+     * @param  threads      Number of worker threads (0 to use all the hardware threads)
+     * @param  constType    Sgp4 gravitational constants set type
+     * @param  opsMode      Mode of operation afspc or improved ('a' or 'i')
+     **********************************************************************************************/
+    TLECatalogLoader(unsigned int threads = 0, gravconsttype constType = wgs84, char opsMode = 'a');
+
+    /*******************************************************************************************//**
+     * Auto-generated destructor.
+     **********************************************************************************************/
+    ~TLECatalogLoader(void) = default;
+
+    /*******************************************************************************************//**
+     * Loads a catalog file, replacing any previously loaded catalog.
+     *
+     * @param  path     Path of the 2LE/3LE text file
+     * @return          False if the file cannot be opened, true otherwise (even if some objects
+     *                  failed; see getFailures)
+     **********************************************************************************************/
+    bool load(const std::string& path);
+
+    /*******************************************************************************************//**
+     * Loads a catalog from a text buffer, replacing any previously loaded catalog.
+     *
+     * @param  data     Catalog text
+     * @param  size     Size of the text (in bytes)
+     **********************************************************************************************/
+    void load(const char* data, std::size_t size);
+
+    /*******************************************************************************************//**
+     * Retrieves the number of objects loaded successfully.
+     **********************************************************************************************/
+    std::size_t size(void) const { return m_tles.size(); }
+
+    /*******************************************************************************************//**
+     * Retrieves the names of the loaded objects. For 2LE catalogs, the satellite number is used.
+     **********************************************************************************************/
+    const std::vector<std::string>& getNames(void) const { return m_names; }
+
+    /*******************************************************************************************//**
+     * Retrieves the parsed TLEs of the loaded objects.
+     **********************************************************************************************/
+    const std::vector<TLE>& getTLEs(void) const { return m_tles; }
+
+    /*******************************************************************************************//**
+     * Retrieves the initialised SGP4 element sets of the loaded objects.
+     **********************************************************************************************/
+    const std::vector<elsetrec>& getSatrecs(void) const { return m_satrecs; }
+
+    /*******************************************************************************************//**
+     * Retrieves the objects that could not be loaded, in catalog order.
+     **********************************************************************************************/
+    const std::vector<TLELoadFailure>& getFailures(void) const { return m_failures; }
+
+    /*******************************************************************************************//**
+     * Builds a batch propagator with all the loaded objects, in the same order as getNames.
+     **********************************************************************************************/
+    std::shared_ptr<SGP4BatchPropagator> createPropagator(void) const;
+
+    /*******************************************************************************************//**
+     * Verifies the modulo-10 checksum of a TLE line.
+     *
+     * @param  line     Line of at least 69 characters
+     * @return          True if the checksum in column 69 is correct
+     **********************************************************************************************/
+    static bool verifyChecksum(const char* line);
+
+    /*******************************************************************************************//**
+     * Parses the two lines of an element set.
+     *
+     * @param  line1    First line of the TLE (at least 69 characters)
+     * @param  line2    Second line of the TLE (at least 69 characters)
+     * @param  tle      Output TLE
+     * @param  reason   Reason of the failure, if any
+     * @return          True if both lines are valid
+     **********************************************************************************************/
+    static bool parseTLE(const char* line1, const char* line2, TLE& tle, std::string& reason);
+
+private:
+    /*******************************************************************************************//**
+     * Position of one object in the catalog text.
+     **********************************************************************************************/
+    struct Record
+    {
+        std::size_t line;           /**< Line of the file where the record starts */
+        const char* name;           /**< Start of the name line (null for 2LE records) */
+        std::size_t name_length;    /**< Length of the name line */
+        const char* line1;          /**< Start of the first TLE line */
+        std::size_t line1_length;   /**< Length of the first TLE line */
+        const char* line2;          /**< Start of the second TLE line */
+        std::size_t line2_length;   /**< Length of the second TLE line */
+    };
+
+    WorkStealingPool m_pool;                    /**< Worker threads */
+    gravconsttype m_const_type;                 /**< Sgp4 gravitational constants set type */
+    char m_ops_mode;                            /**< Mode of operation ('a' or 'i') */
+    std::vector<std::string> m_names;           /**< Names of the loaded objects */
+    std::vector<TLE> m_tles;                    /**< TLEs of the loaded objects */
+    std::vector<elsetrec> m_satrecs;            /**< Element sets of the loaded objects */
+    std::vector<TLELoadFailure> m_failures;     /**< Objects that could not be loaded */
+
+    /*******************************************************************************************//**
+     * Extracts the name of an object from its name line, without the trailing blanks and the "0 "
+     * prefix of some 3LE catalogs.
+     *
+     * @param  line     Start of the name line, or null if the object has none
+     * @param  length   Length of the name line
+     * @return          Name of the object, empty if it has none
+     **********************************************************************************************/
+    static std::string getRecordName(const char* line, std::size_t length);
+
+    /*******************************************************************************************//**
+     * Splits the catalog text in records. Second lines without a first one ("orphan line 2") and
+     * first lines without a second one ("missing line 2") are reported as failures.
+     *
+     * @param  data     Catalog text
+     * @param  size     Size of the text (in bytes)
+     * @return          Records of the catalog
+     **********************************************************************************************/
+    std::vector<Record> splitRecords(const char* data, std::size_t size);
+};
+
+#endif /* __TLE_CATALOG_LOADER_HPP__ */
@@ -0,0 +1,305 @@
+/***********************************************************************************************//**
+ *  Monte-Carlo ensembles of a TLE propagated in SIMD batches
+ *  @class      TLEEnsemble
+ *  @author     DSS-SIM development team, i2CAT
+ *  @date       2026-oct-16
+ *  @copyright  This code has been developed by Fundació Privada Internet i Innovació Digital a
+ *              Catalunya (i2CAT). i2CAT is a non-profit research and innovation centre that
+ *              promotes mission-driven knowledge to solve business challenges, co-create solutions
+ *              with a transformative impact, empower citizens through open and participative
+ *              digital social innovation with territorial capillarity, and promote pioneering and
+ *              strategic initiatives. i2CAT *aims to transfer* research project results to private
+ *              companies in order to create social and economic impact via the out-licensing of
+ *              intellectual property and the creation of spin-offs.
+ *              Find more information of i2CAT projects and IP rights at:
+ *              https://i2cat.net/tech-transfer/
+ **************************************************************************************************/
+
+#include "TLEEnsemble.hpp"
+#include "SGP4OrbitTrajectory.hpp"
+#include "TopocentricTransform.hpp"
+
+#include <algorithm>
+#include <random>
+
+#define ENSEMBLE_SECONDS_PER_UNIT   60.0    /**< Seconds per unit of propagation time (SGP4 uses
+                                                 minutes) */
+
+LOG_COMPONENT_DEFINE("TLEEnsemble");
+
+/* Standard normal sample by the Box-Muller transform. Unlike std::normal_distribution, the
+ * sequence only depends on the generator, so a seed gives the same ensemble on every platform. */
+static double gaussian(std::mt19937_64& generator)
+{
+    const double scale = 1.0 / 9007199254740992.0;  /* 2^-53 */
+    double u1 = ((generator() >> 11) + 1) * scale;  /* (0, 1] */
+    double u2 = (generator() >> 11) * scale;        /* [0, 1) */
+
+    return std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * Globals::constants.pi * u2);
+}
+
+TLEEnsemble::TLEEnsemble(
+    const TLE& tle,
+    const TLEUncertainty& uncertainty,
+    std::size_t members,
+    uint64_t seed,
+    gravconsttype constType,
+    char opsMode
+)
+    : m_percentiles({5.0, 50.0, 95.0})
+{
+    std::mt19937_64 generator(seed);
+    const double xpdotp = 1440.0 / (2.0 * Globals::constants.pi);
+    elsetrec nominal;
+
+    /* The epoch of the TLE is converted once and shared by all the members. */
+    if(!SGP4OrbitTrajectory::initSatrec(tle, constType, opsMode, nominal)) {
+        LOG_WARN("The nominal TLE could not be initialised; its states are not meaningful.");
+    }
+    m_jd_epoch = nominal.jdsatepoch + nominal.jdsatepochF;
+    m_satrecs.reserve(members + 1);
+    m_satrecs.push_back(nominal);
+
+    for(std::size_t i = 0; i < members; i++) {
+        elsetrec member = nominal;
+        double bstar = nominal.bstar * (1.0 + uncertainty.bstar * gaussian(generator));
+        double no_kozai = nominal.no_kozai + uncertainty.mean_motion * gaussian(generator) / xpdotp;
+        double delay = uncertainty.epoch * gaussian(generator) / ENSEMBLE_SECONDS_PER_UNIT;
+
+        /* Elements valid at a later epoch describe, at the nominal epoch, angles moved back along
+         * their secular rates. */
+        SGP4Funcs::sgp4init(constType, opsMode, nominal.satnum, m_jd_epoch - 2433281.5, bstar,
+            nominal.ndot, nominal.nddot, nominal.ecco, nominal.argpo - nominal.argpdot * delay,
+            nominal.inclo, nominal.mo - nominal.mdot * delay, no_kozai,
+            nominal.nodeo - nominal.nodedot * delay, member);
+        m_satrecs.push_back(member);
+    }
+
+    m_propagator.setReferenceEpoch(m_jd_epoch);
+    for(const elsetrec& satrec : m_satrecs) {
+        m_propagator.addSatellite(satrec);
+    }
+}
+
+EnsemblePositionStatistics TLEEnsemble::getPositionStatistics(double time) const
+{
+    EnsemblePositionStatistics statistics;
+    BatchStates states;
+    std::vector<double> radial, along_track, cross_track, distance;
+
+    m_propagator.propagate(time, states);
+    statistics.nominal = ECICoordinates(states.x[0], states.y[0], states.z[0]);
+    statistics.failed = 0;
+    if(states.error[0]) {
+        LOG_WARN("The nominal TLE could not be propagated; the offsets are not computed.");
+        statistics.failed = size();
+        return statistics;
+    }
+
+    /* Radial, along-track and cross-track unit vectors of the nominal orbit. */
+    double r[3] = {states.x[0], states.y[0], states.z[0]};
+    double v[3] = {states.vx[0], states.vy[0], states.vz[0]};
+    double h[3] = {r[1] * v[2] - r[2] * v[1], r[2] * v[0] - r[0] * v[2], r[0] * v[1] - r[1] * v[0]};
+    double r_norm = std::sqrt(r[0] * r[0] + r[1] * r[1] + r[2] * r[2]);
+    double h_norm = std::sqrt(h[0] * h[0] + h[1] * h[1] + h[2] * h[2]);
+    double u_r[3], u_c[3], u_a[3];
+
+    for(int c = 0; c < 3; c++) {
+        u_r[c] = r[c] / r_norm;
+        u_c[c] = h[c] / h_norm;
+    }
+    u_a[0] = u_c[1] * u_r[2] - u_c[2] * u_r[1];
+    u_a[1] = u_c[2] * u_r[0] - u_c[0] * u_r[2];
+    u_a[2] = u_c[0] * u_r[1] - u_c[1] * u_r[0];
+
+    for(std::size_t i = 1; i < states.size(); i++) {
+        if(states.error[i]) {
+            statistics.failed++;
+            continue;
+        }
+        double d[3] = {states.x[i] - r[0], states.y[i] - r[1], states.z[i] - r[2]};
+        radial.push_back(d[0] * u_r[0] + d[1] * u_r[1] + d[2] * u_r[2]);
+        along_track.push_back(d[0] * u_a[0] + d[1] * u_a[1] + d[2] * u_a[2]);
+        cross_track.push_back(d[0] * u_c[0] + d[1] * u_c[1] + d[2] * u_c[2]);
+        distance.push_back(std::sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]));
+    }
+
+    statistics.radial = percentiles(radial);
+    statistics.along_track = percentiles(along_track);
+    statistics.cross_track = percentiles(cross_track);
+    statistics.distance = percentiles(distance);
+    return statistics;
+}
+
+std::vector<EnsembleContactStatistics> TLEEnsemble::getContactStatistics(
+    const GroundStation& station,
+    double start,
+    double end,
+    double min_elevation,
+    double coarse_step,
+    double tolerance
+) const
+{
+    std::vector<EnsembleContactStatistics> statistics;
+    std::size_t count = m_satrecs.size();
+    double mask = min_elevation * Globals::constants.pi / 180.0;
+
+    if(end <= start || coarse_step <= 0) {
+        LOG_WARN("Empty interval or invalid step; no contacts are computed.");
+        return statistics;
+    }
+
+    /* Sampling of all the members at each step of the grid, in the lanes of the propagator. */
+    TopocentricTransform transform(m_jd_epoch);
+    BatchStates states;
+    std::vector<elsetrec> satrecs(m_satrecs);
+    std::vector<double> previous(count);
+    std::vector<double> rise(count, start);
+    std::vector<std::vector<Contact>> contacts(count);
+    std::size_t steps = (std::size_t)std::ceil((end - start) / coarse_step);
+    double t0 = start;
+
+    transform.addGroundStation(station);
+    for(std::size_t k = 0; k <= steps; k++) {
+        double t1 = std::min(start + k * coarse_step, end);
+
+        m_propagator.propagate(t1, states);
+        transform.update(t1, states);
+        for(std::size_t i = 0; i < count; i++) {
+            double f1 = states.error[i] ? -1 : transform.getElevation(0, i) - mask;
+            double f0 = previous[i];
+
+            if(k > 0 && (f0 > 0) != (f1 > 0)) {
+                double crossing = refine(satrecs[i], station, t0, f0, t1, mask, tolerance);
+                if(f1 > 0) {
+                    rise[i] = crossing;
+                } else {
+                    contacts[i].push_back(Contact{i, 0, true, rise[i], crossing});
+                }
+            }
+            previous[i] = f1;
+        }
+        t0 = t1;
+    }
+    for(std::size_t i = 0; i < count; i++) {
+        if(previous[i] > 0) {
+            contacts[i].push_back(Contact{i, 0, true, rise[i], end});
+        }
+    }
+
+    /* Assignment of the member contacts to the nominal ones. */
+    const std::vector<Contact>& nominal = contacts[0];
+    std::vector<std::vector<double>> starts(nominal.size());
+    std::vector<std::vector<double>> ends(nominal.size());
+
+    for(std::size_t i = 1; i < count; i++) {
+        std::vector<const Contact*> assigned(nominal.size(), nullptr);
+        std::vector<double> overlaps(nominal.size(), 0.0);
+
+        for(const Contact& contact : contacts[i]) {
+            std::size_t best = nominal.size();
+            double best_overlap = 0;
+            for(std::size_t n = 0; n < nominal.size(); n++) {
+                double overlap = std::min(contact.end, nominal[n].end)
+                    - std::max(contact.start, nominal[n].start);
+                if(overlap > best_overlap) {
+                    best = n;
+                    best_overlap = overlap;
+                }
+            }
+            if(best < nominal.size() && best_overlap > overlaps[best]) {
+                assigned[best] = &contact;
+                overlaps[best] = best_overlap;
+            }
+        }
+        for(std::size_t n = 0; n < nominal.size(); n++) {
+            if(assigned[n]) {
+                starts[n].push_back(assigned[n]->start);
+                ends[n].push_back(assigned[n]->end);
+            }
+        }
+    }
+
+    for(std::size_t n = 0; n < nominal.size(); n++) {
+        EnsembleContactStatistics contact;
+        contact.nominal_start = nominal[n].start;
+        contact.nominal_end = nominal[n].end;
+        contact.probability = size() ? (double)starts[n].size() / size() : 0.0;
+        contact.start = percentiles(starts[n]);
+        contact.end = percentiles(ends[n]);
+        statistics.push_back(contact);
+    }
+    return statistics;
+}
+
+double TLEEnsemble::percentile(std::vector<double>& values, double percentile)
+{
+    if(values.empty()) {
+        return 0.0;
+    }
+    std::sort(values.begin(), values.end());
+
+    double rank = std::min(std::max(percentile, 0.0), 100.0) / 100.0 * (values.size() - 1);
+    std::size_t below = (std::size_t)rank;
+    std::size_t above = std::min(below + 1, values.size() - 1);
+    double weight = rank - below;
+
+    return values[below] + weight * (values[above] - values[below]);
+}
+
+std::vector<double> TLEEnsemble::percentiles(std::vector<double>& values) const
+{
+    std::vector<double> result;
+
+    for(double p : m_percentiles) {
+        result.push_back(percentile(values, p));
+    }
+    return result;
+}
+
+double TLEEnsemble::elevation(
+    elsetrec& satrec,
+    const GroundStation& station,
+    double time,
+    double min_elevation
+) const
+{
+    double r[3], v[3];
+    ECICoordinates up;
+
+    if(!SGP4Funcs::sgp4(satrec, time, r, v)) {
+        return -1;
+    }
+
+    double gmst = SGP4Funcs::gstime(m_jd_epoch + time * CONTACT_TIME_UNIT_DAYS);
+    ECICoordinates position = ContactPlanner::groundStationToECI(station, gmst, up);
+    double dx = r[0] - position.x;
+    double dy = r[1] - position.y;
+    double dz = r[2] - position.z;
+    double range = std::sqrt(dx * dx + dy * dy + dz * dz);
+
+    return std::asin((dx * up.x + dy * up.y + dz * up.z) / range) - min_elevation;
+}
+
+double TLEEnsemble::refine(
+    elsetrec& satrec,
+    const GroundStation& station,
+    double t0,
+    double f0,
+    double t1,
+    double min_elevation,
+    double tolerance
+) const
+{
+    while(t1 - t0 > tolerance) {
+        double middle = 0.5 * (t0 + t1);
+        double f = elevation(satrec, station, middle, min_elevation);
+        if((f > 0) == (f0 > 0)) {
+            t0 = middle;
+            f0 = f;
+        } else {
+            t1 = middle;
+        }
+    }
+    return 0.5 * (t0 + t1);
+}
@@ -0,0 +1,196 @@
+/***********************************************************************************************//**
+ *  Monte-Carlo ensembles of a TLE propagated in SIMD batches
+ *  @class      TLEEnsemble
+ *  @author     DSS-SIM development team, i2CAT
+ *  @date       2026-oct-16
+ *  @copyright  This code has been developed by Fundació Privada Internet i Innovació Digital a
+ *              Catalunya (i2CAT). i2CAT is a non-profit research and innovation centre that
+ *              promotes mission-driven knowledge to solve business challenges, co-create solutions
+ *              with a transformative impact, empower citizens through open and participative
+ *              digital social innovation with territorial capillarity, and promote pioneering and
+ *              strategic initiatives. i2CAT *aims to transfer* research project results to private
+ *              companies in order to create social and economic impact via the out-licensing of
+ *              intellectual property and the creation of spin-offs.
+ *              Find more information of i2CAT projects and IP rights at:
+ *              https://i2cat.net/tech-transfer/
+ **************************************************************************************************/
+
+#ifndef __TLE_ENSEMBLE_HPP__
+#define __TLE_ENSEMBLE_HPP__
+
+/* Global libraries */
+#include "dss.hpp"
+
+/* External Libraries */
+#include <vector>
+#include "SGP4.h"
+
+/* Internal Libraries */
+#include "ContactPlanner.hpp"
+#include "ECICoordinates.hpp"
+#include "SGP4BatchPropagator.hpp"
+
+/***********************************************************************************************//**
+ * Standard deviations of the TLE errors sampled by the ensemble.
+ **************************************************************************************************/
+struct TLEUncertainty
+{
+    double bstar;           /**< Relative error of the drag term (e.g. 0.2 for 20%) */
+    double mean_motion;     /**< Error of the mean motion (rev/day) */
+    double epoch;           /**< Error of the epoch (s) */
+};
+
+/***********************************************************************************************//**
+ * Percentiles of the position of the ensemble members with respect to the nominal TLE, in the
+ * radial, along-track and cross-track frame of the nominal orbit.
+ **************************************************************************************************/
+struct EnsemblePositionStatistics
+{
+    ECICoordinates nominal;             /**< Position of the nominal TLE (km) */
+    std::vector<double> radial;         /**< Percentiles of the radial offset (km) */
+    std::vector<double> along_track;    /**< Percentiles of the along-track offset (km) */
+    std::vector<double> cross_track;    /**< Percentiles of the cross-track offset (km) */
+    std::vector<double> distance;       /**< Percentiles of the distance to the nominal (km) */
+    std::size_t failed;                 /**< Members with an SGP4 error, not included */
+};
+
+/***********************************************************************************************//**
+ * Percentiles of the start and end times of a contact of the nominal TLE, over the members that
+ * have an overlapping contact.
+ **************************************************************************************************/
+struct EnsembleContactStatistics
+{
+    double nominal_start;           /**< Start of the nominal contact */
+    double nominal_end;             /**< End of the nominal contact */
+    double probability;             /**< Fraction of the members with an overlapping contact */
+    std::vector<double> start;      /**< Percentiles of the start time */
+    std::vector<double> end;        /**< Percentiles of the end time */
+};
+
+/***********************************************************************************************//**
+ * Ensemble of perturbed copies of a TLE. The drag term, the mean motion and the epoch are drawn
+ * from normal distributions with a reproducible generator (a 64-bit Mersenne Twister with a
+ * Box-Muller transform, which gives the same samples on every platform).
+ *
+ * The TLE epoch is converted only once: all the members keep the nominal epoch, and an epoch
+ * error is applied as the equivalent shift of the mean anomaly, the argument of perigee and the
+ * right ascension along their secular rates. All the members then share the same time since
+ * epoch and are propagated together in the vectorised lanes of an SGP4BatchPropagator, whose
+ * first satellite is the nominal TLE.
+ *
+ * The results are percentiles (by default the 5th, 50th and 95th) instead of raw samples. Times
+ * have the same meaning as in sgp4Propagate, with time 0 at the TLE epoch.
+ *
+ * @see     SGP4BatchPropagator
+ * @see     ContactPlanner
+ **************************************************************************************************/
+class TLEEnsemble
+{
+public:
+    /*******************************************************************************************//**
+     * Builds the ensemble.
+     *
+     * @param  tle          Nominal TLE
+     * @param  uncertainty  Standard deviations of the TLE errors
+     * @param  members      Number of perturbed members
+     * @param  seed         Seed of the random generator
+     * @param  constType    SGP4 gravitational constants set type
+     * @param  opsMode      Mode of operation afspc or improved ('a' or 'i')
+     **********************************************************************************************/
+    TLEEnsemble(
+        const TLE& tle,
+        const TLEUncertainty& uncertainty,
+        std::size_t members,
+        uint64_t seed,
+        gravconsttype constType = wgs84,
+        char opsMode = 'i'
+    );
+
+    /*******************************************************************************************//**
+     * Auto-generated destructor.
+     **********************************************************************************************/
+    ~TLEEnsemble(void) = default;
+
+    /*******************************************************************************************//**
+     * Retrieves the number of perturbed members.
+     **********************************************************************************************/
+    std::size_t size(void) const { return m_satrecs.size() - 1; }
+
+    /*******************************************************************************************//**
+     * Sets the percentiles reported by the statistics.
+     *
+     * @param  percentiles  Percentiles, between 0 and 100
+     **********************************************************************************************/
+    void setPercentiles(const std::vector<double>& percentiles) { m_percentiles = percentiles; }
+
+    /*******************************************************************************************//**
+     * Retrieves the batch propagator of the ensemble. Satellite 0 is the nominal TLE and
+     * satellite i is the i-th member.
+     **********************************************************************************************/
+    const SGP4BatchPropagator& getPropagator(void) const { return m_propagator; }
+
+    /*******************************************************************************************//**
+     * Computes the percentiles of the position offsets of the members at a time.
+     *
+     * @param  time     Propagation time, with the same meaning as in sgp4Propagate
+     * @return          Position statistics
+     **********************************************************************************************/
+    EnsemblePositionStatistics getPositionStatistics(double time) const;
+
+    /*******************************************************************************************//**
+     * Computes the percentiles of the start and end times of the contacts with a ground station.
+     * The elevation of all the members is sampled together on a coarse grid and every rise and
+     * set time is refined by bisection, as in ContactPlanner. A member contact is assigned to the
+     * nominal contact that it overlaps the most.
+     *
+     * @param  station          Ground station
+     * @param  start            Start of the interval
+     * @param  end              End of the interval
+     * @param  min_elevation    Elevation mask (deg)
+     * @param  coarse_step      Step of the bracketing grid
+     * @param  tolerance        Accuracy of the rise and set times
+     * @return                  Statistics of each contact of the nominal TLE, by start time
+     **********************************************************************************************/
+    std::vector<EnsembleContactStatistics> getContactStatistics(
+        const GroundStation& station,
+        double start,
+        double end,
+        double min_elevation = CONTACT_MIN_ELEVATION,
+        double coarse_step = 1.0,
+        double tolerance = 1.0e-4
+    ) const;
+
+    /*******************************************************************************************//**
+     * Computes a percentile of a set of values, interpolating between the closest ranks.
+     *
+     * @param  values       Values, which are sorted by the method
+     * @param  percentile   Percentile, between 0 and 100
+     * @return              Value of the percentile (0 if there are no values)
+     **********************************************************************************************/
+    static double percentile(std::vector<double>& values, double percentile);
+
+private:
+    std::vector<elsetrec> m_satrecs;    /**< Nominal element set followed by the members */
+    SGP4BatchPropagator m_propagator;   /**< Batch propagator of m_satrecs */
+    double m_jd_epoch;                  /**< Julian date of the nominal epoch */
+    std::vector<double> m_percentiles;  /**< Reported percentiles */
+
+    /*******************************************************************************************//**
+     * Computes the percentiles of a set of values.
+     **********************************************************************************************/
+    std::vector<double> percentiles(std::vector<double>& values) const;
+
+    /*******************************************************************************************//**
+     * Computes the elevation of an element set over a ground station minus the mask (rad).
+     **********************************************************************************************/
+    double elevation(elsetrec& satrec, const GroundStation& station, double time,
+        double min_elevation) const;
+
+    /*******************************************************************************************//**
+     * Refines a crossing of the elevation mask by bisection.
+     **********************************************************************************************/
+    double refine(elsetrec& satrec, const GroundStation& station, double t0, double f0,
+        double t1, double min_elevation, double tolerance) const;
+};
+
+#endif /* __TLE_ENSEMBLE_HPP__ */
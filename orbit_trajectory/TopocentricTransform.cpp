@@ -0,0 +1,150 @@
+/***********************************************************************************************//**
+ *  Batched transformation of constellation states to Earth-fixed and topocentric coordinates
+ *  @class      TopocentricTransform
+ *  @author     DSS-SIM development team, i2CAT
+ *  @date       2026-oct-16
+ *  @copyright  This code has been developed by Fundació Privada Internet i Innovació Digital a
+ *              Catalunya (i2CAT). i2CAT is a non-profit research and innovation centre that
+ *              promotes mission-driven knowledge to solve business challenges, co-create solutions
+ *              with a transformative impact, empower citizens through open and participative
+ *              digital social innovation with territorial capillarity, and promote pioneering and
+ *              strategic initiatives. i2CAT *aims to transfer* research project results to private
+ *              companies in order to create social and economic impact via the out-licensing of
+ *              intellectual property and the creation of spin-offs.
+ *              Find more information of i2CAT projects and IP rights at:
+ *              https://i2cat.net/tech-transfer/
+ **************************************************************************************************/
+
+#include "TopocentricTransform.hpp"
+
+LOG_COMPONENT_DEFINE("TopocentricTransform");
+
+TopocentricTransform::TopocentricTransform(double jd_start)
+    : m_jd_start(jd_start)
+    , m_time(0)
+    , m_gmst(0)
+{ }
+
+std::size_t TopocentricTransform::addGroundStation(const GroundStation& station)
+{
+    Station frame;
+    ECICoordinates up;
+
+    /* With GMST = 0 the ECI and ECEF axes coincide. */
+    ECICoordinates position = ContactPlanner::groundStationToECI(station, 0.0, up);
+    double lat = station.latitude * Globals::constants.pi / 180.0;
+    double lon = station.longitude * Globals::constants.pi / 180.0;
+
+    frame.position[0] = position.x;
+    frame.position[1] = position.y;
+    frame.position[2] = position.z;
+    frame.east[0] = -std::sin(lon);
+    frame.east[1] = std::cos(lon);
+    frame.east[2] = 0.0;
+    frame.north[0] = -std::sin(lat) * std::cos(lon);
+    frame.north[1] = -std::sin(lat) * std::sin(lon);
+    frame.north[2] = std::cos(lat);
+    frame.up[0] = up.x;
+    frame.up[1] = up.y;
+    frame.up[2] = up.z;
+
+    m_stations.push_back(frame);
+    m_topocentric.emplace_back();
+    return m_stations.size() - 1;
+}
+
+void TopocentricTransform::update(double time, const BatchStates& states)
+{
+    std::size_t count = states.size();
+
+    m_time = time;
+    m_gmst = SGP4Funcs::gstime(m_jd_start + time * CONTACT_TIME_UNIT_DAYS);
+    m_earth_fixed.x.resize(count);
+    m_earth_fixed.y.resize(count);
+    m_earth_fixed.z.resize(count);
+
+    /* Rotation about the Z axis by GMST, shared by all the satellites of the step. */
+    double c = std::cos(m_gmst);
+    double s = std::sin(m_gmst);
+    const double* eci_x = states.x.data();
+    const double* eci_y = states.y.data();
+    const double* eci_z = states.z.data();
+    double* x = m_earth_fixed.x.data();
+    double* y = m_earth_fixed.y.data();
+    double* z = m_earth_fixed.z.data();
+    for(std::size_t i = 0; i < count; i++) {
+        x[i] = c * eci_x[i] + s * eci_y[i];
+        y[i] = -s * eci_x[i] + c * eci_y[i];
+        z[i] = eci_z[i];
+    }
+
+    computeGeodetic();
+    for(std::size_t j = 0; j < m_stations.size(); j++) {
+        computeTopocentric(m_stations[j], m_topocentric[j]);
+    }
+}
+
+void TopocentricTransform::computeGeodetic(void)
+{
+    std::size_t count = m_earth_fixed.x.size();
+    const double a = CONTACT_WGS84_RADIUS;
+    const double b = a * (1.0 - CONTACT_WGS84_FLATTENING);
+    const double e2 = CONTACT_WGS84_FLATTENING * (2.0 - CONTACT_WGS84_FLATTENING);
+    const double ep2 = e2 / (1.0 - e2);
+
+    m_earth_fixed.latitude.resize(count);
+    m_earth_fixed.longitude.resize(count);
+    m_earth_fixed.altitude.resize(count);
+
+    const double* x = m_earth_fixed.x.data();
+    const double* y = m_earth_fixed.y.data();
+    const double* z = m_earth_fixed.z.data();
+    double* latitude = m_earth_fixed.latitude.data();
+    double* longitude = m_earth_fixed.longitude.data();
+    double* altitude = m_earth_fixed.altitude.data();
+    for(std::size_t i = 0; i < count; i++) {
+        double p = std::sqrt(x[i] * x[i] + y[i] * y[i]);
+        double theta = std::atan2(z[i] * a, p * b);
+        double sin_theta = std::sin(theta);
+        double cos_theta = std::cos(theta);
+        double lat = std::atan2(z[i] + ep2 * b * sin_theta * sin_theta * sin_theta,
+            p - e2 * a * cos_theta * cos_theta * cos_theta);
+        double sin_lat = std::sin(lat);
+
+        latitude[i] = lat;
+        longitude[i] = std::atan2(y[i], x[i]);
+        altitude[i] = p * std::cos(lat) + z[i] * sin_lat
+            - a * std::sqrt(1.0 - e2 * sin_lat * sin_lat);
+    }
+}
+
+void TopocentricTransform::computeTopocentric(const Station& station, TopocentricStates& result)
+{
+    std::size_t count = m_earth_fixed.x.size();
+    const double twopi = 2.0 * Globals::constants.pi;
+
+    result.azimuth.resize(count);
+    result.elevation.resize(count);
+    result.range.resize(count);
+
+    const double* x = m_earth_fixed.x.data();
+    const double* y = m_earth_fixed.y.data();
+    const double* z = m_earth_fixed.z.data();
+    double* azimuth = result.azimuth.data();
+    double* elevation = result.elevation.data();
+    double* range = result.range.data();
+    for(std::size_t i = 0; i < count; i++) {
+        double dx = x[i] - station.position[0];
+        double dy = y[i] - station.position[1];
+        double dz = z[i] - station.position[2];
+        double east = dx * station.east[0] + dy * station.east[1];
+        double north = dx * station.north[0] + dy * station.north[1] + dz * station.north[2];
+        double up = dx * station.up[0] + dy * station.up[1] + dz * station.up[2];
+        double distance = std::sqrt(dx * dx + dy * dy + dz * dz);
+        double az = std::atan2(east, north);
+
+        azimuth[i] = az < 0 ? az + twopi : az;
+        elevation[i] = std::asin(up / distance);
+        range[i] = distance;
+    }
+}
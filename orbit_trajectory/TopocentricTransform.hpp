@@ -0,0 +1,181 @@
+/***********************************************************************************************//**
+ *  Batched transformation of constellation states to Earth-fixed and topocentric coordinates
+ *  @class      TopocentricTransform
+ *  @author     DSS-SIM development team, i2CAT
+ *  @date       2026-oct-16
+ *  @copyright  This code has been developed by Fundació Privada Internet i Innovació Digital a
+ *              Catalunya (i2CAT). i2CAT is a non-profit research and innovation centre that
+ *              promotes mission-driven knowledge to solve business challenges, co-create solutions
+ *              with a transformative impact, empower citizens through open and participative
+ *              digital social innovation with territorial capillarity, and promote pioneering and
+ *              strategic initiatives. i2CAT *aims to transfer* research project results to private
+ *              companies in order to create social and economic impact via the out-licensing of
+ *              intellectual property and the creation of spin-offs.
+ *              Find more information of i2CAT projects and IP rights at:
+ *              https://i2cat.net/tech-transfer/
+ **************************************************************************************************/
+
+#ifndef __TOPOCENTRIC_TRANSFORM_HPP__
+#define __TOPOCENTRIC_TRANSFORM_HPP__
+
+/* Global libraries */
+#include "dss.hpp"
+
+/* External Libraries */
+#include <vector>
+
+/* Internal Libraries */
+#include "ContactPlanner.hpp"
+#include "SGP4BatchPropagator.hpp"
+
+/***********************************************************************************************//**
+ * Earth-fixed coordinates of a constellation in structure-of-arrays layout. The i-th element of
+ * each array belongs to the i-th satellite of the transformed BatchStates.
+ **************************************************************************************************/
+struct EarthFixedStates
+{
+    std::vector<double> x;          /**< Position along the ECEF X axis (km) */
+    std::vector<double> y;          /**< Position along the ECEF Y axis (km) */
+    std::vector<double> z;          /**< Position along the ECEF Z axis (km) */
+    std::vector<double> latitude;   /**< Geodetic latitude (rad) */
+    std::vector<double> longitude;  /**< Longitude, positive to the East, in [-pi, pi] (rad) */
+    std::vector<double> altitude;   /**< Altitude over the WGS84 ellipsoid (km) */
+};
+
+/***********************************************************************************************//**
+ * Look angles of a constellation from one ground station, in structure-of-arrays layout. The i-th
+ * element of each array belongs to the i-th satellite of the transformed BatchStates.
+ **************************************************************************************************/
+struct TopocentricStates
+{
+    std::vector<double> azimuth;    /**< Azimuth from the North towards the East, in [0, 2pi) */
+    std::vector<double> elevation;  /**< Elevation over the local horizon (rad) */
+    std::vector<double> range;      /**< Distance from the station (km) */
+};
+
+/***********************************************************************************************//**
+ * Transformation stage from the ECI states of a constellation to ECEF, geodetic and, for every
+ * ground station, azimuth/elevation/range arrays. The Earth rotation (GMST and its sine and
+ * cosine) is computed once per time step, and the local frame of each station is constant in
+ * ECEF, so it is computed once when the station is added. Each step then reduces to plain loops
+ * over the arrays, which the compiler can vectorise.
+ *
+ * The elevation is measured from the ellipsoid normal at the station. Consumers such as Clouds or
+ * the channel can read the arrays directly instead of recomputing the geometry link by link.
+ *
+ * @see     SGP4BatchPropagator
+ * @see     ContactPlanner
+ **************************************************************************************************/
+class TopocentricTransform
+{
+public:
+    /*******************************************************************************************//**
+     * Constructs the transform.
+     *
+     * @param  jd_start     Julian date (UT1) at propagation time 0, used to rotate the Earth
+     **********************************************************************************************/
+    TopocentricTransform(double jd_start);
+
+    /*******************************************************************************************//**
+     * Auto-generated destructor.
+     **********************************************************************************************/
+    ~TopocentricTransform(void) = default;
+
+    /*******************************************************************************************//**
+     * Adds a ground station, whose look angles are computed from the next update on.
+     *
+     * @param  station  Ground station
+     * @return          Index of the station
+     **********************************************************************************************/
+    std::size_t addGroundStation(const GroundStation& station);
+
+    /*******************************************************************************************//**
+     * Retrieves the number of ground stations.
+     **********************************************************************************************/
+    std::size_t getStationCount(void) const { return m_stations.size(); }
+
+    /*******************************************************************************************//**
+     * Transforms the states of a constellation at a time step. The values of satellites with an
+     * SGP4 error (see BatchStates::error) are not meaningful.
+     *
+     * The states shall come from a batch propagator whose reference epoch is the jd_start of the
+     * transform (see SGP4BatchPropagator::setReferenceEpoch), so that they are all at this time.
+     *
+     * @param  time     Propagation time of the states, from jd_start (in min)
+     * @param  states   ECI states of the constellation
+     **********************************************************************************************/
+    void update(double time, const BatchStates& states);
+
+    /*******************************************************************************************//**
+     * Retrieves the propagation time of the last update.
+     **********************************************************************************************/
+    double getTime(void) const { return m_time; }
+
+    /*******************************************************************************************//**
+     * Retrieves the Greenwich mean sidereal time of the last update (rad).
+     **********************************************************************************************/
+    double getGMST(void) const { return m_gmst; }
+
+    /*******************************************************************************************//**
+     * Retrieves the number of satellites of the last update.
+     **********************************************************************************************/
+    std::size_t getSatelliteCount(void) const { return m_earth_fixed.x.size(); }
+
+    /*******************************************************************************************//**
+     * Retrieves the Earth-fixed coordinates of the last update.
+     **********************************************************************************************/
+    const EarthFixedStates& getEarthFixed(void) const { return m_earth_fixed; }
+
+    /*******************************************************************************************//**
+     * Retrieves the look angles of the last update from a ground station.
+     *
+     * @param  station  Index of the ground station
+     **********************************************************************************************/
+    const TopocentricStates& getTopocentric(std::size_t station) const
+    {
+        return m_topocentric[station];
+    }
+
+    /*******************************************************************************************//**
+     * Retrieves the elevation of a satellite from a ground station at the last update (rad).
+     *
+     * @param  station      Index of the ground station
+     * @param  satellite    Index of the satellite
+     **********************************************************************************************/
+    double getElevation(std::size_t station, std::size_t satellite) const
+    {
+        return m_topocentric[station].elevation[satellite];
+    }
+
+private:
+    /*******************************************************************************************//**
+     * Ground station with its position and local frame in ECEF.
+     **********************************************************************************************/
+    struct Station
+    {
+        double position[3];     /**< ECEF position (km) */
+        double east[3];         /**< Unit vector towards the East */
+        double north[3];        /**< Unit vector towards the North */
+        double up[3];           /**< Unit vector normal to the ellipsoid */
+    };
+
+    double m_jd_start;                              /**< Julian date at propagation time 0 */
+    double m_time;                                  /**< Propagation time of the last update */
+    double m_gmst;                                  /**< GMST of the last update (rad) */
+    std::vector<Station> m_stations;                /**< Ground stations */
+    EarthFixedStates m_earth_fixed;                 /**< Earth-fixed states of the last update */
+    std::vector<TopocentricStates> m_topocentric;   /**< Look angles per ground station */
+
+    /*******************************************************************************************//**
+     * Computes the geodetic coordinates of the Earth-fixed positions with one step of Bowring's
+     * method, which is accurate to the metre level for LEO altitudes.
+     **********************************************************************************************/
+    void computeGeodetic(void);
+
+    /*******************************************************************************************//**
+     * Computes the look angles of the Earth-fixed positions from a ground station.
+     **********************************************************************************************/
+    void computeTopocentric(const Station& station, TopocentricStates& result);
+};
+
+#endif /* __TOPOCENTRIC_TRANSFORM_HPP__ */
@@ -0,0 +1,589 @@
+/***********************************************************************************************//**
+ *  Compressed columnar recorder of satellite trajectories
+ *  @class      TrajectoryRecorder
+ *  @author     DSS-SIM development team, i2CAT
+ *  @date       2026-oct-16
+ *  @copyright  This code has been developed by Fundació Privada Internet i Innovació Digital a
+ *              Catalunya (i2CAT). i2CAT is a non-profit research and innovation centre that
+ *              promotes mission-driven knowledge to solve business challenges, co-create solutions
+ *              with a transformative impact, empower citizens through open and participative
+ *              digital social innovation with territorial capillarity, and promote pioneering and
+ *              strategic initiatives. i2CAT *aims to transfer* research project results to private
+ *              companies in order to create social and economic impact via the out-licensing of
+ *              intellectual property and the creation of spin-offs.
+ *              Find more information of i2CAT projects and IP rights at:
+ *              https://i2cat.net/tech-transfer/
+ **************************************************************************************************/
+
+#include "TrajectoryRecorder.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+LOG_COMPONENT_DEFINE("TrajectoryRecorder");
+
+#define TRAJECTORY_RECORD_ENDIAN_TAG    0x01020304  /**< Detects files of other endianness */
+
+/* Header at the beginning of the file. */
+struct TrajectoryFileHeader
+{
+    char magic[8];              /* TRAJECTORY_RECORD_MAGIC, without null terminator */
+    uint32_t version;           /* TRAJECTORY_RECORD_VERSION */
+    uint32_t endian_tag;        /* TRAJECTORY_RECORD_ENDIAN_TAG */
+    uint8_t reserved[16];       /* Reserved for future versions (zero) */
+};
+
+/* Footer at the end of a closed file, after the block index. */
+struct TrajectoryFileFooter
+{
+    uint64_t index_offset;      /* Offset of the block index (bytes) */
+    uint64_t block_count;       /* Number of entries of the block index */
+    char magic[8];              /* TRAJECTORY_RECORD_MAGIC, without null terminator */
+};
+
+static_assert(sizeof(TrajectoryFileHeader) == 32, "Unexpected trajectory file header size");
+static_assert(sizeof(TrajectoryFileFooter) == 24, "Unexpected trajectory file footer size");
+static_assert(sizeof(TrajectoryBlockHeader) == 56, "Unexpected trajectory block header size");
+static_assert(sizeof(TrajectoryBlockIndex) == 32, "Unexpected trajectory block index size");
+
+/* Appends values of up to 64 bits to a byte stream, most significant bit first. */
+class BitWriter
+{
+public:
+    BitWriter(std::vector<uint8_t>& bytes) : m_bytes(bytes), m_used(0) { }
+
+    void write(uint64_t value, int bits)
+    {
+        while(bits > 0) {
+            if(m_used == 0) {
+                m_bytes.push_back(0);
+            }
+            int room = 8 - m_used;
+            int take = std::min(room, bits);
+            uint8_t chunk = (value >> (bits - take)) & ((1u << take) - 1);
+            m_bytes.back() |= chunk << (room - take);
+            m_used = (m_used + take) % 8;
+            bits -= take;
+        }
+    }
+
+private:
+    std::vector<uint8_t>& m_bytes;
+    int m_used;
+};
+
+/* Reads the values written by BitWriter. Reads past the end return zeros. */
+class BitReader
+{
+public:
+    BitReader(const uint8_t* data, std::size_t size) : m_data(data), m_size(size), m_pos(0),
+        m_used(0) { }
+
+    uint64_t read(int bits)
+    {
+        uint64_t value = 0;
+        while(bits > 0) {
+            int room = 8 - m_used;
+            int take = std::min(room, bits);
+            uint8_t byte = m_pos < m_size ? m_data[m_pos] : 0;
+            value = (value << take) | ((byte >> (room - take)) & ((1u << take) - 1));
+            m_used += take;
+            if(m_used == 8) {
+                m_used = 0;
+                m_pos++;
+            }
+            bits -= take;
+        }
+        return value;
+    }
+
+private:
+    const uint8_t* m_data;
+    std::size_t m_size;
+    std::size_t m_pos;
+    int m_used;
+};
+
+/* Quadratic extrapolation of the three previous values (linear or constant for the first ones),
+ * shared by the encoder and the decoder. */
+static double predict(const double* values, std::size_t i)
+{
+    if(i == 0) {
+        return 0.0;
+    }
+    if(i == 1) {
+        return values[0];
+    }
+    if(i == 2) {
+        return 2.0 * values[1] - values[0];
+    }
+    return 3.0 * (values[i - 1] - values[i - 2]) + values[i - 3];
+}
+
+static uint64_t toBits(double value)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+static double fromBits(uint64_t bits)
+{
+    double value;
+    std::memcpy(&value, &bits, sizeof(value));
+    return value;
+}
+
+/* Gorilla encoding of the XOR between each value and its prediction: '0' if equal, '10' and the
+ * meaningful bits in the previous window, or '11', the leading zeros (6 bits), the length minus
+ * one (6 bits) and the meaningful bits. The previous window is only reused when it fits and is
+ * cheaper, so a single outlier does not widen the following values. */
+static void encodeColumn(const std::vector<double>& values, std::vector<uint8_t>& bytes)
+{
+    BitWriter writer(bytes);
+    int prev_lead = -1;
+    int prev_trail = 0;
+
+    for(std::size_t i = 0; i < values.size(); i++) {
+        uint64_t x = toBits(values[i]) ^ toBits(predict(values.data(), i));
+        if(x == 0) {
+            writer.write(0, 1);
+            continue;
+        }
+        int lead = std::min(__builtin_clzll(x), 63);
+        int trail = __builtin_ctzll(x);
+        int length = 64 - lead - trail;
+        int window = 64 - prev_lead - prev_trail;
+        if(prev_lead >= 0 && lead >= prev_lead && trail >= prev_trail && window <= length + 12) {
+            writer.write(2, 2);
+            writer.write(x >> prev_trail, window);
+        } else {
+            writer.write(3, 2);
+            writer.write(lead, 6);
+            writer.write(length - 1, 6);
+            writer.write(x >> trail, length);
+            prev_lead = lead;
+            prev_trail = trail;
+        }
+    }
+}
+
+static void decodeColumn(const uint8_t* data, std::size_t size, std::size_t count, double* values)
+{
+    BitReader reader(data, size);
+    int prev_lead = 0;
+    int prev_trail = 0;
+
+    for(std::size_t i = 0; i < count; i++) {
+        uint64_t x = 0;
+        if(reader.read(1) == 1) {
+            if(reader.read(1) == 1) {
+                prev_lead = reader.read(6);
+                prev_trail = 64 - prev_lead - ((int)reader.read(6) + 1);
+            }
+            x = reader.read(64 - prev_lead - prev_trail) << prev_trail;
+        }
+        values[i] = fromBits(x ^ toBits(predict(values, i)));
+    }
+}
+
+TrajectoryRecorder::TrajectoryRecorder(
+    const std::string& path,
+    std::size_t block_size,
+    std::size_t ring_size
+)
+    : m_file(std::fopen(path.c_str(), "wb"))
+    , m_block_size(std::max<std::size_t>(block_size, 1))
+    , m_ring_size(std::max<std::size_t>(ring_size, 1))
+    , m_offset(sizeof(TrajectoryFileHeader))
+    , m_raw_bytes(0)
+    , m_compressed_bytes(0)
+    , m_stalls(0)
+    , m_stop(false)
+    , m_busy(false)
+{
+    TrajectoryFileHeader header;
+
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, TRAJECTORY_RECORD_MAGIC, sizeof(header.magic));
+    header.version = TRAJECTORY_RECORD_VERSION;
+    header.endian_tag = TRAJECTORY_RECORD_ENDIAN_TAG;
+    if(m_file == nullptr || std::fwrite(&header, sizeof(header), 1, m_file) != 1) {
+        std::stringstream ss;
+        ss << "Cannot create trajectory record " << path;
+        LOG_WARN(ss.str());
+        if(m_file != nullptr) {
+            std::fclose(m_file);
+            m_file = nullptr;
+        }
+        return;
+    }
+    m_writer = std::thread(&TrajectoryRecorder::write, this);
+}
+
+TrajectoryRecorder::~TrajectoryRecorder(void)
+{
+    close();
+}
+
+void TrajectoryRecorder::record(
+    std::size_t satellite,
+    double time,
+    const ECICoordinates& position,
+    const ECICoordinates& velocity
+)
+{
+    if(m_file == nullptr) {
+        return;
+    }
+    if(satellite >= m_open.size()) {
+        std::size_t first = m_open.size();
+        m_open.resize(satellite + 1);
+        for(std::size_t i = first; i < m_open.size(); i++) {
+            m_open[i].satellite = i;
+        }
+    }
+
+    Block& block = m_open[satellite];
+    const double values[TRAJECTORY_RECORD_COLUMNS] = {time, position.x, position.y, position.z,
+        velocity.x, velocity.y, velocity.z};
+    for(int c = 0; c < TRAJECTORY_RECORD_COLUMNS; c++) {
+        block.columns[c].push_back(values[c]);
+    }
+    if(block.columns[0].size() >= m_block_size) {
+        enqueue(block);
+    }
+}
+
+void TrajectoryRecorder::enqueue(Block& block)
+{
+    Block full;
+
+    full.satellite = block.satellite;
+    for(int c = 0; c < TRAJECTORY_RECORD_COLUMNS; c++) {
+        full.columns[c].swap(block.columns[c]);
+        block.columns[c].reserve(m_block_size);
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if(m_ring.size() >= m_ring_size) {
+        m_stalls++;
+        m_wakeup.wait(lock, [&] { return m_ring.size() < m_ring_size; });
+    }
+    m_ring.push_back(std::move(full));
+    m_wakeup.notify_all();
+}
+
+void TrajectoryRecorder::flush(void)
+{
+    if(m_file == nullptr) {
+        return;
+    }
+    for(Block& block : m_open) {
+        if(!block.columns[0].empty()) {
+            enqueue(block);
+        }
+    }
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_wakeup.wait(lock, [&] { return m_ring.empty() && !m_busy; });
+    std::fflush(m_file);
+}
+
+void TrajectoryRecorder::close(void)
+{
+    if(m_file == nullptr) {
+        return;
+    }
+    flush();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_wakeup.notify_all();
+    m_writer.join();
+
+    TrajectoryFileFooter footer;
+    footer.index_offset = m_offset;
+    footer.block_count = m_index.size();
+    std::memcpy(footer.magic, TRAJECTORY_RECORD_MAGIC, sizeof(footer.magic));
+    bool success = (m_index.empty()
+            || std::fwrite(m_index.data(), sizeof(TrajectoryBlockIndex), m_index.size(), m_file)
+                == m_index.size())
+        && std::fwrite(&footer, sizeof(footer), 1, m_file) == 1;
+    success = std::fclose(m_file) == 0 && success;
+    if(!success) {
+        LOG_WARN("Cannot write the index of the trajectory record.");
+    }
+    m_file = nullptr;
+}
+
+uint64_t TrajectoryRecorder::getRawBytes(void) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_raw_bytes;
+}
+
+uint64_t TrajectoryRecorder::getCompressedBytes(void) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_compressed_bytes;
+}
+
+void TrajectoryRecorder::write(void)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    while(true) {
+        m_wakeup.wait(lock, [&] { return m_stop || !m_ring.empty(); });
+        if(m_ring.empty()) {
+            break;
+        }
+        Block block = std::move(m_ring.front());
+        m_ring.pop_front();
+        m_busy = true;
+        m_wakeup.notify_all();
+
+        lock.unlock();
+        writeBlock(block);
+        lock.lock();
+        m_busy = false;
+        m_wakeup.notify_all();
+    }
+}
+
+void TrajectoryRecorder::writeBlock(const Block& block)
+{
+    std::vector<uint8_t> columns[TRAJECTORY_RECORD_COLUMNS];
+    TrajectoryBlockHeader header;
+    uint64_t size = 0;
+
+    std::memset(&header, 0, sizeof(header));
+    header.satellite = block.satellite;
+    header.count = block.columns[0].size();
+    header.first_time = block.columns[0].front();
+    header.last_time = block.columns[0].back();
+    for(int c = 0; c < TRAJECTORY_RECORD_COLUMNS; c++) {
+        encodeColumn(block.columns[c], columns[c]);
+        header.column_bytes[c] = columns[c].size();
+        size += columns[c].size();
+    }
+
+    bool success = std::fwrite(&header, sizeof(header), 1, m_file) == 1;
+    for(int c = 0; c < TRAJECTORY_RECORD_COLUMNS && success; c++) {
+        success = columns[c].empty()
+            || std::fwrite(columns[c].data(), 1, columns[c].size(), m_file) == columns[c].size();
+    }
+    if(!success) {
+        LOG_WARN("Cannot write a block of the trajectory record.");
+        return;
+    }
+
+    m_index.push_back(TrajectoryBlockIndex{m_offset, header.satellite, header.first_time,
+        header.last_time});
+    m_offset += sizeof(header) + size;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_raw_bytes += header.count * TRAJECTORY_RECORD_COLUMNS * sizeof(double);
+    m_compressed_bytes += size;
+}
+
+TrajectoryRecordReader::TrajectoryRecordReader(void)
+    : m_data(nullptr)
+    , m_size(0)
+{ }
+
+TrajectoryRecordReader::~TrajectoryRecordReader(void)
+{
+    close();
+}
+
+void TrajectoryRecordReader::close(void)
+{
+    if(m_data != nullptr) {
+        ::munmap(const_cast<char*>(m_data), m_size);
+        m_data = nullptr;
+        m_size = 0;
+    }
+    m_blocks.clear();
+}
+
+bool TrajectoryRecordReader::open(const std::string& path)
+{
+    struct stat info;
+    int fd = ::open(path.c_str(), O_RDONLY);
+
+    close();
+    if(fd < 0 || ::fstat(fd, &info) != 0
+        || (std::size_t)info.st_size < sizeof(TrajectoryFileHeader)) {
+        std::stringstream ss;
+        ss << "Cannot open trajectory record " << path;
+        LOG_WARN(ss.str());
+        if(fd >= 0) {
+            ::close(fd);
+        }
+        return false;
+    }
+
+    void* map = ::mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if(map == MAP_FAILED) {
+        LOG_WARN("Cannot map the trajectory record.");
+        return false;
+    }
+
+    const TrajectoryFileHeader* header = static_cast<const TrajectoryFileHeader*>(map);
+    if(std::memcmp(header->magic, TRAJECTORY_RECORD_MAGIC, sizeof(header->magic)) != 0
+        || header->version != TRAJECTORY_RECORD_VERSION
+        || header->endian_tag != TRAJECTORY_RECORD_ENDIAN_TAG) {
+        std::stringstream ss;
+        ss << "Invalid or incompatible trajectory record " << path;
+        LOG_WARN(ss.str());
+        ::munmap(map, info.st_size);
+        return false;
+    }
+    m_data = static_cast<const char*>(map);
+    m_size = info.st_size;
+
+    /* Use the index of a closed file, or rebuild it from the block headers. */
+    std::vector<TrajectoryBlockIndex> index;
+    TrajectoryFileFooter footer;
+    bool closed = m_size >= sizeof(TrajectoryFileHeader) + sizeof(footer);
+    if(closed) {
+        std::memcpy(&footer, m_data + m_size - sizeof(footer), sizeof(footer));
+        /* The index fills the space between its offset and the footer. Its size is compared by
+         * division, so that a corrupted footer cannot overflow the check. */
+        uint64_t end = m_size - sizeof(footer);
+        closed = std::memcmp(footer.magic, TRAJECTORY_RECORD_MAGIC, sizeof(footer.magic)) == 0
+            && footer.index_offset >= sizeof(TrajectoryFileHeader) && footer.index_offset <= end
+            && (end - footer.index_offset) % sizeof(TrajectoryBlockIndex) == 0
+            && footer.block_count == (end - footer.index_offset) / sizeof(TrajectoryBlockIndex);
+    }
+    if(closed) {
+        index.resize(footer.block_count);
+        std::memcpy(index.data(), m_data + footer.index_offset,
+            index.size() * sizeof(TrajectoryBlockIndex));
+        closed = std::all_of(index.begin(), index.end(), [this](const TrajectoryBlockIndex& entry) {
+            return checkBlock(entry);
+        });
+        if(!closed) {
+            LOG_WARN("Corrupted index in the trajectory record; the blocks are scanned.");
+            index.clear();
+        }
+    } else {
+        LOG_WARN("Trajectory record without index; the blocks are scanned.");
+    }
+    if(!closed) {
+        scanBlocks(index);
+    }
+
+    for(const TrajectoryBlockIndex& entry : index) {
+        if(entry.satellite >= m_blocks.size()) {
+            m_blocks.resize(entry.satellite + 1);
+        }
+        m_blocks[entry.satellite].push_back(entry);
+    }
+    return true;
+}
+
+bool TrajectoryRecordReader::checkBlock(const TrajectoryBlockIndex& entry) const
+{
+    TrajectoryBlockHeader header;
+    uint64_t size = 0;
+
+    if(entry.offset < sizeof(TrajectoryFileHeader) || entry.offset > m_size
+        || m_size - entry.offset < sizeof(header)) {
+        return false;
+    }
+    std::memcpy(&header, m_data + entry.offset, sizeof(header));
+    for(int c = 0; c < TRAJECTORY_RECORD_COLUMNS; c++) {
+        size += header.column_bytes[c];
+    }
+    return header.count > 0 && header.satellite == entry.satellite
+        && size <= m_size - entry.offset - sizeof(header);
+}
+
+bool TrajectoryRecordReader::scanBlocks(std::vector<TrajectoryBlockIndex>& index) const
+{
+    uint64_t offset = sizeof(TrajectoryFileHeader);
+
+    while(offset + sizeof(TrajectoryBlockHeader) <= m_size) {
+        TrajectoryBlockHeader header;
+        uint64_t size = 0;
+        std::memcpy(&header, m_data + offset, sizeof(header));
+        for(int c = 0; c < TRAJECTORY_RECORD_COLUMNS; c++) {
+            size += header.column_bytes[c];
+        }
+        if(header.count == 0 || offset + sizeof(header) + size > m_size) {
+            /* Truncated block at the end of the file. */
+            return false;
+        }
+        index.push_back(TrajectoryBlockIndex{offset, header.satellite, header.first_time,
+            header.last_time});
+        offset += sizeof(header) + size;
+    }
+    return true;
+}
+
+std::size_t TrajectoryRecordReader::getBlockCount(void) const
+{
+    std::size_t count = 0;
+
+    for(const std::vector<TrajectoryBlockIndex>& blocks : m_blocks) {
+        count += blocks.size();
+    }
+    return count;
+}
+
+std::size_t TrajectoryRecordReader::read(
+    std::size_t satellite,
+    double start,
+    double end,
+    std::vector<TrajectorySample>& samples
+) const
+{
+    std::size_t appended = 0;
+
+    if(satellite >= m_blocks.size()) {
+        return 0;
+    }
+
+    /* Blocks of a satellite are stored in time order: skip the ones that end before start. */
+    const std::vector<TrajectoryBlockIndex>& blocks = m_blocks[satellite];
+    std::vector<TrajectoryBlockIndex>::const_iterator it = std::lower_bound(blocks.begin(),
+        blocks.end(), start, [](const TrajectoryBlockIndex& entry, double time) {
+            return entry.last_time < time;
+        });
+    std::vector<double> columns[TRAJECTORY_RECORD_COLUMNS];
+
+    for(; it != blocks.end() && it->first_time <= end; ++it) {
+        TrajectoryBlockHeader header;
+        uint64_t offset = it->offset + sizeof(header);
+        std::memcpy(&header, m_data + it->offset, sizeof(header));
+        for(int c = 0; c < TRAJECTORY_RECORD_COLUMNS; c++) {
+            if(offset + header.column_bytes[c] > m_size) {
+                LOG_WARN("Corrupted block in the trajectory record.");
+                return appended;
+            }
+            columns[c].resize(header.count);
+            decodeColumn(reinterpret_cast<const uint8_t*>(m_data + offset), header.column_bytes[c],
+                header.count, columns[c].data());
+            offset += header.column_bytes[c];
+        }
+
+        for(std::size_t i = 0; i < header.count; i++) {
+            if(columns[0][i] < start || columns[0][i] > end) {
+                continue;
+            }
+            samples.push_back(TrajectorySample{columns[0][i],
+                ECICoordinates(columns[1][i], columns[2][i], columns[3][i]),
+                ECICoordinates(columns[4][i], columns[5][i], columns[6][i])});
+            appended++;
+        }
+    }
+    return appended;
+}
@@ -0,0 +1,274 @@
+/***********************************************************************************************//**
+ *  Compressed columnar recorder of satellite trajectories
+ *  @class      TrajectoryRecorder
+ *  @author     DSS-SIM development team, i2CAT
+ *  @date       2026-oct-16
+ *  @copyright  This code has been developed by Fundació Privada Internet i Innovació Digital a
+ *              Catalunya (i2CAT). i2CAT is a non-profit research and innovation centre that
+ *              promotes mission-driven knowledge to solve business challenges, co-create solutions
+ *              with a transformative impact, empower citizens through open and participative
+ *              digital social innovation with territorial capillarity, and promote pioneering and
+ *              strategic initiatives. i2CAT *aims to transfer* research project results to private
+ *              companies in order to create social and economic impact via the out-licensing of
+ *              intellectual property and the creation of spin-offs.
+ *              Find more information of i2CAT projects and IP rights at:
+ *              https://i2cat.net/tech-transfer/
+ **************************************************************************************************/
+
+#ifndef __TRAJECTORY_RECORDER_HPP__
+#define __TRAJECTORY_RECORDER_HPP__
+
+/* Global libraries */
+#include "dss.hpp"
+
+/* External Libraries */
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/* Internal Libraries */
+#include "ECICoordinates.hpp"
+
+#define TRAJECTORY_RECORD_MAGIC     "DSSTRAJR"  /**< Identifier at the start of the file */
+#define TRAJECTORY_RECORD_VERSION   1           /**< Version of the file layout */
+#define TRAJECTORY_RECORD_COLUMNS   7           /**< Time, position and velocity columns */
+#define TRAJECTORY_RECORD_BLOCK     256         /**< Default samples per block */
+#define TRAJECTORY_RECORD_RING      16          /**< Default blocks waiting to be written */
+
+/***********************************************************************************************//**
+ * Recorded state of a satellite.
+ **************************************************************************************************/
+struct TrajectorySample
+{
+    double time;                /**< Propagation time, with the same meaning as in sgp4Propagate */
+    ECICoordinates position;    /**< ECI position (km) */
+    ECICoordinates velocity;    /**< ECI velocity (km/s) */
+};
+
+/***********************************************************************************************//**
+ * Header of each block of a trajectory record file. It is followed by the seven compressed
+ * columns (time, x, y, z, vx, vy, vz) of the block, one after the other.
+ **************************************************************************************************/
+struct TrajectoryBlockHeader
+{
+    uint64_t satellite;                                 /**< Index of the satellite */
+    uint32_t count;                                     /**< Number of samples */
+    uint32_t column_bytes[TRAJECTORY_RECORD_COLUMNS];   /**< Compressed size of each column */
+    double first_time;                                  /**< Time of the first sample */
+    double last_time;                                   /**< Time of the last sample */
+};
+
+/***********************************************************************************************//**
+ * Entry of the block index written at the end of a trajectory record file.
+ **************************************************************************************************/
+struct TrajectoryBlockIndex
+{
+    uint64_t offset;            /**< Offset of the block header (bytes) */
+    uint64_t satellite;         /**< Index of the satellite */
+    double first_time;          /**< Time of the first sample */
+    double last_time;           /**< Time of the last sample */
+};
+
+/***********************************************************************************************//**
+ * Streaming recorder of the trajectories of many satellites. The samples of each satellite are
+ * gathered in columns of a fixed number of samples; every full block is moved to a bounded ring
+ * and a writer thread compresses and appends it to the file, so the memory used does not grow
+ * with the length of the run. If the ring is full, record waits for the writer.
+ *
+ * Each column is compressed independently: every value is predicted by quadratic extrapolation of
+ * the three previous ones, 3 * (v[i-1] - v[i-2]) + v[i-3] (0, the previous value and linear
+ * extrapolation for the first three values), and the XOR of the value and the prediction is
+ * stored with Gorilla's leading/trailing zero encoding. Smooth trajectories and uniform time
+ * steps leave most of the XOR bits at zero, and the values are recovered exactly. An index of the
+ * blocks is appended when the recorder is closed.
+ *
+ * @see     TrajectoryRecordReader
+ **************************************************************************************************/
+class TrajectoryRecorder
+{
+public:
+    /*******************************************************************************************//**
+     * Creates the record file and starts the writer thread.
+     *
+     * @param  path         Path of the record file
+     * @param  block_size   Samples per block
+     * @param  ring_size    Maximum number of full blocks waiting to be written
+     **********************************************************************************************/
+    TrajectoryRecorder(
+        const std::string& path,
+        std::size_t block_size = TRAJECTORY_RECORD_BLOCK,
+        std::size_t ring_size = TRAJECTORY_RECORD_RING
+    );
+
+    /*******************************************************************************************//**
+     * Destructor. It closes the record.
+     **********************************************************************************************/
+    ~TrajectoryRecorder(void);
+
+    TrajectoryRecorder(const TrajectoryRecorder&) = delete;
+    TrajectoryRecorder& operator=(const TrajectoryRecorder&) = delete;
+
+    /*******************************************************************************************//**
+     * Checks if the file could be created.
+     **********************************************************************************************/
+    bool isOpen(void) const { return m_file != nullptr; }
+
+    /*******************************************************************************************//**
+     * Records the state of a satellite. The samples of a satellite shall be recorded in
+     * increasing time order, and this method shall be called from a single thread.
+     *
+     * @param  satellite    Index of the satellite
+     * @param  time         Propagation time, with the same meaning as in sgp4Propagate
+     * @param  position     ECI position (km)
+     * @param  velocity     ECI velocity (km/s)
+     **********************************************************************************************/
+    void record(std::size_t satellite, double time, const ECICoordinates& position,
+        const ECICoordinates& velocity);
+
+    /*******************************************************************************************//**
+     * Writes the partial blocks of all the satellites and waits until the ring is empty.
+     **********************************************************************************************/
+    void flush(void);
+
+    /*******************************************************************************************//**
+     * Flushes the record, appends the block index and closes the file.
+     **********************************************************************************************/
+    void close(void);
+
+    /*******************************************************************************************//**
+     * Retrieves the size of the recorded samples without compression (bytes).
+     **********************************************************************************************/
+    uint64_t getRawBytes(void) const;
+
+    /*******************************************************************************************//**
+     * Retrieves the size of the compressed columns written so far (bytes).
+     **********************************************************************************************/
+    uint64_t getCompressedBytes(void) const;
+
+    /*******************************************************************************************//**
+     * Retrieves the number of times that record had to wait for the writer thread.
+     **********************************************************************************************/
+    std::size_t getStallCount(void) const { return m_stalls; }
+
+private:
+    /*******************************************************************************************//**
+     * Samples of a satellite in column layout.
+     **********************************************************************************************/
+    struct Block
+    {
+        std::size_t satellite;                                  /**< Index of the satellite */
+        std::vector<double> columns[TRAJECTORY_RECORD_COLUMNS]; /**< Time, position, velocity */
+    };
+
+    std::FILE* m_file;                      /**< Record file */
+    std::size_t m_block_size;               /**< Samples per block */
+    std::size_t m_ring_size;                /**< Maximum blocks in the ring */
+    std::vector<Block> m_open;              /**< Block being filled, per satellite */
+    std::deque<Block> m_ring;               /**< Full blocks waiting to be written */
+    std::vector<TrajectoryBlockIndex> m_index;  /**< Index of the written blocks */
+    uint64_t m_offset;                      /**< Current size of the file (bytes) */
+    uint64_t m_raw_bytes;                   /**< Uncompressed size of the written blocks */
+    uint64_t m_compressed_bytes;            /**< Compressed size of the written blocks */
+    std::size_t m_stalls;                   /**< Waits for space in the ring */
+    bool m_stop;                            /**< Writer thread shall finish */
+    bool m_busy;                            /**< Writer thread is writing a block */
+    mutable std::mutex m_mutex;             /**< Protects the ring and the writer state */
+    std::condition_variable m_wakeup;       /**< Signals changes in the ring */
+    std::thread m_writer;                   /**< Writer thread */
+
+    /*******************************************************************************************//**
+     * Moves a block to the ring, waiting for space if needed.
+     **********************************************************************************************/
+    void enqueue(Block& block);
+
+    /*******************************************************************************************//**
+     * Body of the writer thread.
+     **********************************************************************************************/
+    void write(void);
+
+    /*******************************************************************************************//**
+     * Compresses a block and appends it to the file.
+     **********************************************************************************************/
+    void writeBlock(const Block& block);
+};
+
+/***********************************************************************************************//**
+ * Read-only view of a trajectory record file. The file is memory mapped and only the block index
+ * is read when it is opened; a query decompresses just the blocks of the satellite that overlap
+ * the requested time range. Files whose index is missing (the recorder was not closed) are
+ * indexed by walking the block headers.
+ *
+ * @see     TrajectoryRecorder
+ **************************************************************************************************/
+class TrajectoryRecordReader
+{
+public:
+    /*******************************************************************************************//**
+     * Constructs a reader without any file. Use open to map a file.
+     **********************************************************************************************/
+    TrajectoryRecordReader(void);
+
+    /*******************************************************************************************//**
+     * Destructor. It unmaps the file.
+     **********************************************************************************************/
+    ~TrajectoryRecordReader(void);
+
+    TrajectoryRecordReader(const TrajectoryRecordReader&) = delete;
+    TrajectoryRecordReader& operator=(const TrajectoryRecordReader&) = delete;
+
+    /*******************************************************************************************//**
+     * Maps a record file and loads its block index.
+     *
+     * @param  path     Path of the record file
+     * @return          True if the file is valid and has been mapped
+     **********************************************************************************************/
+    bool open(const std::string& path);
+
+    /*******************************************************************************************//**
+     * Retrieves the number of satellites, that is, the highest satellite index plus one.
+     **********************************************************************************************/
+    std::size_t getSatelliteCount(void) const { return m_blocks.size(); }
+
+    /*******************************************************************************************//**
+     * Retrieves the number of blocks of the file.
+     **********************************************************************************************/
+    std::size_t getBlockCount(void) const;
+
+    /*******************************************************************************************//**
+     * Reads the samples of a satellite in a time range.
+     *
+     * @param  satellite    Index of the satellite
+     * @param  start        Start of the time range
+     * @param  end          End of the time range (included)
+     * @param  samples      Output samples, appended in time order
+     * @return              Number of samples appended
+     **********************************************************************************************/
+    std::size_t read(std::size_t satellite, double start, double end,
+        std::vector<TrajectorySample>& samples) const;
+
+private:
+    const char* m_data;                                         /**< Mapped file */
+    std::size_t m_size;                                         /**< Size of the mapping */
+    std::vector<std::vector<TrajectoryBlockIndex>> m_blocks;    /**< Blocks per satellite */
+
+    /*******************************************************************************************//**
+     * Unmaps the current file, if any.
+     **********************************************************************************************/
+    void close(void);
+
+    /*******************************************************************************************//**
+     * Checks that an index entry points to a whole block of its satellite inside the file.
+     **********************************************************************************************/
+    bool checkBlock(const TrajectoryBlockIndex& entry) const;
+
+    /*******************************************************************************************//**
+     * Builds the block index by walking the block headers.
+     **********************************************************************************************/
+    bool scanBlocks(std::vector<TrajectoryBlockIndex>& index) const;
+};
+
+#endif /* __TRAJECTORY_RECORDER_HPP__ */
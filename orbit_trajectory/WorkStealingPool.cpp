@@ -0,0 +1,139 @@
+/***********************************************************************************************//**
+ *  Class that implements a pool of threads that balances work by stealing tasks
+ *  @class      WorkStealingPool
+ *  @author     DSS-SIM development team, i2CAT
+ *  @date       2026-oct-16
+ *  @copyright  This code has been developed by Fundació Privada Internet i Innovació Digital a
+ *              Catalunya (i2CAT). i2CAT is a non-profit research and innovation centre that
+ *              promotes mission-driven knowledge to solve business challenges, co-create solutions
+ *              with a transformative impact, empower citizens through open and participative
+ *              digital social innovation with territorial capillarity, and promote pioneering and
+ *              strategic initiatives. i2CAT *aims to transfer* research project results to private
+ *              companies in order to create social and economic impact via the out-licensing of
+ *              intellectual property and the creation of spin-offs.
+ *              Find more information of i2CAT projects and IP rights at:
+ *              https://i2cat.net/tech-transfer/
+ **************************************************************************************************/
+
+#include "WorkStealingPool.hpp"
+
+LOG_COMPONENT_DEFINE("WorkStealingPool");
+
+WorkStealingPool::WorkStealingPool(unsigned int threads)
+    : m_task(nullptr)
+    , m_generation(0)
+    , m_pending(0)
+    , m_active(0)
+    , m_steals(0)
+    , m_stop(false)
+{
+    if(threads == 0) {
+        threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    for(unsigned int i = 0; i < threads; i++) {
+        m_queues.emplace_back(new TaskQueue());
+    }
+    for(unsigned int i = 0; i < threads; i++) {
+        m_threads.emplace_back(&WorkStealingPool::workerLoop, this, i);
+    }
+}
+
+WorkStealingPool::~WorkStealingPool(void)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_job_cv.notify_all();
+    for(std::thread& thread : m_threads) {
+        thread.join();
+    }
+}
+
+void WorkStealingPool::parallelFor(std::size_t count, const std::function<void(std::size_t)>& task)
+{
+    std::size_t workers = m_queues.size();
+
+    if(count == 0) {
+        return;
+    }
+
+    /* Workers still leaving the previous job must not see the tasks of this one. */
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done_cv.wait(lock, [this] { return m_active == 0; });
+
+    /* Each worker starts with a contiguous block of task indices. */
+    for(std::size_t w = 0; w < workers; w++) {
+        std::lock_guard<std::mutex> queue_lock(m_queues[w]->mutex);
+        for(std::size_t i = w * count / workers; i < (w + 1) * count / workers; i++) {
+            m_queues[w]->tasks.push_back(i);
+        }
+    }
+
+    m_task = &task;
+    m_pending = count;
+    m_generation++;
+    m_job_cv.notify_all();
+    m_done_cv.wait(lock, [this] { return m_pending.load() == 0 && m_active == 0; });
+    m_task = nullptr;
+}
+
+void WorkStealingPool::workerLoop(unsigned int id)
+{
+    uint64_t generation = 0;
+
+    while(true) {
+        const std::function<void(std::size_t)>* task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_job_cv.wait(lock, [this, generation] { return m_stop || m_generation != generation; });
+            if(m_stop) {
+                return;
+            }
+            generation = m_generation;
+            task = m_task;
+            m_active++;
+        }
+
+        std::size_t index;
+        while(task != nullptr && takeTask(id, index)) {
+            (*task)(index);
+            if(--m_pending == 0) {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_done_cv.notify_all();
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_active--;
+        m_done_cv.notify_all();
+    }
+}
+
+bool WorkStealingPool::takeTask(unsigned int id, std::size_t& task)
+{
+    std::size_t workers = m_queues.size();
+
+    {
+        TaskQueue& own = *m_queues[id];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if(!own.tasks.empty()) {
+            task = own.tasks.back();
+            own.tasks.pop_back();
+            return true;
+        }
+    }
+
+    /* Own queue is empty: steal from the front of the other queues. */
+    for(std::size_t k = 1; k < workers; k++) {
+        TaskQueue& victim = *m_queues[(id + k) % workers];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if(!victim.tasks.empty()) {
+            task = victim.tasks.front();
+            victim.tasks.pop_front();
+            m_steals++;
+            return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,115 @@
+/***********************************************************************************************//**
+ *  Class that implements a pool of threads that balances work by stealing tasks
+ *  @class      WorkStealingPool
+ *  @author     DSS-SIM development team, i2CAT
+ *  @date       2026-oct-16
+ *  @copyright  This code has been developed by Fundació Privada Internet i Innovació Digital a
+ *              Catalunya (i2CAT). i2CAT is a non-profit research and innovation centre that
+ *              promotes mission-driven knowledge to solve business challenges, co-create solutions
+ *              with a transformative impact, empower citizens through open and participative
+ *              digital social innovation with territorial capillarity, and promote pioneering and
+ *              strategic initiatives. i2CAT *aims to transfer* research project results to private
+ *              companies in order to create social and economic impact via the out-licensing of
+ *              intellectual property and the creation of spin-offs.
+ *              Find more information of i2CAT projects and IP rights at:
+ *              https://i2cat.net/tech-transfer/
+ **************************************************************************************************/
+
+#ifndef __WORK_STEALING_POOL_HPP__
+#define __WORK_STEALING_POOL_HPP__
+
+/* Global libraries */
+#include "dss.hpp"
+
+/* External Libraries */
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/***********************************************************************************************//**
+ * Pool of worker threads that runs indexed tasks in parallel. When a job is submitted, the task
+ * indices are split in contiguous blocks, one per worker. Each worker consumes its own block from
+ * the back and, once it is empty, steals tasks from the front of the other workers' blocks. This
+ * keeps neighbouring tasks on the same core while balancing uneven task costs.
+ *
+ * Jobs are submitted from a single thread at a time and parallelFor blocks until all the tasks of
+ * the job have been run.
+ **************************************************************************************************/
+class WorkStealingPool
+{
+public:
+    /*******************************************************************************************//**
+     * Constructs the pool and starts its worker threads.
+     *
+     * @param  threads  Number of worker threads. If 0, the number of hardware threads is used.
+     **********************************************************************************************/
+    WorkStealingPool(unsigned int threads = 0);
+
+    /*******************************************************************************************//**
+     * Destructor. It stops and joins the worker threads.
+     **********************************************************************************************/
+    ~WorkStealingPool(void);
+
+    /*******************************************************************************************//**
+     * Retrieves the number of worker threads.
+     **********************************************************************************************/
+    unsigned int getThreadCount(void) const { return m_threads.size(); }
+
+    /*******************************************************************************************//**
+     * Retrieves the number of tasks that have been stolen from another worker since construction.
+     **********************************************************************************************/
+    uint64_t getSteals(void) const { return m_steals.load(); }
+
+    /*******************************************************************************************//**
+     * Runs a task for every index in [0, count) and waits until all of them have finished.
+     *
+     * @param  count    Number of tasks
+     * @param  task     Function called with the index of each task
+     **********************************************************************************************/
+    void parallelFor(std::size_t count, const std::function<void(std::size_t)>& task);
+
+private:
+    /*******************************************************************************************//**
+     * Task indices owned by one worker.
+     **********************************************************************************************/
+    struct TaskQueue
+    {
+        std::mutex mutex;                   /**< Protects the task indices */
+        std::deque<std::size_t> tasks;      /**< Pending task indices */
+    };
+
+    std::vector<std::thread> m_threads;                 /**< Worker threads */
+    std::vector<std::unique_ptr<TaskQueue>> m_queues;   /**< One task queue per worker */
+    std::mutex m_mutex;                                 /**< Protects the job state */
+    std::condition_variable m_job_cv;                   /**< Signals new jobs to the workers */
+    std::condition_variable m_done_cv;                  /**< Signals the end of a job */
+    const std::function<void(std::size_t)>* m_task;     /**< Task of the current job */
+    uint64_t m_generation;                              /**< Identifier of the current job */
+    std::atomic<std::size_t> m_pending;                 /**< Tasks of the job not finished yet */
+    unsigned int m_active;                              /**< Workers running tasks of a job */
+    std::atomic<uint64_t> m_steals;                     /**< Number of stolen tasks */
+    bool m_stop;                                        /**< Requests the workers to finish */
+
+    /*******************************************************************************************//**
+     * Main loop of a worker thread.
+     *
+     * @param  id   Index of the worker
+     **********************************************************************************************/
+    void workerLoop(unsigned int id);
+
+    /*******************************************************************************************//**
+     * Takes the next task for a worker, first from its own queue and then from the others.
+     *
+     * @param  id       Index of the worker
+     * @param  task     Output task index
+     * @return          True if a task has been taken, false if all queues are empty
+     **********************************************************************************************/
+    bool takeTask(unsigned int id, std::size_t& task);
+};
+
+#endif /* __WORK_STEALING_POOL_HPP__ */
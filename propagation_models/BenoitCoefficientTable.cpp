@@ -0,0 +1,100 @@
+/***********************************************************************************************//**
+ *  Precomputed attenuation coefficients of Benoit's cloud model
+ *  @class      BenoitCoefficientTable
+ *  @author     DSS-SIM development team, i2CAT
+ *  @date       2026-oct-16
+ *  @copyright  This code has been developed by Fundació Privada Internet i Innovació Digital a
+ *              Catalunya (i2CAT). i2CAT is a non-profit research and innovation centre that
+ *              promotes mission-driven knowledge to solve business challenges, co-create solutions
+ *              with a transformative impact, empower citizens through open and participative
+ *              digital social innovation with territorial capillarity, and promote pioneering and
+ *              strategic initiatives. i2CAT *aims to transfer* research project results to private
+ *              companies in order to create social and economic impact via the out-licensing of
+ *              intellectual property and the creation of spin-offs.
+ *              Find more information of i2CAT projects and IP rights at:
+ *              https://i2cat.net/tech-transfer/
+ **************************************************************************************************/
+
+#include "BenoitCoefficientTable.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+LOG_COMPONENT_DEFINE("BenoitCoefficientTable");
+
+BenoitCoefficientTable::BenoitCoefficientTable(double temp)
+    : m_temp(temp)
+    , m_sweep_min(0)
+    , m_sweep_step(0)
+{ }
+
+double BenoitCoefficientTable::compute(double freq, double temp)
+{
+    return std::pow(freq, BENOIT_CONSTANT_A1)
+        * std::exp(BENOIT_CONSTANT_A2 * (1 + BENOIT_CONSTANT_A3 * temp));
+}
+
+void BenoitCoefficientTable::addFrequency(double freq)
+{
+    std::vector<std::pair<double, double>>::iterator it = std::lower_bound(m_bands.begin(),
+        m_bands.end(), std::make_pair(freq, 0.0),
+        [](const std::pair<double, double>& a, const std::pair<double, double>& b) {
+            return a.first < b.first;
+        });
+
+    if(it == m_bands.end() || it->first != freq) {
+        m_bands.insert(it, std::make_pair(freq, compute(freq, m_temp)));
+    }
+}
+
+void BenoitCoefficientTable::setSweep(double min_freq, double max_freq, std::size_t points)
+{
+    if(min_freq <= 0 || max_freq <= min_freq || points < 2) {
+        LOG_WARN("The frequency sweep shall be positive, ordered and have 2 points; not set.");
+        return;
+    }
+
+    m_sweep_min = min_freq;
+    m_sweep_step = (max_freq - min_freq) / (points - 1);
+    m_sweep.resize(points);
+    for(std::size_t i = 0; i < points; i++) {
+        m_sweep[i] = compute(min_freq + i * m_sweep_step, m_temp);
+    }
+}
+
+double BenoitCoefficientTable::getErrorBound(void) const
+{
+    if(m_sweep.empty()) {
+        return 0.0;
+    }
+
+    double ratio = m_sweep_step / m_sweep_min;
+    return BENOIT_CONSTANT_A1 * (BENOIT_CONSTANT_A1 - 1) / 8.0 * ratio * ratio;
+}
+
+bool BenoitCoefficientTable::lookup(double freq, double& k1) const
+{
+    std::vector<std::pair<double, double>>::const_iterator it = std::lower_bound(m_bands.begin(),
+        m_bands.end(), std::make_pair(freq, 0.0),
+        [](const std::pair<double, double>& a, const std::pair<double, double>& b) {
+            return a.first < b.first;
+        });
+
+    if(it != m_bands.end() && it->first == freq) {
+        k1 = it->second;
+        return true;
+    }
+    if(m_sweep.empty()) {
+        return false;
+    }
+
+    double u = (freq - m_sweep_min) / m_sweep_step;
+    if(u < 0 || u > (double)(m_sweep.size() - 1)) {
+        return false;
+    }
+
+    std::size_t i = std::min((std::size_t)u, m_sweep.size() - 2);
+    double s = u - i;
+    k1 = m_sweep[i] + s * (m_sweep[i + 1] - m_sweep[i]);
+    return true;
+}
@@ -0,0 +1,111 @@
+/***********************************************************************************************//**
+ *  Precomputed attenuation coefficients of Benoit's cloud model
+ *  @class      BenoitCoefficientTable
+ *  @author     DSS-SIM development team, i2CAT
+ *  @date       2026-oct-16
+ *  @copyright  This code has been developed by Fundació Privada Internet i Innovació Digital a
+ *              Catalunya (i2CAT). i2CAT is a non-profit research and innovation centre that
+ *              promotes mission-driven knowledge to solve business challenges, co-create solutions
+ *              with a transformative impact, empower citizens through open and participative
+ *              digital social innovation with territorial capillarity, and promote pioneering and
+ *              strategic initiatives. i2CAT *aims to transfer* research project results to private
+ *              companies in order to create social and economic impact via the out-licensing of
+ *              intellectual property and the creation of spin-offs.
+ *              Find more information of i2CAT projects and IP rights at:
+ *              https://i2cat.net/tech-transfer/
+ **************************************************************************************************/
+
+#ifndef __BENOIT_COEFFICIENT_TABLE_HPP__
+#define __BENOIT_COEFFICIENT_TABLE_HPP__
+
+/* Global libraries */
+#include "dss.hpp"
+
+/* External libraries */
+#include <utility>
+#include <vector>
+
+#define BENOIT_CONSTANT_A1 1.95      /**< Constant from Benoit's empirical expression. */
+#define BENOIT_CONSTANT_A2 -6.866    /**< Constant from Benoit's empirical expression. */
+#define BENOIT_CONSTANT_A3 4.5e-3    /**< Constant from Benoit's empirical expression. */
+
+/***********************************************************************************************//**
+ * Table of the attenuation coefficient K1 = f^A1 * exp(A2 * (1 + A3 * T)) of Benoit's expression,
+ * for the fixed temperature of a cloud model. The transcendental functions are evaluated when the
+ * table is filled, so a lookup only costs a search or an interpolation.
+ *
+ * Two kinds of entries are kept:
+ *  - The exact coefficient of each band of the scenario, found by its frequency.
+ *  - Optionally, a uniform grid over a frequency range, linearly interpolated, for frequencies
+ *    swept continuously. As K1 is proportional to f^A1, the relative error of the interpolation is
+ *    bounded by A1 * (A1 - 1) / 8 * (h / f_min)^2, where h is the step of the grid and f_min the
+ *    lowest frequency of the range; e.g. 2.9e-4 for 256 points between 3 and 30 GHz.
+ *
+ * The table shall be filled before it is shared: lookups are const and can then be done from
+ * several threads at once.
+ *
+ * @see     Clouds
+ **************************************************************************************************/
+class BenoitCoefficientTable
+{
+public:
+    /*******************************************************************************************//**
+     * Constructs an empty table.
+     *
+     * @param  temp     Temperature of the cloud, as in Clouds
+     **********************************************************************************************/
+    BenoitCoefficientTable(double temp);
+
+    /*******************************************************************************************//**
+     * Auto-generated destructor.
+     **********************************************************************************************/
+    ~BenoitCoefficientTable(void) = default;
+
+    /*******************************************************************************************//**
+     * Computes the coefficient with Benoit's expression.
+     *
+     * @param  freq     Frequency, in the units of SpaceNetDevice::getFrequency
+     * @param  temp     Temperature of the cloud
+     * @return          Attenuation coefficient in [dB/Km]/[g/m³]
+     **********************************************************************************************/
+    static double compute(double freq, double temp);
+
+    /*******************************************************************************************//**
+     * Precomputes the exact coefficient of a band.
+     *
+     * @param  freq     Frequency of the band
+     **********************************************************************************************/
+    void addFrequency(double freq);
+
+    /*******************************************************************************************//**
+     * Precomputes an interpolated grid over a frequency range. A previous grid is replaced.
+     *
+     * @param  min_freq     Lowest frequency of the range (positive)
+     * @param  max_freq     Highest frequency of the range
+     * @param  points       Number of points of the grid (at least 2)
+     **********************************************************************************************/
+    void setSweep(double min_freq, double max_freq, std::size_t points);
+
+    /*******************************************************************************************//**
+     * Retrieves the bound of the relative error of the interpolated grid (0 if there is none).
+     **********************************************************************************************/
+    double getErrorBound(void) const;
+
+    /*******************************************************************************************//**
+     * Looks up the coefficient of a frequency, first among the bands and then in the grid.
+     *
+     * @param  freq     Frequency
+     * @param  k1       Output coefficient
+     * @return          False if the frequency is neither a band nor inside the grid
+     **********************************************************************************************/
+    bool lookup(double freq, double& k1) const;
+
+private:
+    double m_temp;                                  /**< Temperature of the cloud */
+    std::vector<std::pair<double, double>> m_bands; /**< Frequency and K1 of each band, sorted */
+    double m_sweep_min;                             /**< Lowest frequency of the grid */
+    double m_sweep_step;                            /**< Step of the grid */
+    std::vector<double> m_sweep;                    /**< K1 at each point of the grid */
+};
+
+#endif /* __BENOIT_COEFFICIENT_TABLE_HPP__ */
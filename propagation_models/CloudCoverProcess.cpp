@@ -0,0 +1,231 @@
+/***********************************************************************************************//**
+ *  Stochastic cloud cover of ground stations, generated lazily in chunks of time
+ *  @class      CloudCoverProcess
+ *  @author     DSS-SIM development team, i2CAT
+ *  @date       2026-oct-16
+ *  @copyright  This code has been developed by Fundació Privada Internet i Innovació Digital a
+ *              Catalunya (i2CAT). i2CAT is a non-profit research and innovation centre that
+ *              promotes mission-driven knowledge to solve business challenges, co-create solutions
+ *              with a transformative impact, empower citizens through open and participative
+ *              digital social innovation with territorial capillarity, and promote pioneering and
+ *              strategic initiatives. i2CAT *aims to transfer* research project results to private
+ *              companies in order to create social and economic impact via the out-licensing of
+ *              intellectual property and the creation of spin-offs.
+ *              Find more information of i2CAT projects and IP rights at:
+ *              https://i2cat.net/tech-transfer/
+ **************************************************************************************************/
+
+#include "CloudCoverProcess.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+LOG_COMPONENT_DEFINE("CloudCoverProcess");
+
+/* Finalizer of SplitMix64: a bijection of 64-bit integers with full avalanche, so consecutive
+ * counters give independent-looking outputs. */
+static uint64_t mix(uint64_t value)
+{
+    value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+    return value ^ (value >> 31);
+}
+
+CloudCoverProcess::CloudCoverProcess(uint64_t seed, double step, std::size_t cache_chunks)
+    : m_seed(seed)
+    , m_step(step)
+    , m_capacity(std::max<std::size_t>(cache_chunks, 1))
+    , m_hits(0)
+    , m_misses(0)
+{
+    if(!(m_step > 0)) {
+        LOG_WARN("The step of the cloud cover shall be positive; 60 s is used.");
+        m_step = 60.0;
+    }
+}
+
+std::size_t CloudCoverProcess::addStation(const CloudCoverParameters& parameters)
+{
+    Station station;
+    double p = std::min(std::max(parameters.probability, 1e-9), 1.0 - 1e-9);
+
+    /* Threshold with P(X > t) = p, by bisection of the normal tail. */
+    double low = -40.0, high = 40.0;
+    for(int i = 0; i < 100; i++) {
+        double middle = 0.5 * (low + high);
+        if(0.5 * std::erfc(middle / std::sqrt(2.0)) > p) {
+            low = middle;
+        } else {
+            high = middle;
+        }
+    }
+
+    /* E[X - t | X > t] = phi(t) / p - t, so the mean content while cloudy is the given one. */
+    station.parameters = parameters;
+    station.threshold = 0.5 * (low + high);
+    double density = std::exp(-0.5 * station.threshold * station.threshold)
+        / std::sqrt(2.0 * Globals::constants.pi);
+    station.scale = parameters.wlc / (density / p - station.threshold);
+    station.rate = (parameters.correlation_time > 0) ? m_step / parameters.correlation_time
+        : HUGE_VAL;
+
+    station.powers.resize(CLOUD_COVER_CHUNK_SAMPLES + 1, 1.0);
+    for(std::size_t m = 1; m <= CLOUD_COVER_CHUNK_SAMPLES; m++) {
+        station.powers[m] = std::exp(-station.rate * m);
+    }
+
+    m_stations.push_back(station);
+    return m_stations.size() - 1;
+}
+
+double CloudCoverProcess::draw(uint64_t station, uint64_t stream, uint64_t counter) const
+{
+    /* Box-Muller from two 53-bit uniforms of the hashed counter. */
+    const double scale = 1.0 / 9007199254740992.0;  /* 2^-53 */
+    uint64_t key = mix(m_seed ^ mix((station << 1 | stream) ^ mix(counter)));
+    double u1 = ((mix(key) >> 11) + 1) * scale;     /* (0, 1] */
+    double u2 = (mix(key + 1) >> 11) * scale;       /* [0, 1) */
+
+    return std::sqrt(-2.0 * std::log(u1)) * std::cos(2.0 * Globals::constants.pi * u2);
+}
+
+double CloudCoverProcess::getBound(std::size_t station, uint64_t chunk) const
+{
+    double rate = m_stations[station].rate * CLOUD_COVER_CHUNK_SAMPLES;
+    uint64_t low = 0;
+    uint64_t high = (uint64_t)1 << CLOUD_COVER_LEVELS;
+    double x_low = draw(station, 0, low);
+    double r = std::exp(-rate * high);
+    double x_high = r * x_low + std::sqrt(1 - r * r) * draw(station, 0, high);
+
+    /* The middle of [low, high], h chunks from each end, given both ends: mean
+     * r / (1 + r²) (x_low + x_high) and variance (1 - r²) / (1 + r²), with r the correlation at h
+     * chunks. Every middle is drawn from its own counter. */
+    while(chunk != low && chunk != high) {
+        uint64_t middle = low + (high - low) / 2;
+        r = std::exp(-rate * (middle - low));
+        double x_middle = r / (1 + r * r) * (x_low + x_high)
+            + std::sqrt((1 - r * r) / (1 + r * r)) * draw(station, 0, middle);
+        if(chunk < middle) {
+            high = middle;
+            x_high = x_middle;
+        } else {
+            low = middle;
+            x_low = x_middle;
+        }
+    }
+    return (chunk == low) ? x_low : x_high;
+}
+
+void CloudCoverProcess::generate(
+    std::size_t station,
+    uint64_t chunk,
+    std::vector<double>& samples
+) const
+{
+    const std::vector<double>& powers = m_stations[station].powers;
+    const std::size_t size = CLOUD_COVER_CHUNK_SAMPLES;
+    double rho = powers[1];
+
+    samples.resize(size + 1);
+    samples[0] = getBound(station, chunk);
+    samples[size] = getBound(station, chunk + 1);
+
+    /* Sample k + 1 given sample k and the end of the chunk, m samples after k. */
+    for(std::size_t k = 0; k + 1 < size; k++) {
+        std::size_t m = size - k;
+        double end = 1 - powers[m] * powers[m];
+        double mean = rho * samples[k];
+        double variance = 1 - rho * rho;
+        if(end > 0) {
+            mean += (1 - rho * rho) * powers[m - 1] / end * (samples[size] - powers[m] * samples[k]);
+            variance *= (1 - powers[m - 1] * powers[m - 1]) / end;
+        }
+        samples[k + 1] = mean + std::sqrt(variance) * draw(station, 1, chunk * size + k);
+    }
+}
+
+bool CloudCoverProcess::getLatent(std::size_t station, double time, double& value) const
+{
+    if(station >= m_stations.size()) {
+        return false;
+    }
+
+    const uint64_t last = ((uint64_t)1 << CLOUD_COVER_LEVELS) * CLOUD_COVER_CHUNK_SAMPLES - 1;
+    double u = std::max(time, 0.0) / m_step;
+    uint64_t sample = (uint64_t)std::min(std::floor(u), (double)last);
+    double fraction = std::min(u - sample, 1.0);
+    uint64_t chunk = sample / CLOUD_COVER_CHUNK_SAMPLES;
+    std::size_t offset = sample % CLOUD_COVER_CHUNK_SAMPLES;
+    uint64_t key = ((uint64_t)station << CLOUD_COVER_LEVELS) | chunk;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::unordered_map<uint64_t, std::size_t>::const_iterator it = m_index.find(key);
+        if(it != m_index.end()) {
+            const Slot& entry = m_slots[it->second];
+            m_order.splice(m_order.begin(), m_order, entry.use);
+            m_hits++;
+            value = entry.samples[offset]
+                + fraction * (entry.samples[offset + 1] - entry.samples[offset]);
+            return true;
+        }
+    }
+
+    /* Generated out of the lock; a chunk generated twice by concurrent lookups is identical. */
+    std::vector<double> samples;
+    generate(station, chunk, samples);
+    value = samples[offset] + fraction * (samples[offset + 1] - samples[offset]);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_misses++;
+    if(m_index.find(key) != m_index.end()) {
+        return true;
+    }
+
+    /* A free slot while the cache is not full, the least recently used one afterwards. */
+    std::size_t slot = m_slots.size();
+    if(slot < m_capacity) {
+        m_order.push_front(slot);
+        m_slots.push_back(Slot{0, m_order.begin(), std::vector<double>()});
+    } else {
+        slot = m_order.back();
+        m_order.splice(m_order.begin(), m_order, m_slots[slot].use);
+        m_index.erase(m_slots[slot].key);
+    }
+    m_slots[slot].key = key;
+    m_slots[slot].samples.swap(samples);
+    m_index[key] = slot;
+    return true;
+}
+
+bool CloudCoverProcess::getCloud(
+    std::size_t station,
+    double time,
+    double& height,
+    double& wlc
+) const
+{
+    double value;
+
+    if(!getLatent(station, time, value)) {
+        return false;
+    }
+
+    const Station& entry = m_stations[station];
+    height = entry.parameters.height;
+    wlc = std::max(value - entry.threshold, 0.0) * entry.scale;
+    return true;
+}
+
+uint64_t CloudCoverProcess::getHits(void) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_hits;
+}
+
+uint64_t CloudCoverProcess::getMisses(void) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_misses;
+}
@@ -0,0 +1,193 @@
+/***********************************************************************************************//**
+ *  Stochastic cloud cover of ground stations, generated lazily in chunks of time
+ *  @class      CloudCoverProcess
+ *  @author     DSS-SIM development team, i2CAT
+ *  @date       2026-oct-16
+ *  @copyright  This code has been developed by Fundació Privada Internet i Innovació Digital a
+ *              Catalunya (i2CAT). i2CAT is a non-profit research and innovation centre that
+ *              promotes mission-driven knowledge to solve business challenges, co-create solutions
+ *              with a transformative impact, empower citizens through open and participative
+ *              digital social innovation with territorial capillarity, and promote pioneering and
+ *              strategic initiatives. i2CAT *aims to transfer* research project results to private
+ *              companies in order to create social and economic impact via the out-licensing of
+ *              intellectual property and the creation of spin-offs.
+ *              Find more information of i2CAT projects and IP rights at:
+ *              https://i2cat.net/tech-transfer/
+ **************************************************************************************************/
+
+#ifndef __CLOUD_COVER_PROCESS_HPP__
+#define __CLOUD_COVER_PROCESS_HPP__
+
+/* Global libraries */
+#include "dss.hpp"
+
+/* External libraries */
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#define CLOUD_COVER_CHUNK_SAMPLES   256     /**< Samples generated at once for a station */
+#define CLOUD_COVER_CACHE_CHUNKS    1024    /**< Default number of chunks kept in memory */
+#define CLOUD_COVER_LEVELS          32      /**< Chunks of the horizon, as a power of 2 */
+
+/***********************************************************************************************//**
+ * Climate of the cloud cover of a station.
+ **************************************************************************************************/
+struct CloudCoverParameters
+{
+    double probability;         /**< Fraction of the time the station is under a cloud */
+    double height;              /**< Thickness of the cloud layer (km) */
+    double wlc;                 /**< Mean liquid water content while under a cloud (g/m³) */
+    double correlation_time;    /**< Time for the correlation of the cover to fall by e (s) */
+};
+
+/***********************************************************************************************//**
+ * Time series of the cloud over each station, for the Clouds model.
+ *
+ * The weather of a station is a stationary Gaussian AR(1) (Ornstein-Uhlenbeck) process sampled at
+ * a fixed step: the station is under a cloud while the process is over the threshold that gives
+ * its probability of cover, with a liquid water content proportional to the excess over the
+ * threshold, scaled to the mean content of the parameters. Values between samples are linearly
+ * interpolated.
+ *
+ * The process is generated in chunks of CLOUD_COVER_CHUNK_SAMPLES samples, only when they are
+ * looked up, from a counter-based generator: every normal draw is a hash of the seed, the station
+ * and the index of the draw, so any time slice is the same whatever was generated before. The
+ * samples at the bounds of the chunks are drawn first, by bisection of the horizon: the value at
+ * the middle of an interval is drawn conditioned on its ends, which takes CLOUD_COVER_LEVELS draws
+ * for a bound. The samples in a chunk are then drawn conditioned on the previous sample and on the
+ * end of the chunk. Both are exact conditionals of the AR(1) process, so the series has the
+ * statistics of a sequential simulation.
+ *
+ * The most recently used chunks are kept in a LRU cache, so the memory is bounded by the active
+ * window. Lookups are const and can be done from several threads at once; chunks are generated
+ * out of the lock of the cache. Stations shall be added before the process is shared.
+ **************************************************************************************************/
+class CloudCoverProcess
+{
+public:
+    /*******************************************************************************************//**
+     * Constructs a process without stations.
+     *
+     * @param  seed         Seed of the generator
+     * @param  step         Time between samples (s)
+     * @param  cache_chunks Number of chunks kept in memory
+     **********************************************************************************************/
+    CloudCoverProcess(uint64_t seed, double step,
+        std::size_t cache_chunks = CLOUD_COVER_CACHE_CHUNKS);
+
+    /*******************************************************************************************//**
+     * Auto-generated destructor.
+     **********************************************************************************************/
+    ~CloudCoverProcess(void) = default;
+
+    CloudCoverProcess(const CloudCoverProcess&) = delete;
+    CloudCoverProcess& operator=(const CloudCoverProcess&) = delete;
+
+    /*******************************************************************************************//**
+     * Adds a station. Its series only depends on the seed, its index and its parameters.
+     *
+     * @param  parameters   Climate of the station
+     * @return              Index of the station
+     **********************************************************************************************/
+    std::size_t addStation(const CloudCoverParameters& parameters);
+
+    /*******************************************************************************************//**
+     * Retrieves the number of stations.
+     **********************************************************************************************/
+    std::size_t getNumStations(void) const { return m_stations.size(); }
+
+    /*******************************************************************************************//**
+     * Retrieves the standard normal process of a station, before the threshold.
+     *
+     * @param  station  Index of the station
+     * @param  time     Time from the start of the series (s); negative times are the start
+     * @param  value    Output value of the process
+     * @return          False if the station does not exist
+     **********************************************************************************************/
+    bool getLatent(std::size_t station, double time, double& value) const;
+
+    /*******************************************************************************************//**
+     * Retrieves the cloud over a station.
+     *
+     * @param  station  Index of the station
+     * @param  time     Time from the start of the series (s); negative times are the start
+     * @param  height   Output thickness of the cloud layer (km)
+     * @param  wlc      Output liquid water content, 0 without cloud (g/m³)
+     * @return          False if the station does not exist
+     **********************************************************************************************/
+    bool getCloud(std::size_t station, double time, double& height, double& wlc) const;
+
+    /*******************************************************************************************//**
+     * Retrieves the number of lookups served by the cached chunks.
+     **********************************************************************************************/
+    uint64_t getHits(void) const;
+
+    /*******************************************************************************************//**
+     * Retrieves the number of chunks generated.
+     **********************************************************************************************/
+    uint64_t getMisses(void) const;
+
+private:
+    /*******************************************************************************************//**
+     * Station and the constants derived from its parameters.
+     **********************************************************************************************/
+    struct Station
+    {
+        CloudCoverParameters parameters;    /**< Climate of the station */
+        double threshold;                   /**< Value of the process over which it is cloudy */
+        double scale;                       /**< Liquid water content per unit of excess */
+        double rate;                        /**< Inverse of the correlation time, per sample */
+        std::vector<double> powers;         /**< Correlation at 0 to CHUNK_SAMPLES samples */
+    };
+
+    /*******************************************************************************************//**
+     * Generated chunk of the cache.
+     **********************************************************************************************/
+    struct Slot
+    {
+        uint64_t key;                           /**< Station and chunk */
+        std::list<std::size_t>::iterator use;   /**< Position in the order of use */
+        std::vector<double> samples;            /**< Samples of the chunk and first of the next */
+    };
+
+    uint64_t m_seed;                                            /**< Seed of the generator */
+    double m_step;                                              /**< Time between samples (s) */
+    std::vector<Station> m_stations;                            /**< Stations */
+    std::size_t m_capacity;                                     /**< Maximum cached chunks */
+    mutable std::mutex m_mutex;                                 /**< Protects the cache */
+    mutable std::vector<Slot> m_slots;                          /**< Cached chunks */
+    mutable std::unordered_map<uint64_t, std::size_t> m_index;  /**< Slot of each cached chunk */
+    mutable std::list<std::size_t> m_order;                     /**< Slots, most recent first */
+    mutable uint64_t m_hits;                                    /**< Lookups of cached chunks */
+    mutable uint64_t m_misses;                                  /**< Chunks generated */
+
+    /*******************************************************************************************//**
+     * Draws the standard normal of a counter.
+     *
+     * @param  station  Index of the station
+     * @param  stream   0 for the bounds of the chunks, 1 for the samples inside them
+     * @param  counter  Index of the draw in the stream
+     **********************************************************************************************/
+    double draw(uint64_t station, uint64_t stream, uint64_t counter) const;
+
+    /*******************************************************************************************//**
+     * Computes the first sample of a chunk, by bisection of the horizon.
+     *
+     * @param  station  Index of the station
+     * @param  chunk    Index of the chunk
+     **********************************************************************************************/
+    double getBound(std::size_t station, uint64_t chunk) const;
+
+    /*******************************************************************************************//**
+     * Generates the samples of a chunk.
+     *
+     * @param  station  Index of the station
+     * @param  chunk    Index of the chunk
+     * @param  samples  Output samples of the chunk and first sample of the next one
+     **********************************************************************************************/
+    void generate(std::size_t station, uint64_t chunk, std::vector<double>& samples) const;
+};
+
+#endif /* __CLOUD_COVER_PROCESS_HPP__ */
@@ -0,0 +1,280 @@
+/***********************************************************************************************//**
+ *  Global gridded map of cloud height and liquid water content served from memory-mapped tiles
+ *  @class      CloudMap
+ *  @author     DSS-SIM development team, i2CAT
+ *  @date       2026-oct-16
+ *  @copyright  This code has been developed by Fundació Privada Internet i Innovació Digital a
+ *              Catalunya (i2CAT). i2CAT is a non-profit research and innovation centre that
+ *              promotes mission-driven knowledge to solve business challenges, co-create solutions
+ *              with a transformative impact, empower citizens through open and participative
+ *              digital social innovation with territorial capillarity, and promote pioneering and
+ *              strategic initiatives. i2CAT *aims to transfer* research project results to private
+ *              companies in order to create social and economic impact via the out-licensing of
+ *              intellectual property and the creation of spin-offs.
+ *              Find more information of i2CAT projects and IP rights at:
+ *              https://i2cat.net/tech-transfer/
+ **************************************************************************************************/
+
+#include "CloudMap.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+LOG_COMPONENT_DEFINE("CloudMap");
+
+#define CLOUD_MAP_MAGIC     "DSSCLOUD"  /**< Identifier of the map files */
+#define CLOUD_MAP_VERSION   1           /**< Version of the format */
+
+CloudMap::CloudMap(std::size_t cache_tiles)
+    : m_data(nullptr)
+    , m_size(0)
+    , m_capacity(std::max<std::size_t>((cache_tiles + CLOUD_MAP_CACHE_SHARDS - 1)
+        / CLOUD_MAP_CACHE_SHARDS, 1))
+    , m_shards(CLOUD_MAP_CACHE_SHARDS)
+{
+    std::memset(&m_header, 0, sizeof(m_header));
+    for(Shard& shard : m_shards) {
+        shard.hits = 0;
+        shard.misses = 0;
+    }
+}
+
+CloudMap::~CloudMap(void)
+{
+    close();
+}
+
+void CloudMap::close(void)
+{
+    if(m_data != nullptr) {
+        munmap(const_cast<uint8_t*>(m_data), m_size);
+    }
+    m_data = nullptr;
+    m_size = 0;
+    for(Shard& shard : m_shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.slots.clear();
+        shard.index.clear();
+        shard.order.clear();
+    }
+}
+
+bool CloudMap::open(const std::string& path)
+{
+    std::stringstream message;
+    struct stat info;
+
+    close();
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if(fd < 0 || fstat(fd, &info) != 0 || (std::size_t)info.st_size < sizeof(Header)) {
+        message << "Cloud map " << path << " cannot be read; it is not used.";
+        LOG_WARN(message.str());
+        if(fd >= 0) {
+            ::close(fd);
+        }
+        return false;
+    }
+
+    void* data = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if(data == MAP_FAILED) {
+        message << "Cloud map " << path << " cannot be mapped; it is not used.";
+        LOG_WARN(message.str());
+        return false;
+    }
+
+    /* Lookups land on scattered tiles, so read-ahead would only waste memory. */
+    madvise(data, info.st_size, MADV_RANDOM);
+
+    Header header;
+    std::memcpy(&header, data, sizeof(header));
+    /* The tiles shall cover the whole grid and lie inside the file. Sizes are compared by division,
+     * so that no product of header fields can overflow. */
+    uint64_t tiles = (uint64_t)header.tile_rows * header.tile_cols;
+    uint64_t file_size = info.st_size;
+    bool valid = std::memcmp(header.magic, CLOUD_MAP_MAGIC, sizeof(header.magic)) == 0
+        && header.version == CLOUD_MAP_VERSION && header.tile_size != 0 && header.rows != 0
+        && header.cols != 0
+        && (uint64_t)header.tile_rows * header.tile_size >= header.rows
+        && (uint64_t)header.tile_cols * header.tile_size >= header.cols
+        && header.tile_stride / (2 * sizeof(uint16_t)) / header.tile_size >= header.tile_size
+        && header.tile_stride % sizeof(uint16_t) == 0
+        && header.data_offset % sizeof(uint16_t) == 0
+        && header.data_offset >= sizeof(Header) && header.data_offset <= file_size
+        && header.tile_stride <= (file_size - header.data_offset) / tiles;
+    if(!valid) {
+        message << "Cloud map " << path << " is not a valid map; it is not used.";
+        LOG_WARN(message.str());
+        munmap(data, info.st_size);
+        return false;
+    }
+
+    m_header = header;
+    m_data = static_cast<const uint8_t*>(data);
+    m_size = info.st_size;
+    return true;
+}
+
+const CloudMap::Slot& CloudMap::getTile(Shard& shard, uint64_t tile) const
+{
+    std::unordered_map<uint64_t, std::size_t>::const_iterator it = shard.index.find(tile);
+
+    if(it != shard.index.end()) {
+        Slot& entry = shard.slots[it->second];
+        shard.order.splice(shard.order.begin(), shard.order, entry.use);
+        shard.hits++;
+        return entry;
+    }
+
+    /* A free slot while the part is not full, the least recently used one afterwards. */
+    std::size_t slot = shard.slots.size();
+    if(slot < m_capacity) {
+        shard.order.push_front(slot);
+        shard.slots.push_back(Slot{0, shard.order.begin(), std::vector<float>()});
+    } else {
+        slot = shard.order.back();
+        shard.order.splice(shard.order.begin(), shard.order, shard.slots[slot].use);
+        shard.index.erase(shard.slots[slot].tile);
+    }
+
+    Slot& entry = shard.slots[slot];
+    std::size_t cells = (std::size_t)m_header.tile_size * m_header.tile_size;
+    const uint16_t* raw = reinterpret_cast<const uint16_t*>(m_data + m_header.data_offset
+        + tile * m_header.tile_stride);
+
+    entry.tile = tile;
+    entry.cells.resize(2 * cells);
+    for(std::size_t i = 0; i < cells; i++) {
+        entry.cells[2 * i] = raw[2 * i] * m_header.height_scale;
+        entry.cells[2 * i + 1] = raw[2 * i + 1] * m_header.wlc_scale;
+    }
+    shard.index[tile] = slot;
+    shard.misses++;
+    return entry;
+}
+
+bool CloudMap::lookup(double latitude, double longitude, double& height, double& wlc) const
+{
+    if(m_data == nullptr) {
+        return false;
+    }
+
+    double pi = Globals::constants.pi;
+    double u = (latitude + pi / 2) / pi * m_header.rows;
+    double v = (longitude + pi) / (2 * pi) * m_header.cols;
+    uint64_t row = (uint64_t)std::min(std::max(u, 0.0), m_header.rows - 1.0);
+    int64_t col = (int64_t)std::floor(v) % (int64_t)m_header.cols;
+    if(col < 0) {
+        col += m_header.cols;
+    }
+
+    uint64_t size = m_header.tile_size;
+    uint64_t tile = (row / size) * m_header.tile_cols + col / size;
+    std::size_t cell = (row % size) * size + col % size;
+
+    /* Neighbouring tiles fall in different parts, so threads looking up nearby links do not
+     * wait for each other. */
+    Shard& shard = m_shards[tile % CLOUD_MAP_CACHE_SHARDS];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    const Slot& slot = getTile(shard, tile);
+    height = slot.cells[2 * cell];
+    wlc = slot.cells[2 * cell + 1];
+    return true;
+}
+
+uint64_t CloudMap::getHits(void) const
+{
+    uint64_t hits = 0;
+
+    for(Shard& shard : m_shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        hits += shard.hits;
+    }
+    return hits;
+}
+
+uint64_t CloudMap::getMisses(void) const
+{
+    uint64_t misses = 0;
+
+    for(Shard& shard : m_shards) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        misses += shard.misses;
+    }
+    return misses;
+}
+
+bool CloudMap::write(
+    const std::string& path,
+    std::size_t rows,
+    std::size_t cols,
+    const std::vector<float>& height,
+    const std::vector<float>& wlc,
+    std::size_t tile_size
+)
+{
+    if(rows == 0 || cols == 0 || tile_size == 0 || height.size() != rows * cols
+        || wlc.size() != rows * cols) {
+        LOG_WARN("The cloud map fields shall have rows x cols cells; the map is not written.");
+        return false;
+    }
+
+    Header header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, CLOUD_MAP_MAGIC, sizeof(header.magic));
+    header.version = CLOUD_MAP_VERSION;
+    header.tile_size = tile_size;
+    header.rows = rows;
+    header.cols = cols;
+    header.tile_rows = (rows + tile_size - 1) / tile_size;
+    header.tile_cols = (cols + tile_size - 1) / tile_size;
+    header.height_scale = std::max(*std::max_element(height.begin(), height.end()), 0.0f) / 65535;
+    header.wlc_scale = std::max(*std::max_element(wlc.begin(), wlc.end()), 0.0f) / 65535;
+    header.data_offset = CLOUD_MAP_ALIGNMENT;
+    header.tile_stride = (tile_size * tile_size * 2 * sizeof(uint16_t) + CLOUD_MAP_ALIGNMENT - 1)
+        / CLOUD_MAP_ALIGNMENT * CLOUD_MAP_ALIGNMENT;
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    std::vector<char> padding(header.data_offset - sizeof(header), 0);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(padding.data(), padding.size());
+
+    /* Cells out of the grid, in the last row and column of tiles, are left at 0. */
+    std::vector<uint16_t> tile(header.tile_stride / sizeof(uint16_t));
+    for(std::size_t ti = 0; ti < header.tile_rows; ti++) {
+        for(std::size_t tj = 0; tj < header.tile_cols; tj++) {
+            std::fill(tile.begin(), tile.end(), 0);
+            for(std::size_t i = 0; i < tile_size && ti * tile_size + i < rows; i++) {
+                for(std::size_t j = 0; j < tile_size && tj * tile_size + j < cols; j++) {
+                    std::size_t source = (ti * tile_size + i) * cols + tj * tile_size + j;
+                    std::size_t cell = i * tile_size + j;
+                    if(header.height_scale > 0) {
+                        tile[2 * cell] = std::lround(std::max(height[source], 0.0f)
+                            / header.height_scale);
+                    }
+                    if(header.wlc_scale > 0) {
+                        tile[2 * cell + 1] = std::lround(std::max(wlc[source], 0.0f)
+                            / header.wlc_scale);
+                    }
+                }
+            }
+            file.write(reinterpret_cast<const char*>(tile.data()), header.tile_stride);
+        }
+    }
+
+    if(!file) {
+        std::stringstream message;
+        message << "Cloud map " << path << " cannot be written.";
+        LOG_WARN(message.str());
+        return false;
+    }
+    return true;
+}
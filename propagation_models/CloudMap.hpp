@@ -0,0 +1,184 @@
+/***********************************************************************************************//**
+ *  Global gridded map of cloud height and liquid water content served from memory-mapped tiles
+ *  @class      CloudMap
+ *  @author     DSS-SIM development team, i2CAT
+ *  @date       2026-oct-16
+ *  @copyright  This code has been developed by Fundació Privada Internet i Innovació Digital a
+ *              Catalunya (i2CAT). i2CAT is a non-profit research and innovation centre that
+ *              promotes mission-driven knowledge to solve business challenges, co-create solutions
+ *              with a transformative impact, empower citizens through open and participative
+ *              digital social innovation with territorial capillarity, and promote pioneering and
+ *              strategic initiatives. i2CAT *aims to transfer* research project results to private
+ *              companies in order to create social and economic impact via the out-licensing of
+ *              intellectual property and the creation of spin-offs.
+ *              Find more information of i2CAT projects and IP rights at:
+ *              https://i2cat.net/tech-transfer/
+ **************************************************************************************************/
+
+#ifndef __CLOUD_MAP_HPP__
+#define __CLOUD_MAP_HPP__
+
+/* Global libraries */
+#include "dss.hpp"
+
+/* External libraries */
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#define CLOUD_MAP_TILE_SIZE     16      /**< Default cells per tile edge */
+#define CLOUD_MAP_CACHE_TILES   1024    /**< Default number of decoded tiles kept in memory */
+#define CLOUD_MAP_CACHE_SHARDS  16      /**< Parts of the tile cache, each with its own lock */
+#define CLOUD_MAP_ALIGNMENT     64      /**< Alignment of the tiles in the file (bytes) */
+
+/***********************************************************************************************//**
+ * Global map of the height of the cloud layer and of its liquid water content, on a regular
+ * latitude/longitude grid, as derived from ITU-R P.840 maps (or generated for tests with write).
+ *
+ * The file holds a 64-byte header followed by square tiles of cells, each tile starting at a
+ * multiple of CLOUD_MAP_ALIGNMENT bytes. Every cell stores both fields as 16-bit integers scaled by
+ * the factors of the header, in the byte order of the machine. The file is memory-mapped, so only
+ * the tiles that are looked up are read from disk, whatever the size of the map. The most recently
+ * used tiles are kept decoded in a small LRU cache, so a lookup is normally a hash lookup and an
+ * indexed read.
+ *
+ * Lookups are const and can be done from several threads at once. The cache is split by tile in
+ * CLOUD_MAP_CACHE_SHARDS parts, each with its own mutex and LRU order, so concurrent lookups only
+ * wait for each other when their tiles fall in the same part. open and close shall not be called
+ * while other threads look up the map.
+ **************************************************************************************************/
+class CloudMap
+{
+public:
+    /*******************************************************************************************//**
+     * Constructs an empty map.
+     *
+     * @param  cache_tiles  Number of decoded tiles kept in memory, shared among the parts of the
+     *                      cache
+     **********************************************************************************************/
+    CloudMap(std::size_t cache_tiles = CLOUD_MAP_CACHE_TILES);
+
+    /*******************************************************************************************//**
+     * Destructor. It unmaps the file.
+     **********************************************************************************************/
+    ~CloudMap(void);
+
+    CloudMap(const CloudMap&) = delete;
+    CloudMap& operator=(const CloudMap&) = delete;
+
+    /*******************************************************************************************//**
+     * Maps a file. A previously mapped file is released.
+     *
+     * @param  path     Path of the file
+     * @return          False if the file cannot be mapped or is not a valid map
+     **********************************************************************************************/
+    bool open(const std::string& path);
+
+    /*******************************************************************************************//**
+     * Checks if a file is mapped.
+     **********************************************************************************************/
+    bool isOpen(void) const { return m_data != nullptr; }
+
+    /*******************************************************************************************//**
+     * Retrieves the cloud at a point, from the cell that holds it.
+     *
+     * @param  latitude     Latitude (rad)
+     * @param  longitude    Longitude, positive to the East (rad)
+     * @param  height       Output thickness of the cloud layer (km)
+     * @param  wlc          Output liquid water content (g/m³)
+     * @return              False if no file is mapped
+     **********************************************************************************************/
+    bool lookup(double latitude, double longitude, double& height, double& wlc) const;
+
+    /*******************************************************************************************//**
+     * Retrieves the number of lookups served by the decoded tiles.
+     **********************************************************************************************/
+    uint64_t getHits(void) const;
+
+    /*******************************************************************************************//**
+     * Retrieves the number of lookups that had to decode a tile.
+     **********************************************************************************************/
+    uint64_t getMisses(void) const;
+
+    /*******************************************************************************************//**
+     * Writes a map file.
+     *
+     * @param  path         Path of the file
+     * @param  rows         Cells in latitude, from the South pole
+     * @param  cols         Cells in longitude, from -180 deg
+     * @param  height       Thickness of the cloud layer of each cell, row by row (km)
+     * @param  wlc          Liquid water content of each cell, row by row (g/m³)
+     * @param  tile_size    Cells per tile edge
+     * @return              False if the file cannot be written
+     **********************************************************************************************/
+    static bool write(const std::string& path, std::size_t rows, std::size_t cols,
+        const std::vector<float>& height, const std::vector<float>& wlc,
+        std::size_t tile_size = CLOUD_MAP_TILE_SIZE);
+
+private:
+    /*******************************************************************************************//**
+     * Header of a map file.
+     **********************************************************************************************/
+    struct Header
+    {
+        char magic[8];          /**< "DSSCLOUD" */
+        uint32_t version;       /**< Version of the format */
+        uint32_t tile_size;     /**< Cells per tile edge */
+        uint32_t rows;          /**< Cells in latitude */
+        uint32_t cols;          /**< Cells in longitude */
+        uint32_t tile_rows;     /**< Tiles in latitude */
+        uint32_t tile_cols;     /**< Tiles in longitude */
+        float height_scale;     /**< Thickness of one unit of the stored heights (km) */
+        float wlc_scale;        /**< Content of one unit of the stored contents (g/m³) */
+        uint64_t data_offset;   /**< Offset of the first tile (bytes) */
+        uint64_t tile_stride;   /**< Distance between tiles (bytes) */
+        uint8_t reserved[8];    /**< Padding to 64 bytes */
+    };
+
+    /*******************************************************************************************//**
+     * Decoded tile of the cache.
+     **********************************************************************************************/
+    struct Slot
+    {
+        uint64_t tile;                          /**< Index of the tile */
+        std::list<std::size_t>::iterator use;   /**< Position in the order of use */
+        std::vector<float> cells;               /**< Height and content of each cell, interleaved */
+    };
+
+    /*******************************************************************************************//**
+     * Part of the cache, holding the tiles whose index modulo CLOUD_MAP_CACHE_SHARDS is its own.
+     **********************************************************************************************/
+    struct Shard
+    {
+        std::mutex mutex;                                   /**< Protects the part */
+        std::vector<Slot> slots;                            /**< Decoded tiles */
+        std::unordered_map<uint64_t, std::size_t> index;    /**< Slot of each decoded tile */
+        std::list<std::size_t> order;                       /**< Slots, most recent first */
+        uint64_t hits;                                      /**< Lookups of decoded tiles */
+        uint64_t misses;                                    /**< Tiles decoded */
+    };
+
+    Header m_header;                        /**< Header of the mapped file */
+    const uint8_t* m_data;                  /**< Mapped file */
+    std::size_t m_size;                     /**< Size of the mapped file */
+    std::size_t m_capacity;                 /**< Maximum decoded tiles of each part */
+    mutable std::vector<Shard> m_shards;    /**< Parts of the cache */
+
+    /*******************************************************************************************//**
+     * Releases the mapped file and the cache.
+     **********************************************************************************************/
+    void close(void);
+
+    /*******************************************************************************************//**
+     * Retrieves the slot of a decoded tile, decoding it (and evicting the least recently used
+     * one of its part) if needed. The part shall be locked.
+     *
+     * @param  shard    Part of the cache of the tile
+     * @param  tile     Index of the tile
+     **********************************************************************************************/
+    const Slot& getTile(Shard& shard, uint64_t tile) const;
+};
+
+#endif /* __CLOUD_MAP_HPP__ */
@@ -17,11 +17,29 @@
 
 #include "Clouds.hpp"
 
+#include <algorithm>
+
 LOG_COMPONENT_DEFINE("Clouds");
 
 Clouds::Clouds(double temp)
-    : m_temp(temp)
-{}
+    : m_dist_travel(0)
+    , m_temp(temp)
+    , m_freq_min(0)
+    , m_angle(0)
+    , m_freq(0)
+    , m_att(0)
+    , m_coefficients(temp)
+    , m_gmst(0)
+    , m_station(0)
+    , m_time(0)
+    , m_weather(0)
+    , m_elevation_epsilon(CLOUDS_ELEVATION_EPSILON)
+    , m_link_hits(0)
+    , m_link_misses(0)
+{
+    /* The cloud is fixed from construction, so the const methods can rely on it. */
+    setCloud();
+}
 
 void Clouds::setCloud()
 {
@@ -30,6 +48,35 @@ void Clouds::setCloud()
     m_wlc     = fog[1];
 }
 
+void Clouds::getCloudAt(
+    const ECICoordinates& body1,
+    const ECICoordinates& body2,
+    double& height,
+    double& wlc
+) const
+{
+    height = m_h_cloud;
+    wlc = m_wlc;
+    if(m_cloud_cover != nullptr) {
+        m_cloud_cover->getCloud(m_station, m_time, height, wlc);
+        return;
+    }
+    if(m_cloud_map == nullptr) {
+        return;
+    }
+
+    double r1 = body1.x * body1.x + body1.y * body1.y + body1.z * body1.z;
+    double r2 = body2.x * body2.x + body2.y * body2.y + body2.z * body2.z;
+    const ECICoordinates& ground = (r1 <= r2) ? body1 : body2;
+
+    /* Geodetic latitude of a point on the surface of the ellipsoid. */
+    double e2 = CLOUDS_WGS84_FLATTENING * (2 - CLOUDS_WGS84_FLATTENING);
+    double latitude = std::atan2(ground.z,
+        (1 - e2) * std::sqrt(ground.x * ground.x + ground.y * ground.y));
+    double longitude = std::atan2(ground.y, ground.x) - m_gmst;
+    m_cloud_map->lookup(latitude, longitude, height, wlc);
+}
+
 bool Clouds::isValid(ECICoordinates body1, ECICoordinates body2)
 {
     /* Checks if both bodies are the same. */
@@ -37,7 +84,7 @@ bool Clouds::isValid(ECICoordinates body1, ECICoordinates body2)
         return false;
     }
 
-    double down_bound = (10 * (Globals::constants.pi / 180));
+    double down_bound = (CLOUDS_MIN_ELEVATION * (Globals::constants.pi / 180));
     ns3::Vector src = CoordinateSystemUtils::fromECIToNS3Vector(body1);
     ns3::Vector dest = CoordinateSystemUtils::fromECIToNS3Vector(body2);
     double src_norm = src.GetLength();
@@ -61,24 +108,32 @@ bool Clouds::isValid(ECICoordinates body1, ECICoordinates body2)
     }
 }
 
-void Clouds::getDistanceGsSat()
+bool Clouds::isValid(double elevation)
+{
+    /* Same angle as the one computed from the ECI positions. */
+    m_angle = std::fabs(elevation);
+    return m_angle > (CLOUDS_MIN_ELEVATION * (Globals::constants.pi / 180));
+}
+
+void Clouds::getDistanceGsSat(double height)
 {
-    m_dist_travel = m_h_cloud / std::sin(m_angle);
+    m_dist_travel = height / std::sin(m_angle);
 
 }
 
-double Clouds::getAttCoeff(double freq)
+double Clouds::getAttCoeff(double freq) const
 {
     double k1 = 0;         /**< Benoit's extintion coeficient [dB/Km]/[g/m³]. */
-    k1 = std::pow(freq, BENOIT_CONSTANT_A1) * 
-         std::exp(BENOIT_CONSTANT_A2 * (1 + BENOIT_CONSTANT_A3 * m_temp)); 
+    if(!m_coefficients.lookup(freq, k1)) {
+        k1 = BenoitCoefficientTable::compute(freq, m_temp);
+    }
     return k1;
 }
 
-double Clouds::getExtCoeff(double k1)
+double Clouds::getExtCoeff(double k1, double wlc) const
 {
     double kex = 0;    /**< Extintion coeficient [dB/Km] */
-    kex = k1 * m_wlc;
+    kex = k1 * wlc;
     return kex;
 }
 
@@ -89,13 +144,13 @@ void Clouds::getCloudsAttdB(
     double min_freq
 )
 {
-    double k1, kex, att;
+    double k1, kex, att, height, wlc;
     bool visivility;    
     m_src = src;
     m_freq = m_src->getFrequency();
 
-    /* Setting up of the cloud parameters. */
-    setCloud();
+    /* Setting up of the cloud parameters, without touching the fixed fog layer. */
+    getCloudAt(body1, body2, height, wlc);
     /* Setting up the minimum frequency to perform the model. */
     setMinFrequency(min_freq);
     /* Check the angle of visivility to be high enough. */
@@ -106,13 +161,187 @@ void Clouds::getCloudsAttdB(
         m_att = 0;
     } else {
         k1  = getAttCoeff(src->getFrequency());
-        kex = getExtCoeff(k1);
-        getDistanceGsSat();
+        kex = getExtCoeff(k1, wlc);
+        getDistanceGsSat(height);
         att =  kex * m_dist_travel;
         m_att = att;
     }
 }
 
+void Clouds::getCloudsAttdB(
+    ns3::Ptr<SpaceNetDevice> src,
+    double elevation,
+    double min_freq
+)
+{
+    double height = m_h_cloud;
+    double wlc = m_wlc;
+    m_src = src;
+    m_freq = m_src->getFrequency();
+    if(m_cloud_cover != nullptr) {
+        m_cloud_cover->getCloud(m_station, m_time, height, wlc);
+    }
+    setMinFrequency(min_freq);
+
+    if(isValid(elevation) == false || m_freq < m_freq_min) {
+        m_att = 0;
+    } else {
+        getDistanceGsSat(height);
+        m_att = getExtCoeff(getAttCoeff(m_freq), wlc) * m_dist_travel;
+    }
+}
+
+void Clouds::getCloudsAttdB(
+    ns3::Ptr<SpaceNetDevice> src,
+    const ECICoordinates& ground,
+    double elevation,
+    double min_freq
+)
+{
+    double height, wlc;
+    m_src = src;
+    m_freq = m_src->getFrequency();
+    /* The ground station is the lower end of any of its links. */
+    getCloudAt(ground, ground, height, wlc);
+    setMinFrequency(min_freq);
+
+    if(isValid(elevation) == false || m_freq < m_freq_min) {
+        m_att = 0;
+    } else {
+        getDistanceGsSat(height);
+        m_att = getExtCoeff(getAttCoeff(m_freq), wlc) * m_dist_travel;
+    }
+}
+
+double Clouds::getElevationSine(const ECICoordinates& body1, const ECICoordinates& body2)
+{
+    /* The angle of isValid is asin(|cos|), with cos the cosine between the link and the position
+     * of the first body, so the check and the distance only need |cos|. */
+    double dx = body2.x - body1.x;
+    double dy = body2.y - body1.y;
+    double dz = body2.z - body1.z;
+    double diff2 = dx * dx + dy * dy + dz * dz;
+    double src2 = body1.x * body1.x + body1.y * body1.y + body1.z * body1.z;
+    double sine = std::fabs(dx * body1.x + dy * body1.y + dz * body1.z) / std::sqrt(diff2 * src2);
+
+    return (diff2 > 0) ? sine : 0.0;
+}
+
+double Clouds::getSlantFactor(
+    const ECICoordinates& body1,
+    const ECICoordinates& body2,
+    double sin_min
+)
+{
+    double sine = getElevationSine(body1, body2);
+
+    return (sine > sin_min) ? 1.0 / sine : 0.0;
+}
+
+void Clouds::getCloudsAttdB(
+    const ECICoordinates* body1,
+    const ECICoordinates* body2,
+    const double* freq,
+    std::size_t count,
+    double min_freq,
+    double* att
+) const
+{
+    double sin_min = std::sin(CLOUDS_MIN_ELEVATION * (Globals::constants.pi / 180));
+
+    if(m_cloud_map == nullptr && m_cloud_cover == nullptr) {
+        /* The coefficients are looked up first, into the output, so the geometry loop does not
+         * search the frequency tables. */
+        for(std::size_t i = 0; i < count; i++) {
+            att[i] = (freq[i] < min_freq) ? 0.0 : getExtCoeff(getAttCoeff(freq[i]), m_wlc);
+        }
+        for(std::size_t i = 0; i < count; i++) {
+            att[i] *= m_h_cloud * getSlantFactor(body1[i], body2[i], sin_min);
+        }
+        return;
+    }
+
+    double height, wlc;
+    for(std::size_t i = 0; i < count; i++) {
+        double factor = getSlantFactor(body1[i], body2[i], sin_min);
+        if(freq[i] < min_freq || factor == 0) {
+            att[i] = 0;
+            continue;
+        }
+        getCloudAt(body1[i], body2[i], height, wlc);
+        att[i] = getAttCoeff(freq[i]) * wlc * height * factor;
+    }
+}
+
+void Clouds::getCloudsAttdB(
+    const ECICoordinates& body1,
+    const ECICoordinates* body2,
+    std::size_t count,
+    double freq,
+    double min_freq,
+    double* att
+) const
+{
+    double sin_min = std::sin(CLOUDS_MIN_ELEVATION * (Globals::constants.pi / 180));
+
+    if(m_cloud_map == nullptr && m_cloud_cover == nullptr) {
+        double kex = (freq < min_freq) ? 0.0 : getExtCoeff(getAttCoeff(freq), m_wlc);
+        for(std::size_t i = 0; i < count; i++) {
+            att[i] = kex * m_h_cloud * getSlantFactor(body1, body2[i], sin_min);
+        }
+        return;
+    }
+
+    double k1 = (freq < min_freq) ? 0.0 : getAttCoeff(freq);
+    double height, wlc;
+    for(std::size_t i = 0; i < count; i++) {
+        double factor = getSlantFactor(body1, body2[i], sin_min);
+        if(k1 == 0 || factor == 0) {
+            att[i] = 0;
+            continue;
+        }
+        getCloudAt(body1, body2[i], height, wlc);
+        att[i] = k1 * wlc * height * factor;
+    }
+}
+
+void Clouds::getCloudsAttdB(
+    uint64_t link,
+    const ECICoordinates& body1,
+    const ECICoordinates& body2,
+    double freq,
+    double min_freq
+)
+{
+    double elevation = std::asin(std::min(getElevationSine(body1, body2), 1.0));
+    std::unordered_map<uint64_t, LinkState>::iterator it = m_links.find(link);
+
+    double min_elevation = CLOUDS_MIN_ELEVATION * (Globals::constants.pi / 180);
+
+    /* The elevation is compared with the one of the last computation, not of the last call, so
+     * a slow drift still triggers the recomputation. Crossing the minimum elevation of the model
+     * always does. */
+    if(it != m_links.end() && it->second.freq == freq && it->second.min_freq == min_freq
+        && it->second.weather == m_weather
+        && std::fabs(elevation - it->second.elevation) <= m_elevation_epsilon
+        && (elevation > min_elevation) == (it->second.elevation > min_elevation)) {
+        m_link_hits++;
+        m_att = it->second.att;
+        return;
+    }
+
+    m_link_misses++;
+    getCloudsAttdB(&body1, &body2, &freq, 1, min_freq, &m_att);
+    m_links[link] = LinkState{elevation, freq, min_freq, m_weather, m_att};
+}
+
+void Clouds::clearLinkCache(void)
+{
+    m_links.clear();
+    m_link_hits = 0;
+    m_link_misses = 0;
+}
+
 double Clouds::DoCalcRxPower(
     double tx_power,
     ns3::Ptr<ns3::MobilityModel> src,
@@ -23,14 +23,19 @@
 
 /* External libraries */
 #include <ns3/propagation-loss-model.h>
+#include <memory>
+#include <unordered_map>
 
 /* Internal libraries */
 #include "SpaceNetDevice.hpp"
 #include "CoordinateSystemUtils.hpp"
+#include "BenoitCoefficientTable.hpp"
+#include "CloudMap.hpp"
+#include "CloudCoverProcess.hpp"
 
-#define BENOIT_CONSTANT_A1 1.95      /**< Constant from Benoit's empirical expression. */
-#define BENOIT_CONSTANT_A2 -6.866    /**< Constant from Benoit's empirical expression. */
-#define BENOIT_CONSTANT_A3 4.5e-3    /**< Constant from Benoit's empirical expression. */
+#define CLOUDS_MIN_ELEVATION 10.0    /**< Minimum elevation for the model to be valid (deg). */
+#define CLOUDS_WGS84_FLATTENING (1.0 / 298.257223563)    /**< WGS84 flattening. */
+#define CLOUDS_ELEVATION_EPSILON 1e-3   /**< Default elevation change to recompute a link (rad). */
 
 /**********************************************************************************************//**
  *  Attenuation in the link between a ground station and a body_2 (and viceversa) caused by clouds.
@@ -76,6 +81,216 @@ public:
         double min_freq
     );
 
+    /******************************************************************************************//**
+     *  Same as the previous method, but the geometry of the link is given by the elevation of the
+     *  satellite over the horizon of the ground station, as computed for a whole constellation by
+     *  TopocentricTransform. It avoids recomputing the angle between both bodies link by link.
+     *  Without the position of the ground station, the cloud is taken from the cloud cover process
+     *  if it is set, else the fixed fog layer: the cloud map is not used (see the next method).
+     *
+     *  @param src         SpaceNetdevice used to know the frequency.
+     *  @param elevation   Elevation of the satellite seen from the ground station (rad).
+     *  @param min_freq    Minimum frequency to allow the method to be useful.
+     *********************************************************************************************/
+    void getCloudsAttdB(
+        ns3::Ptr<SpaceNetDevice> src,
+        double elevation,
+        double min_freq
+    );
+
+    /******************************************************************************************//**
+     *  Same as the previous method, with the position of the ground station, so the cloud is
+     *  looked up in the cloud map (at the time given by setGMST) when no cloud cover process is
+     *  set.
+     *
+     *  @param src         SpaceNetdevice used to know the frequency.
+     *  @param ground      ECICoordinates of the ground station.
+     *  @param elevation   Elevation of the satellite seen from the ground station (rad).
+     *  @param min_freq    Minimum frequency to allow the method to be useful.
+     *********************************************************************************************/
+    void getCloudsAttdB(
+        ns3::Ptr<SpaceNetDevice> src,
+        const ECICoordinates& ground,
+        double elevation,
+        double min_freq
+    );
+
+    /******************************************************************************************//**
+     *  Batch version of the previous methods. It computes the attenuation of many links at once
+     *  and does not modify the model, so a single instance can be shared by concurrent links and
+     *  threads and the result does not depend on the order of the calls. The coefficient of each
+     *  link is looked up first; the validity check and the distance inside the cloud are then
+     *  computed in a second loop, without table lookups nor trigonometric functions. With a cloud
+     *  map or a cloud cover process, the cloud of each valid link is looked up in it.
+     *
+     *  @param body1       ECICoordinates of the first body of each link.
+     *  @param body2       ECICoordinates of the second body of each link.
+     *  @param freq        Frequency of each link.
+     *  @param count       Number of links.
+     *  @param min_freq    Minimum frequency to allow the method to be useful.
+     *  @param att         Output attenuation of each link (dB).
+     *********************************************************************************************/
+    void getCloudsAttdB(
+        const ECICoordinates* body1,
+        const ECICoordinates* body2,
+        const double* freq,
+        std::size_t count,
+        double min_freq,
+        double* att
+    ) const;
+
+    /******************************************************************************************//**
+     *  Same as the previous method, for the fan-out of one transmission: one source, one
+     *  frequency and many receivers. The frequency-dependent coefficient is computed once.
+     *
+     *  @param body1       ECICoordinates of the source.
+     *  @param body2       ECICoordinates of each receiver.
+     *  @param count       Number of receivers.
+     *  @param freq        Frequency of the transmission.
+     *  @param min_freq    Minimum frequency to allow the method to be useful.
+     *  @param att         Output attenuation of each link (dB).
+     *********************************************************************************************/
+    void getCloudsAttdB(
+        const ECICoordinates& body1,
+        const ECICoordinates* body2,
+        std::size_t count,
+        double freq,
+        double min_freq,
+        double* att
+    ) const;
+
+    /******************************************************************************************//**
+     *  Precomputes the attenuation coefficient of a frequency band of the scenario, so the
+     *  attenuation of its links is computed without transcendental functions. Bands shall be
+     *  added before the model is shared between threads.
+     *
+     *  @param freq    Frequency of the band, as given by SpaceNetDevice::getFrequency.
+     *********************************************************************************************/
+    void addFrequencyBand(double freq)
+    {
+        m_coefficients.addFrequency(freq);
+        m_weather++;
+    }
+
+    /******************************************************************************************//**
+     *  Precomputes the attenuation coefficient over a frequency range, for frequencies swept
+     *  continuously. It is interpolated, with the relative error given by getSweepErrorBound.
+     *
+     *  @param min_freq    Lowest frequency of the range.
+     *  @param max_freq    Highest frequency of the range.
+     *  @param points      Number of points of the table.
+     *********************************************************************************************/
+    void setFrequencySweep(double min_freq, double max_freq, std::size_t points)
+    {
+        m_coefficients.setSweep(min_freq, max_freq, points);
+        m_weather++;
+    }
+
+    /******************************************************************************************//**
+     *  Retrieves the bound of the relative error of the coefficients of the frequency sweep.
+     *********************************************************************************************/
+    double getSweepErrorBound(void) const { return m_coefficients.getErrorBound(); }
+
+    /******************************************************************************************//**
+     *  Sets a global map of cloud height and liquid water content. The cloud of each link is then
+     *  taken from the map at the ground end of the link instead of the fixed fog layer. The map
+     *  can be shared by several models and threads.
+     *
+     *  @param map     Opened map, or nullptr to go back to the fixed fog layer.
+     *********************************************************************************************/
+    void setCloudMap(std::shared_ptr<const CloudMap> map)
+    {
+        m_cloud_map = map;
+        m_weather++;
+    }
+
+    /******************************************************************************************//**
+     *  Sets the Greenwich mean sidereal time of the next links, used to find the longitude of
+     *  their ground end in the cloud map (e.g. from TopocentricTransform::getGMST).
+     *
+     *  @param gmst    Greenwich mean sidereal time (rad).
+     *********************************************************************************************/
+    void setGMST(double gmst) { m_gmst = gmst; }
+
+    /******************************************************************************************//**
+     *  Sets the time-varying cloud cover of the ground station of the links. The cloud is then
+     *  taken from the process at the time given by setTime, instead of the cloud map or the fixed
+     *  fog layer. The process can be shared by the models of several stations and threads.
+     *
+     *  @param process  Cloud cover process, or nullptr to stop using it.
+     *  @param station  Index of the ground station in the process.
+     *********************************************************************************************/
+    void setCloudCover(std::shared_ptr<const CloudCoverProcess> process, std::size_t station)
+    {
+        m_cloud_cover = process;
+        m_station = station;
+        m_weather++;
+    }
+
+    /******************************************************************************************//**
+     *  Sets the time of the next links in the cloud cover process. A new time invalidates the
+     *  cached attenuations when the process is used, so it should be set at the step of the
+     *  weather rather than at every event.
+     *
+     *  @param time    Time from the start of the process (s).
+     *********************************************************************************************/
+    void setTime(double time)
+    {
+        if(m_cloud_cover != nullptr && time != m_time) {
+            m_weather++;
+        }
+        m_time = time;
+    }
+
+    /******************************************************************************************//**
+     *  Incremental version of the methods above for links evaluated repeatedly. The elevation and
+     *  the attenuation of each link are cached, and the attenuation is only recomputed when the
+     *  elevation has moved more than the tolerance since it was computed, or the frequency or the
+     *  weather (cloud map, cloud cover or its time, frequency tables) has changed. The result is
+     *  also retrieved by getAtt. The cache belongs to the instance, which shall not be shared
+     *  between threads while this method is used.
+     *
+     *  As the distance inside the cloud is proportional to 1 / sin(elevation), the relative error
+     *  of a cached attenuation is at most about tolerance / tan(elevation), e.g. 0.6 % at 10 deg
+     *  with the default tolerance.
+     *
+     *  @param link        Identifier of the link, chosen by the caller.
+     *  @param body1       ECICoordinates of the first body.
+     *  @param body2       ECICoordinates of the second body.
+     *  @param freq        Frequency of the link.
+     *  @param min_freq    Minimum frequency to allow the method to be useful.
+     *********************************************************************************************/
+    void getCloudsAttdB(
+        uint64_t link,
+        const ECICoordinates& body1,
+        const ECICoordinates& body2,
+        double freq,
+        double min_freq
+    );
+
+    /******************************************************************************************//**
+     *  Sets the change of elevation of a link that triggers the recomputation of its attenuation
+     *  by the incremental method. 0 recomputes it at every change.
+     *
+     *  @param epsilon    Tolerance of the elevation (rad).
+     *********************************************************************************************/
+    void setElevationTolerance(double epsilon) { m_elevation_epsilon = epsilon; }
+
+    /******************************************************************************************//**
+     *  Retrieves the number of calls of the incremental method served from the cache.
+     *********************************************************************************************/
+    uint64_t getLinkCacheHits(void) const { return m_link_hits; }
+
+    /******************************************************************************************//**
+     *  Retrieves the number of calls of the incremental method that recomputed the attenuation.
+     *********************************************************************************************/
+    uint64_t getLinkCacheMisses(void) const { return m_link_misses; }
+
+    /******************************************************************************************//**
+     *  Removes the cached links and resets the counters of the cache.
+     *********************************************************************************************/
+    void clearLinkCache(void);
+
     /******************************************************************************************//**
      *  Inheritated class from ns3::PropagationLossModel. Is used if the model uses objects type 
      *  ns3::RandomVariableStream, set the stream numbers to the integers starting with the offset
@@ -95,8 +310,8 @@ public:
     double getAtt() const { return m_att; }
 
 private:
-    double m_wlc;                   /**< Water Liquid Content. */
-    double m_h_cloud;               /**< Height of the cloud. */
+    double m_wlc;                   /**< Water Liquid Content of the fixed fog layer. */
+    double m_h_cloud;               /**< Height of the fixed fog layer. */
     double m_dist_travel;           /**< Distance that the signal travels inside a cloud. */
     double m_temp;                  /**< Temperature of the water drops. */
     double m_freq_min;              /**< Minimum frequency to allow the model to work. */
@@ -104,6 +319,30 @@ private:
     double m_freq;                  /**< Working frequency */
     double m_att;                   /**< Attenuation due to clouds. */
     ns3::Ptr<SpaceNetDevice> m_src; /**< SpaceNetDevice of the source */
+    BenoitCoefficientTable m_coefficients; /**< Precomputed attenuation coefficients. */
+    std::shared_ptr<const CloudMap> m_cloud_map; /**< Map of the clouds, if any. */
+    double m_gmst;                  /**< Greenwich mean sidereal time of the links (rad). */
+    std::shared_ptr<const CloudCoverProcess> m_cloud_cover; /**< Cloud cover, if any. */
+    std::size_t m_station;          /**< Ground station in the cloud cover process. */
+    double m_time;                  /**< Time of the links in the cloud cover process (s). */
+    uint64_t m_weather;             /**< Version of the weather, increased at every change. */
+    double m_elevation_epsilon;     /**< Elevation change that recomputes a cached link (rad). */
+    uint64_t m_link_hits;           /**< Incremental calls served from the cache. */
+    uint64_t m_link_misses;         /**< Incremental calls that recomputed the link. */
+
+    /******************************************************************************************//**
+     *  Last computation of a link by the incremental method.
+     *********************************************************************************************/
+    struct LinkState
+    {
+        double elevation;           /**< Elevation of the computation (rad). */
+        double freq;                /**< Frequency of the link. */
+        double min_freq;            /**< Minimum frequency of the computation. */
+        uint64_t weather;           /**< Version of the weather of the computation. */
+        double att;                 /**< Attenuation (dB). */
+    };
+
+    std::unordered_map<uint64_t, LinkState> m_links;    /**< Cached links. */
 
     /******************************************************************************************//**
      *  Set the minimum frequency of the communication.
@@ -117,6 +356,19 @@ private:
      *********************************************************************************************/
     void setCloud();
 
+    /******************************************************************************************//**
+     *  Retrieves the cloud over the ground end of a link: from the cloud cover process if it is
+     *  set, else from the cloud map at the body closest to the centre of the Earth, else the fixed
+     *  fog layer.
+     *
+     *  @param body1     ECICoordinates of the first body
+     *  @param body2     ECICoordinates of the second body
+     *  @param height    Output thickness of the cloud (km)
+     *  @param wlc       Output water liquid content (g/m³)
+     *********************************************************************************************/
+    void getCloudAt(const ECICoordinates& body1, const ECICoordinates& body2, double& height,
+        double& wlc) const;
+
     /******************************************************************************************//**
      *  Retrieves the the condition to perform the model. It checks if the angle between two points
      *  is lower than 170º and higher 10º. Note that it is assumed that the line of signt between 2
@@ -128,27 +380,61 @@ private:
      *********************************************************************************************/
     bool isValid(ECICoordinates body1, ECICoordinates body2);
 
+    /******************************************************************************************//**
+     *  Same check as the previous method, given the elevation of the satellite over the horizon
+     *  of the ground station.
+     * 
+     *  @param elevation Elevation of the satellite seen from the ground station (rad)
+     *  @return True if the model is valid, else otherwise.
+     *********************************************************************************************/
+    bool isValid(double elevation);
+
     /******************************************************************************************//**
      *  Compute the distance that the signal is going to travel inside the cloud in the case of one
      *  satellite communicating with a ground station.
+     *
+     *  @param height    Thickness of the cloud (km)
      *********************************************************************************************/
-    void getDistanceGsSat();
+    void getDistanceGsSat(double height);
 
     /******************************************************************************************//**
-     * Computes and retrieves the attenuation coefficient (K1) according to benoits method.
+     * Computes and retrieves the attenuation coefficient (K1) according to benoits method. It is
+     * taken from the precomputed table when the frequency is in it.
      * 
      * @param freq    Frequency of the device.
      * @return        The value of the attenuation coefficent in [dB/Km]/[g/m³]
      *********************************************************************************************/
-    double getAttCoeff(double freq);
+    double getAttCoeff(double freq) const;
 
     /******************************************************************************************//**
      * Compute and retrieves  the extintion coefficent (Kext) due to the clouds.
      * 
      *  @param k1    Attenuation coefficient
+     *  @param wlc   Water liquid content of the cloud (g/m³)
      *  @return      The value of the extintion coefficent in [dB/Km]
      *********************************************************************************************/
-    double getExtCoeff(double k1);
+    double getExtCoeff(double k1, double wlc) const;
+
+    /******************************************************************************************//**
+     * Computes the inverse of the sine of the angle used by the model between two bodies, which
+     * scales the height of the cloud into the distance travelled inside it.
+     * 
+     *  @param body1    ECICoordinates of the first body
+     *  @param body2    ECICoordinates of the second body
+     *  @param sin_min  Sine of the minimum elevation of the model, computed once by the caller
+     *  @return         The factor, or 0 if the model is not valid for the link
+     *********************************************************************************************/
+    static double getSlantFactor(const ECICoordinates& body1, const ECICoordinates& body2,
+        double sin_min);
+
+    /******************************************************************************************//**
+     * Computes the sine of the angle used by the model between two bodies, as checked by isValid.
+     * 
+     *  @param body1    ECICoordinates of the first body
+     *  @param body2    ECICoordinates of the second body
+     *  @return         The sine, or 0 if both bodies are the same
+     *********************************************************************************************/
+    static double getElevationSine(const ECICoordinates& body1, const ECICoordinates& body2);
 
 
     /******************************************************************************************//**
@@ -0,0 +1,210 @@
+/***********************************************************************************************//**
+ *  Table of range, range-rate, propagation delay and Doppler shift of the links of a constellation
+ *  @class      LinkDynamicsTable
+ *  @author     DSS-SIM development team, i2CAT
+ *  @date       2026-oct-16
+ *  @copyright  This code has been developed by Fundació Privada Internet i Innovació Digital a
+ *              Catalunya (i2CAT). i2CAT is a non-profit research and innovation centre that
+ *              promotes mission-driven knowledge to solve business challenges, co-create solutions
+ *              with a transformative impact, empower citizens through open and participative
+ *              digital social innovation with territorial capillarity, and promote pioneering and
+ *              strategic initiatives. i2CAT *aims to transfer* research project results to private
+ *              companies in order to create social and economic impact via the out-licensing of
+ *              intellectual property and the creation of spin-offs.
+ *              Find more information of i2CAT projects and IP rights at:
+ *              https://i2cat.net/tech-transfer/
+ **************************************************************************************************/
+
+#include "LinkDynamicsTable.hpp"
+
+#include <algorithm>
+#include <sstream>
+
+LOG_COMPONENT_DEFINE("LinkDynamicsTable");
+
+LinkDynamicsTable::LinkDynamicsTable(
+    double jd_start,
+    double start,
+    double step,
+    std::size_t steps,
+    double frequency,
+    double min_elevation
+)
+    : m_jd_start(jd_start)
+    , m_start(start)
+    , m_step(step)
+    , m_steps(std::max<std::size_t>(steps, 2))
+    , m_frequency(frequency)
+    , m_min_elevation(min_elevation * Globals::constants.pi / 180.0)
+{ }
+
+std::size_t LinkDynamicsTable::addGroundStation(const GroundStation& station)
+{
+    m_stations.push_back(station);
+    return m_stations.size() - 1;
+}
+
+std::size_t LinkDynamicsTable::addPair(std::size_t satellite, std::size_t peer, bool ground)
+{
+    if(ground && peer >= m_stations.size()) {
+        LOG_WARN("Unknown ground station; the pair is not added.");
+        return m_pairs.size();
+    }
+    m_pairs.push_back(Pair{satellite, peer, ground});
+    m_range.resize(m_pairs.size() * m_steps, 0.0);
+    m_range_rate.resize(m_pairs.size() * m_steps, 0.0);
+    m_visible.resize(m_pairs.size() * m_steps, 0);
+    return m_pairs.size() - 1;
+}
+
+void LinkDynamicsTable::update(std::size_t step, const BatchStates& states)
+{
+    if(step >= m_steps) {
+        LOG_WARN("Step out of the table; it is ignored.");
+        return;
+    }
+
+    /* The stations are rotated once per step. */
+    double time = m_start + step * m_step;
+    double gmst = SGP4Funcs::gstime(m_jd_start + time * CONTACT_TIME_UNIT_DAYS);
+    std::vector<ECICoordinates> positions(m_stations.size());
+    std::vector<ECICoordinates> ups(m_stations.size());
+    std::size_t satellites = states.size();
+    std::size_t unknown = 0;
+
+    for(std::size_t i = 0; i < m_stations.size(); i++) {
+        positions[i] = ContactPlanner::groundStationToECI(m_stations[i], gmst, ups[i]);
+    }
+
+    for(std::size_t p = 0; p < m_pairs.size(); p++) {
+        const Pair& pair = m_pairs[p];
+        std::size_t index = p * m_steps + step;
+        std::size_t s = pair.satellite;
+        double r[3], v[3];
+        bool visible;
+
+        /* addPair cannot know the size of the constellation, so the pairs are checked here. */
+        if(s >= satellites || (!pair.ground && pair.peer >= satellites)) {
+            m_visible[index] = 0;
+            unknown++;
+            continue;
+        }
+        if(states.error[s] || (!pair.ground && states.error[pair.peer])) {
+            m_visible[index] = 0;
+            continue;
+        }
+        if(pair.ground) {
+            /* The velocity of the station is the rotation of the Earth. */
+            const ECICoordinates& station = positions[pair.peer];
+            r[0] = states.x[s] - station.x;
+            r[1] = states.y[s] - station.y;
+            r[2] = states.z[s] - station.z;
+            v[0] = states.vx[s] + LINK_DYNAMICS_EARTH_ROTATION * station.y;
+            v[1] = states.vy[s] - LINK_DYNAMICS_EARTH_ROTATION * station.x;
+            v[2] = states.vz[s];
+        } else {
+            std::size_t q = pair.peer;
+            r[0] = states.x[s] - states.x[q];
+            r[1] = states.y[s] - states.y[q];
+            r[2] = states.z[s] - states.z[q];
+            v[0] = states.vx[s] - states.vx[q];
+            v[1] = states.vy[s] - states.vy[q];
+            v[2] = states.vz[s] - states.vz[q];
+        }
+
+        double range = std::sqrt(r[0] * r[0] + r[1] * r[1] + r[2] * r[2]);
+        if(pair.ground) {
+            const ECICoordinates& up = ups[pair.peer];
+            visible = (r[0] * up.x + r[1] * up.y + r[2] * up.z) / range
+                >= std::sin(m_min_elevation);
+        } else {
+            /* Line of sight clear of the Earth: closest point of the segment to its centre. */
+            double p0[3] = {states.x[s], states.y[s], states.z[s]};
+            double t = (p0[0] * r[0] + p0[1] * r[1] + p0[2] * r[2]) / (range * range);
+            t = std::min(std::max(t, 0.0), 1.0);
+            double c[3] = {p0[0] - t * r[0], p0[1] - t * r[1], p0[2] - t * r[2]};
+            visible = std::sqrt(c[0] * c[0] + c[1] * c[1] + c[2] * c[2]) > CONTACT_WGS84_RADIUS;
+        }
+
+        m_range[index] = range;
+        m_range_rate[index] = (r[0] * v[0] + r[1] * v[1] + r[2] * v[2]) / range;
+        m_visible[index] = visible ? 1 : 0;
+    }
+
+    if(unknown > 0) {
+        std::stringstream ss;
+        ss << unknown << " pairs refer to unknown satellites; they are not visible.";
+        LOG_WARN(ss.str());
+    }
+}
+
+void LinkDynamicsTable::build(const SGP4BatchPropagator& propagator)
+{
+    BatchStates states;
+    double offset = (m_jd_start - propagator.getReferenceEpoch()) / SGP4_TIME_UNIT_DAYS;
+
+    /* The times of the table are measured from jd_start, those of the propagator from its own
+     * reference epoch. */
+    for(std::size_t k = 0; k < m_steps; k++) {
+        propagator.propagate(m_start + k * m_step + offset, states);
+        update(k, states);
+    }
+}
+
+std::size_t LinkDynamicsTable::locate(double time, double& s) const
+{
+    double u = (time - m_start) / m_step;
+
+    u = std::min(std::max(u, 0.0), (double)(m_steps - 1));
+    std::size_t k = std::min((std::size_t)u, m_steps - 2);
+    s = u - k;
+    return k;
+}
+
+double LinkDynamicsTable::interpolate(std::size_t pair, double time, double& range_rate) const
+{
+    double s;
+    std::size_t index = pair * m_steps + locate(time, s);
+    double h = m_step * LINK_DYNAMICS_SECONDS_PER_UNIT;
+    double s2 = s * s;
+    double s3 = s2 * s;
+    double r0 = m_range[index];
+    double r1 = m_range[index + 1];
+    double v0 = m_range_rate[index];
+    double v1 = m_range_rate[index + 1];
+
+    /* The range-rate is the derivative of the Hermite polynomial, one order more accurate than
+     * interpolating the tabulated range-rates linearly. */
+    range_rate = ((6 * s2 - 6 * s) * (r0 - r1)) / h + (3 * s2 - 4 * s + 1) * v0
+        + (3 * s2 - 2 * s) * v1;
+    return (2 * s3 - 3 * s2 + 1) * r0 + (s3 - 2 * s2 + s) * h * v0 + (-2 * s3 + 3 * s2) * r1
+        + (s3 - s2) * h * v1;
+}
+
+double LinkDynamicsTable::getDelay(std::size_t pair, double time) const
+{
+    double range_rate;
+
+    return interpolate(pair, time, range_rate) / LINK_DYNAMICS_SPEED_OF_LIGHT;
+}
+
+double LinkDynamicsTable::getDoppler(std::size_t pair, double time) const
+{
+    double range_rate;
+
+    interpolate(pair, time, range_rate);
+    return -m_frequency * range_rate / LINK_DYNAMICS_SPEED_OF_LIGHT;
+}
+
+LinkDynamicsState LinkDynamicsTable::getState(std::size_t pair, double time) const
+{
+    LinkDynamicsState state;
+    double s;
+    std::size_t index = pair * m_steps + locate(time, s);
+
+    state.range = interpolate(pair, time, state.range_rate);
+    state.delay = state.range / LINK_DYNAMICS_SPEED_OF_LIGHT;
+    state.doppler = -m_frequency * state.range_rate / LINK_DYNAMICS_SPEED_OF_LIGHT;
+    state.visible = m_visible[index + (s < 0.5 ? 0 : 1)] != 0;
+    return state;
+}
@@ -0,0 +1,192 @@
+/***********************************************************************************************//**
+ *  Table of range, range-rate, propagation delay and Doppler shift of the links of a constellation
+ *  @class      LinkDynamicsTable
+ *  @author     DSS-SIM development team, i2CAT
+ *  @date       2026-oct-16
+ *  @copyright  This code has been developed by Fundació Privada Internet i Innovació Digital a
+ *              Catalunya (i2CAT). i2CAT is a non-profit research and innovation centre that
+ *              promotes mission-driven knowledge to solve business challenges, co-create solutions
+ *              with a transformative impact, empower citizens through open and participative
+ *              digital social innovation with territorial capillarity, and promote pioneering and
+ *              strategic initiatives. i2CAT *aims to transfer* research project results to private
+ *              companies in order to create social and economic impact via the out-licensing of
+ *              intellectual property and the creation of spin-offs.
+ *              Find more information of i2CAT projects and IP rights at:
+ *              https://i2cat.net/tech-transfer/
+ **************************************************************************************************/
+
+#ifndef __LINK_DYNAMICS_TABLE_HPP__
+#define __LINK_DYNAMICS_TABLE_HPP__
+
+/* Global libraries */
+#include "dss.hpp"
+
+/* External Libraries */
+#include <vector>
+
+/* Internal Libraries */
+#include "ContactPlanner.hpp"
+#include "SGP4BatchPropagator.hpp"
+
+#define LINK_DYNAMICS_SPEED_OF_LIGHT    299792.458      /**< Speed of light (km/s) */
+#define LINK_DYNAMICS_EARTH_ROTATION    7.2921150e-5    /**< Earth rotation rate (rad/s) */
+#define LINK_DYNAMICS_SECONDS_PER_UNIT  60.0            /**< Seconds per unit of propagation time
+                                                             (SGP4 uses minutes) */
+
+/***********************************************************************************************//**
+ * Geometry of a link at a time.
+ **************************************************************************************************/
+struct LinkDynamicsState
+{
+    double range;           /**< Distance between the ends (km) */
+    double range_rate;      /**< Rate of change of the distance, positive when receding (km/s) */
+    double delay;           /**< One-way light time (s) */
+    double doppler;         /**< Doppler shift at the carrier frequency of the table (Hz) */
+    bool visible;           /**< The ends are in line of sight (above the mask for ground links) */
+};
+
+/***********************************************************************************************//**
+ * Link-dynamics stage of a constellation. For every registered pair (satellite/ground station or
+ * satellite/satellite) and every step of a uniform time grid, the range and the range-rate are
+ * computed from the batched SGP4 positions and velocities and stored per pair, contiguously.
+ *
+ * A query interpolates the range with a cubic Hermite polynomial, whose derivatives are the
+ * stored range-rates, and takes the range-rate from the derivative of the polynomial, so the
+ * delay and the Doppler shift of any time inside the grid are obtained in O(1) without
+ * propagating the orbits again.
+ *
+ * Times have the same meaning as in sgp4Propagate.
+ *
+ * @see     SGP4BatchPropagator
+ * @see     ContactPlanner
+ **************************************************************************************************/
+class LinkDynamicsTable
+{
+public:
+    /*******************************************************************************************//**
+     * Constructs an empty table.
+     *
+     * @param  jd_start         Julian date (UT1) at propagation time 0, used to rotate the Earth
+     * @param  start            Time of the first step
+     * @param  step             Time between steps
+     * @param  steps            Number of steps (at least 2)
+     * @param  frequency        Carrier frequency of the Doppler shifts (Hz)
+     * @param  min_elevation    Elevation mask of the ground links (deg)
+     **********************************************************************************************/
+    LinkDynamicsTable(
+        double jd_start,
+        double start,
+        double step,
+        std::size_t steps,
+        double frequency,
+        double min_elevation = CONTACT_MIN_ELEVATION
+    );
+
+    /*******************************************************************************************//**
+     * Auto-generated destructor.
+     **********************************************************************************************/
+    ~LinkDynamicsTable(void) = default;
+
+    /*******************************************************************************************//**
+     * Adds a ground station.
+     *
+     * @param  station  Ground station
+     * @return          Index of the station
+     **********************************************************************************************/
+    std::size_t addGroundStation(const GroundStation& station);
+
+    /*******************************************************************************************//**
+     * Adds a pair of nodes whose link is tabulated. Pairs shall be added before filling the table.
+     *
+     * @param  satellite    Index of the satellite in the batch states
+     * @param  peer         Index of the ground station, or of the second satellite
+     * @param  ground       True if the peer is a ground station
+     * @return              Index of the pair
+     **********************************************************************************************/
+    std::size_t addPair(std::size_t satellite, std::size_t peer, bool ground);
+
+    /*******************************************************************************************//**
+     * Retrieves the number of pairs.
+     **********************************************************************************************/
+    std::size_t size(void) const { return m_pairs.size(); }
+
+    /*******************************************************************************************//**
+     * Fills one step of the table. Pairs that refer to satellites out of the states are not
+     * visible.
+     *
+     * @param  step     Index of the step
+     * @param  states   States of the constellation at the time of the step
+     **********************************************************************************************/
+    void update(std::size_t step, const BatchStates& states);
+
+    /*******************************************************************************************//**
+     * Fills all the steps of the table by propagating the constellation. The times of the table
+     * are translated to the reference epoch of the propagator.
+     *
+     * @param  propagator   Batch propagator of the constellation
+     **********************************************************************************************/
+    void build(const SGP4BatchPropagator& propagator);
+
+    /*******************************************************************************************//**
+     * Retrieves the interpolated state of a link. Times out of the grid are clamped to it.
+     *
+     * @param  pair     Index of the pair
+     * @param  time     Propagation time
+     * @return          State of the link
+     **********************************************************************************************/
+    LinkDynamicsState getState(std::size_t pair, double time) const;
+
+    /*******************************************************************************************//**
+     * Retrieves the one-way light time of a link (s).
+     **********************************************************************************************/
+    double getDelay(std::size_t pair, double time) const;
+
+    /*******************************************************************************************//**
+     * Retrieves the Doppler shift of a link at the carrier frequency of the table (Hz).
+     **********************************************************************************************/
+    double getDoppler(std::size_t pair, double time) const;
+
+private:
+    /*******************************************************************************************//**
+     * Pair of nodes of a link.
+     **********************************************************************************************/
+    struct Pair
+    {
+        std::size_t satellite;  /**< Index of the satellite */
+        std::size_t peer;       /**< Index of the station or of the second satellite */
+        bool ground;            /**< True if the peer is a ground station */
+    };
+
+    double m_jd_start;                      /**< Julian date at propagation time 0 */
+    double m_start;                         /**< Time of the first step */
+    double m_step;                          /**< Time between steps */
+    std::size_t m_steps;                    /**< Number of steps */
+    double m_frequency;                     /**< Carrier frequency (Hz) */
+    double m_min_elevation;                 /**< Elevation mask (rad) */
+    std::vector<GroundStation> m_stations;  /**< Ground stations */
+    std::vector<Pair> m_pairs;              /**< Tabulated pairs */
+    std::vector<double> m_range;            /**< Range of each pair and step (km) */
+    std::vector<double> m_range_rate;       /**< Range-rate of each pair and step (km/s) */
+    std::vector<uint8_t> m_visible;         /**< Visibility of each pair and step */
+
+    /*******************************************************************************************//**
+     * Locates a time in the grid.
+     *
+     * @param  time     Propagation time
+     * @param  s        Output position between the step and the next one, in [0, 1]
+     * @return          Index of the step
+     **********************************************************************************************/
+    std::size_t locate(double time, double& s) const;
+
+    /*******************************************************************************************//**
+     * Interpolates the range of a pair.
+     *
+     * @param  pair         Index of the pair
+     * @param  time         Propagation time
+     * @param  range_rate   Output range-rate (km/s)
+     * @return              Range (km)
+     **********************************************************************************************/
+    double interpolate(std::size_t pair, double time, double& range_rate) const;
+};
+
+#endif /* __LINK_DYNAMICS_TABLE_HPP__ */
@@ -0,0 +1,390 @@
+/***********************************************************************************************//**
+ *  Sun vector, eclipses and solar-panel illumination of a constellation
+ *  @class      IlluminationService
+ *  @author     DSS-SIM development team, i2CAT
+ *  @date       2026-oct-16
+ *  @copyright  This code has been developed by Fundació Privada Internet i Innovació Digital a
+ *              Catalunya (i2CAT). i2CAT is a non-profit research and innovation centre that
+ *              promotes mission-driven knowledge to solve business challenges, co-create solutions
+ *              with a transformative impact, empower citizens through open and participative
+ *              digital social innovation with territorial capillarity, and promote pioneering and
+ *              strategic initiatives. i2CAT *aims to transfer* research project results to private
+ *              companies in order to create social and economic impact via the out-licensing of
+ *              intellectual property and the creation of spin-offs.
+ *              Find more information of i2CAT projects and IP rights at:
+ *              https://i2cat.net/tech-transfer/
+ **************************************************************************************************/
+
+#include "IlluminationService.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+LOG_COMPONENT_DEFINE("IlluminationService");
+
+IlluminationService::IlluminationService(double jd_start)
+    : m_jd_start(jd_start)
+    , m_threshold(0.02)
+    , m_tolerance(1.0e-4)
+    , m_next(0)
+{
+    m_propagator.setReferenceEpoch(m_jd_start);
+}
+
+std::size_t IlluminationService::addSatellite(const SGP4OrbitTrajectory& trajectory)
+{
+    return addSatellite(trajectory.getSatrec());
+}
+
+std::size_t IlluminationService::addSatellite(const elsetrec& satrec)
+{
+    m_satrecs.push_back(satrec);
+    m_propagator.addSatellite(satrec);
+    return m_satrecs.size() - 1;
+}
+
+std::size_t IlluminationService::addPanel(
+    std::size_t satellite,
+    ns3::Ptr<PVCells> cells,
+    double radial,
+    double along_track,
+    double cross_track
+)
+{
+    double norm = std::sqrt(radial * radial + along_track * along_track
+        + cross_track * cross_track);
+
+    if(satellite >= m_satrecs.size() || norm == 0) {
+        LOG_WARN("Unknown satellite or null panel normal; the panel is not added.");
+        return m_panels.size();
+    }
+    m_panels.push_back(Panel{satellite, cells,
+        {radial / norm, along_track / norm, cross_track / norm}, false});
+    return m_panels.size() - 1;
+}
+
+std::size_t IlluminationService::addPanel(std::size_t satellite, ns3::Ptr<PVCells> cells)
+{
+    if(satellite >= m_satrecs.size()) {
+        LOG_WARN("Unknown satellite; the panel is not added.");
+        return m_panels.size();
+    }
+    m_panels.push_back(Panel{satellite, cells, {0.0, 0.0, 0.0}, true});
+    return m_panels.size() - 1;
+}
+
+ECICoordinates IlluminationService::sunPosition(double jd)
+{
+    double deg = Globals::constants.pi / 180.0;
+    double t = (jd - 2451545.0) / 36525.0;
+    double mean_longitude = 280.460 + 36000.771 * t;
+    double anomaly = (357.5291092 + 35999.05034 * t) * deg;
+    double longitude = (mean_longitude + 1.914666471 * std::sin(anomaly)
+        + 0.019994643 * std::sin(2.0 * anomaly)) * deg;
+    double distance = (1.000140612 - 0.016708617 * std::cos(anomaly)
+        - 0.000139589 * std::cos(2.0 * anomaly)) * ILLUMINATION_AU;
+    double obliquity = (23.439291 - 0.0130042 * t) * deg;
+
+    return ECICoordinates(distance * std::cos(longitude),
+        distance * std::cos(obliquity) * std::sin(longitude),
+        distance * std::sin(obliquity) * std::sin(longitude));
+}
+
+void IlluminationService::apparentAngles(
+    const ECICoordinates& position,
+    const ECICoordinates& sun,
+    double& sun_radius,
+    double& earth_radius,
+    double& separation
+)
+{
+    double d[3] = {sun.x - position.x, sun.y - position.y, sun.z - position.z};
+    double sun_distance = std::sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+    double earth_distance = std::sqrt(position.x * position.x + position.y * position.y
+        + position.z * position.z);
+    double cosine = -(position.x * d[0] + position.y * d[1] + position.z * d[2])
+        / (sun_distance * earth_distance);
+
+    sun_radius = std::asin(std::min(ILLUMINATION_SUN_RADIUS / sun_distance, 1.0));
+    earth_radius = std::asin(std::min(ILLUMINATION_EARTH_RADIUS / earth_distance, 1.0));
+    separation = std::acos(std::min(std::max(cosine, -1.0), 1.0));
+}
+
+IlluminationService::Shadow IlluminationService::shadow(
+    const ECICoordinates& position,
+    const ECICoordinates& sun
+)
+{
+    double a, b, c;
+
+    apparentAngles(position, sun, a, b, c);
+    return Shadow{(a + b) - c, (b - a) - c};
+}
+
+double IlluminationService::sunlitFraction(
+    const ECICoordinates& position,
+    const ECICoordinates& sun
+)
+{
+    double a, b, c;
+
+    apparentAngles(position, sun, a, b, c);
+    if(c >= a + b) {
+        return 1.0;
+    }
+    if(c <= b - a) {
+        return 0.0;
+    }
+    if(c <= a - b) {
+        /* Annular eclipse: the whole Earth disc is in front of the Sun. */
+        return 1.0 - (b * b) / (a * a);
+    }
+
+    /* Overlapping area of the two discs. */
+    double x = (c * c + a * a - b * b) / (2.0 * c);
+    double y = std::sqrt(std::max(a * a - x * x, 0.0));
+    double area = a * a * std::acos(std::min(std::max(x / a, -1.0), 1.0))
+        + b * b * std::acos(std::min(std::max((c - x) / b, -1.0), 1.0)) - c * y;
+
+    return std::min(std::max(1.0 - area / (Globals::constants.pi * a * a), 0.0), 1.0);
+}
+
+IlluminationUpdate IlluminationService::illumination(
+    const Panel& panel,
+    const double r[3],
+    const double v[3],
+    const ECICoordinates& sun
+)
+{
+    IlluminationUpdate update{0.0, 0, 0.0, 1.0};
+    ECICoordinates position(r[0], r[1], r[2]);
+
+    update.sunlit = sunlitFraction(position, sun);
+    if(panel.tracking) {
+        return update;
+    }
+
+    /* Orbital frame: radial, cross-track along the angular momentum, along-track completing it. */
+    double d[3] = {sun.x - r[0], sun.y - r[1], sun.z - r[2]};
+    double h[3] = {r[1] * v[2] - r[2] * v[1], r[2] * v[0] - r[0] * v[2], r[0] * v[1] - r[1] * v[0]};
+    double rn = std::sqrt(r[0] * r[0] + r[1] * r[1] + r[2] * r[2]);
+    double hn = std::sqrt(h[0] * h[0] + h[1] * h[1] + h[2] * h[2]);
+    double dn = std::sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+    double normal[3];
+
+    for(int i = 0; i < 3; i++) {
+        int j = (i + 1) % 3;
+        int k = (i + 2) % 3;
+        double radial = r[i] / rn;
+        double cross = h[i] / hn;
+        double along = (h[j] * r[k] - h[k] * r[j]) / (hn * rn);
+        normal[i] = panel.normal[0] * radial + panel.normal[1] * along + panel.normal[2] * cross;
+    }
+    update.incidence = std::max(0.0,
+        (normal[0] * d[0] + normal[1] * d[1] + normal[2] * d[2]) / dn);
+    return update;
+}
+
+bool IlluminationService::evaluate(
+    std::size_t satellite,
+    double time,
+    double r[3],
+    double v[3],
+    ECICoordinates& sun,
+    Shadow& geometry
+)
+{
+    elsetrec satrec = m_satrecs[satellite];
+
+    /* SGP4 measures the time from the epoch of each element set, the schedule from jd_start. */
+    if(!SGP4Funcs::sgp4(satrec, time - m_propagator.getEpochOffset(satellite), r, v)) {
+        return false;
+    }
+    sun = sunPosition(m_jd_start + time * ILLUMINATION_TIME_UNIT_DAYS);
+    geometry = shadow(ECICoordinates(r[0], r[1], r[2]), sun);
+    return true;
+}
+
+double IlluminationService::refine(
+    std::size_t satellite,
+    bool umbra,
+    double t0,
+    double f0,
+    double t1
+)
+{
+    while(t1 - t0 > m_tolerance) {
+        double middle = 0.5 * (t0 + t1);
+        double r[3], v[3];
+        ECICoordinates sun;
+        Shadow geometry;
+
+        if(!evaluate(satellite, middle, r, v, sun, geometry)) {
+            t0 = middle;
+            continue;
+        }
+        double f = umbra ? geometry.umbra : geometry.penumbra;
+        if((f > 0) == (f0 > 0)) {
+            t0 = middle;
+            f0 = f;
+        } else {
+            t1 = middle;
+        }
+    }
+    return 0.5 * (t0 + t1);
+}
+
+void IlluminationService::emitTransition(
+    std::size_t satellite,
+    double time,
+    std::vector<double>& last
+)
+{
+    double r[3], v[3];
+    ECICoordinates sun;
+    Shadow geometry;
+
+    if(!evaluate(satellite, time, r, v, sun, geometry)) {
+        return;
+    }
+    for(std::size_t p = 0; p < m_panels.size(); p++) {
+        if(m_panels[p].satellite != satellite) {
+            continue;
+        }
+        IlluminationUpdate update = illumination(m_panels[p], r, v, sun);
+        update.time = time;
+        update.panel = p;
+        m_updates.push_back(update);
+        last[p] = update.sunlit * update.incidence;
+    }
+}
+
+void IlluminationService::computeSchedule(double start, double end, double step)
+{
+    m_eclipses.clear();
+    m_updates.clear();
+    m_next = 0;
+    if(step <= 0 || end < start) {
+        LOG_WARN("The illumination interval shall be ordered and the step positive.");
+        return;
+    }
+
+    double nan = std::numeric_limits<double>::quiet_NaN();
+    std::size_t satellites = m_satrecs.size();
+    std::size_t steps = std::max<std::size_t>(1, std::ceil((end - start) / step));
+    std::vector<Shadow> previous(satellites, Shadow{0.0, 0.0});
+    std::vector<bool> valid(satellites, false);
+    std::vector<std::size_t> open(satellites, std::numeric_limits<std::size_t>::max());
+    std::vector<double> last(m_panels.size(), -1.0);
+    BatchStates states;
+    double t0 = start;
+
+    for(std::size_t k = 0; k <= steps; k++) {
+        double t1 = std::min(start + k * step, end);
+        ECICoordinates sun = sunPosition(m_jd_start + t1 * ILLUMINATION_TIME_UNIT_DAYS);
+
+        m_propagator.propagate(t1, states);
+        for(std::size_t i = 0; i < satellites; i++) {
+            if(states.error[i] != 0) {
+                valid[i] = false;
+                continue;
+            }
+
+            Shadow g = shadow(ECICoordinates(states.x[i], states.y[i], states.z[i]), sun);
+            const Shadow& g0 = previous[i];
+            double penumbra = nan;
+            double umbra = nan;
+
+            if(!valid[i]) {
+                /* Shadows in progress at the first valid sample start there. */
+                if(g.penumbra > 0) {
+                    open[i] = m_eclipses.size();
+                    m_eclipses.push_back(Eclipse{i, t1, g.umbra > 0 ? t1 : nan, nan, end});
+                }
+            } else {
+                if((g.penumbra > 0) != (g0.penumbra > 0)) {
+                    penumbra = refine(i, false, t0, g0.penumbra, t1);
+                }
+                if((g.umbra > 0) != (g0.umbra > 0)) {
+                    umbra = refine(i, true, t0, g0.umbra, t1);
+                }
+            }
+
+            /* Entries in the penumbra precede the entries in the umbra, and exits from the umbra
+             * precede the exits from the penumbra. */
+            if(!std::isnan(penumbra) && g.penumbra > 0) {
+                open[i] = m_eclipses.size();
+                m_eclipses.push_back(Eclipse{i, penumbra, nan, nan, end});
+                emitTransition(i, penumbra, last);
+            }
+            if(!std::isnan(umbra)) {
+                if(open[i] >= m_eclipses.size()) {
+                    open[i] = m_eclipses.size();
+                    m_eclipses.push_back(Eclipse{i, umbra, nan, nan, end});
+                }
+                if(g.umbra > 0) {
+                    m_eclipses[open[i]].umbra_start = umbra;
+                } else {
+                    m_eclipses[open[i]].umbra_end = umbra;
+                }
+                emitTransition(i, umbra, last);
+            }
+            if(!std::isnan(penumbra) && g.penumbra <= 0 && open[i] < m_eclipses.size()) {
+                m_eclipses[open[i]].penumbra_end = penumbra;
+                open[i] = std::numeric_limits<std::size_t>::max();
+                emitTransition(i, penumbra, last);
+            }
+            previous[i] = g;
+            valid[i] = true;
+        }
+
+        /* Incidence of every panel, emitted when it has drifted over the threshold. */
+        for(std::size_t p = 0; p < m_panels.size(); p++) {
+            std::size_t i = m_panels[p].satellite;
+            if(states.error[i] != 0) {
+                continue;
+            }
+
+            double r[3] = {states.x[i], states.y[i], states.z[i]};
+            double v[3] = {states.vx[i], states.vy[i], states.vz[i]};
+            IlluminationUpdate update = illumination(m_panels[p], r, v, sun);
+            double value = update.sunlit * update.incidence;
+            if(last[p] < 0 || std::fabs(value - last[p]) > m_threshold) {
+                update.time = t1;
+                update.panel = p;
+                m_updates.push_back(update);
+                last[p] = value;
+            }
+        }
+        t0 = t1;
+    }
+
+    /* Umbras still open at the end of the interval. */
+    for(Eclipse& eclipse : m_eclipses) {
+        if(!std::isnan(eclipse.umbra_start) && std::isnan(eclipse.umbra_end)) {
+            eclipse.umbra_end = end;
+        }
+    }
+    std::sort(m_eclipses.begin(), m_eclipses.end(), [](const Eclipse& a, const Eclipse& b) {
+        return a.penumbra_start < b.penumbra_start;
+    });
+    std::stable_sort(m_updates.begin(), m_updates.end(),
+        [](const IlluminationUpdate& a, const IlluminationUpdate& b) { return a.time < b.time; });
+}
+
+std::size_t IlluminationService::advance(double time)
+{
+    std::size_t pushed = 0;
+
+    while(m_next < m_updates.size() && m_updates[m_next].time <= time) {
+        const IlluminationUpdate& update = m_updates[m_next];
+        const Panel& panel = m_panels[update.panel];
+        if(panel.cells) {
+            panel.cells->setIllumination(update.sunlit * update.incidence);
+        }
+        m_next++;
+        pushed++;
+    }
+    return pushed;
+}
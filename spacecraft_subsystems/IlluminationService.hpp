@@ -0,0 +1,279 @@
+/***********************************************************************************************//**
+ *  Sun vector, eclipses and solar-panel illumination of a constellation
+ *  @class      IlluminationService
+ *  @author     DSS-SIM development team, i2CAT
+ *  @date       2026-oct-16
+ *  @copyright  This code has been developed by Fundació Privada Internet i Innovació Digital a
+ *              Catalunya (i2CAT). i2CAT is a non-profit research and innovation centre that
+ *              promotes mission-driven knowledge to solve business challenges, co-create solutions
+ *              with a transformative impact, empower citizens through open and participative
+ *              digital social innovation with territorial capillarity, and promote pioneering and
+ *              strategic initiatives. i2CAT *aims to transfer* research project results to private
+ *              companies in order to create social and economic impact via the out-licensing of
+ *              intellectual property and the creation of spin-offs.
+ *              Find more information of i2CAT projects and IP rights at:
+ *              https://i2cat.net/tech-transfer/
+ **************************************************************************************************/
+
+#ifndef __ILLUMINATION_SERVICE_HPP__
+#define __ILLUMINATION_SERVICE_HPP__
+
+/* Global libraries */
+#include "dss.hpp"
+
+/* External libraries */
+#include <vector>
+#include "SGP4.h"
+
+/* Internal libraries */
+#include "ECICoordinates.hpp"
+#include "PVCells.hpp"
+#include "SGP4BatchPropagator.hpp"
+#include "SGP4OrbitTrajectory.hpp"
+
+#define ILLUMINATION_TIME_UNIT_DAYS (1.0 / 1440.0)  /**< Days per unit of propagation time (SGP4
+                                                      *  evaluates its time argument in minutes) */
+#define ILLUMINATION_AU             149597870.7     /**< Astronomical unit (km) */
+#define ILLUMINATION_SUN_RADIUS     696000.0        /**< Radius of the Sun (km) */
+#define ILLUMINATION_EARTH_RADIUS   6378.137        /**< Radius of the shadowing Earth (km) */
+
+/***********************************************************************************************//**
+ * Eclipse of a satellite. The umbra times are NaN if the satellite only crossed the penumbra.
+ * Eclipses in progress at the limits of the computed interval are clipped to them.
+ **************************************************************************************************/
+struct Eclipse
+{
+    std::size_t satellite;  /**< Index of the satellite */
+    double penumbra_start;  /**< Entry in the penumbra, from the jd_start of the service (in min) */
+    double umbra_start;     /**< Entry in the umbra */
+    double umbra_end;       /**< Exit from the umbra */
+    double penumbra_end;    /**< Exit from the penumbra */
+};
+
+/***********************************************************************************************//**
+ * Illumination of a panel from a time on.
+ **************************************************************************************************/
+struct IlluminationUpdate
+{
+    double time;            /**< Time from the jd_start of the service (in min) */
+    std::size_t panel;      /**< Index of the panel */
+    double sunlit;          /**< Visible fraction of the solar disc, in [0, 1] */
+    double incidence;       /**< Cosine of the incidence angle (0 if the Sun is behind) */
+};
+
+/***********************************************************************************************//**
+ * Illumination service of a constellation. The Sun is placed with the low-precision solar
+ * ephemeris of the Astronomical Almanac (about 0.01 deg) and the Earth casts a conical shadow,
+ * with umbra and penumbra, computed from the apparent radii of the Sun and the Earth seen from
+ * each satellite.
+ *
+ * A schedule is computed in advance: the constellation is propagated in batch on a grid, every
+ * entry and exit of the penumbra and of the umbra is bracketed on the grid and refined by
+ * bisection, and the incidence angle of every panel is evaluated at each step. An update of a
+ * panel is only emitted at the shadow transitions and when its illumination (sunlit fraction
+ * times cosine of the incidence angle) has changed by more than a threshold since the last
+ * update. The updates are then pushed into the PV cells as the simulation advances.
+ *
+ * Panel normals are fixed in the orbital frame of their satellite (radial, along-track and
+ * cross-track axes), or Sun-tracking. The step of the grid shall be shorter than the shortest
+ * eclipse of interest: shadow crossings that start and end between two samples are not detected.
+ *
+ * @see     PVCells
+ * @see     SGP4BatchPropagator
+ **************************************************************************************************/
+class IlluminationService
+{
+public:
+    /*******************************************************************************************//**
+     * Constructs the service.
+     *
+     * @param  jd_start     Julian date at propagation time 0
+     **********************************************************************************************/
+    IlluminationService(double jd_start);
+
+    /*******************************************************************************************//**
+     * Auto-generated destructor.
+     **********************************************************************************************/
+    ~IlluminationService(void) = default;
+
+    /*******************************************************************************************//**
+     * Adds a satellite. The element set is copied, so the trajectory can be destroyed afterwards.
+     *
+     * @param  trajectory   Trajectory initialised with sgp4Init
+     * @return              Index of the satellite
+     **********************************************************************************************/
+    std::size_t addSatellite(const SGP4OrbitTrajectory& trajectory);
+
+    /*******************************************************************************************//**
+     * Adds a satellite given its initialised SGP4 element set.
+     *
+     * @param  satrec   Element set initialised with sgp4init
+     * @return          Index of the satellite
+     **********************************************************************************************/
+    std::size_t addSatellite(const elsetrec& satrec);
+
+    /*******************************************************************************************//**
+     * Adds a body-mounted panel.
+     *
+     * @param  satellite    Index of the satellite
+     * @param  cells        PV cells of the panel (may be null to only compute the schedule)
+     * @param  radial       Component of the panel normal along the position vector
+     * @param  along_track  Component of the panel normal along the direction of motion
+     * @param  cross_track  Component of the panel normal along the angular momentum
+     * @return              Index of the panel
+     **********************************************************************************************/
+    std::size_t addPanel(std::size_t satellite, ns3::Ptr<PVCells> cells, double radial,
+        double along_track, double cross_track);
+
+    /*******************************************************************************************//**
+     * Adds a Sun-tracking panel, whose incidence angle is always 0.
+     *
+     * @param  satellite    Index of the satellite
+     * @param  cells        PV cells of the panel (may be null to only compute the schedule)
+     * @return              Index of the panel
+     **********************************************************************************************/
+    std::size_t addPanel(std::size_t satellite, ns3::Ptr<PVCells> cells);
+
+    /*******************************************************************************************//**
+     * Sets the change of illumination that triggers an update of a panel.
+     **********************************************************************************************/
+    void setThreshold(double threshold) { m_threshold = threshold; }
+
+    /*******************************************************************************************//**
+     * Sets the accuracy of the shadow transition times.
+     **********************************************************************************************/
+    void setTolerance(double tolerance) { m_tolerance = tolerance; }
+
+    /*******************************************************************************************//**
+     * Computes the eclipses and the schedule of panel updates in a time interval. The previous
+     * ones are discarded.
+     *
+     * @param  start    Start of the interval, from jd_start (in min)
+     * @param  end      End of the interval, from jd_start (in min)
+     * @param  step     Step of the grid
+     **********************************************************************************************/
+    void computeSchedule(double start, double end, double step);
+
+    /*******************************************************************************************//**
+     * Pushes into the PV cells the updates of the schedule up to a time, in order.
+     *
+     * @param  time     Time from jd_start (in min)
+     * @return          Number of updates pushed
+     **********************************************************************************************/
+    std::size_t advance(double time);
+
+    /*******************************************************************************************//**
+     * Retrieves the eclipses of the last schedule, sorted by penumbra entry.
+     **********************************************************************************************/
+    const std::vector<Eclipse>& getEclipses(void) const { return m_eclipses; }
+
+    /*******************************************************************************************//**
+     * Retrieves the panel updates of the last schedule, sorted by time.
+     **********************************************************************************************/
+    const std::vector<IlluminationUpdate>& getUpdates(void) const { return m_updates; }
+
+    /*******************************************************************************************//**
+     * Computes the position of the Sun, with the low-precision formulae of the Astronomical
+     * Almanac.
+     *
+     * @param  jd   Julian date
+     * @return      Position of the Sun in the equatorial frame of date (km)
+     **********************************************************************************************/
+    static ECICoordinates sunPosition(double jd);
+
+    /*******************************************************************************************//**
+     * Computes the visible fraction of the solar disc from a point, with a conical shadow of a
+     * spherical Earth.
+     *
+     * @param  position     Position of the point (km)
+     * @param  sun          Position of the Sun (km)
+     * @return              Fraction in [0, 1]: 0 in the umbra, 1 in full Sun
+     **********************************************************************************************/
+    static double sunlitFraction(const ECICoordinates& position, const ECICoordinates& sun);
+
+private:
+    /*******************************************************************************************//**
+     * Solar panel.
+     **********************************************************************************************/
+    struct Panel
+    {
+        std::size_t satellite;      /**< Index of the satellite */
+        ns3::Ptr<PVCells> cells;    /**< PV cells fed by the panel */
+        double normal[3];           /**< Normal in the orbital frame (radial, along, cross) */
+        bool tracking;              /**< The panel points to the Sun */
+    };
+
+    /*******************************************************************************************//**
+     * Shadow geometry of a satellite, as separations from the penumbra and umbra cones (rad).
+     **********************************************************************************************/
+    struct Shadow
+    {
+        double penumbra;    /**< Positive inside the penumbra cone */
+        double umbra;       /**< Positive inside the umbra cone */
+    };
+
+    double m_jd_start;                          /**< Julian date at propagation time 0 */
+    double m_threshold;                         /**< Illumination change of an update */
+    double m_tolerance;                         /**< Accuracy of the transition times */
+    std::vector<elsetrec> m_satrecs;            /**< Element sets of the satellites */
+    SGP4BatchPropagator m_propagator;           /**< Batch propagator of the satellites */
+    std::vector<Panel> m_panels;                /**< Panels */
+    std::vector<Eclipse> m_eclipses;            /**< Eclipses of the last schedule */
+    std::vector<IlluminationUpdate> m_updates;  /**< Updates of the last schedule */
+    std::size_t m_next;                         /**< First update not pushed yet */
+
+    /*******************************************************************************************//**
+     * Computes the apparent radii of the Sun and the Earth seen from a point, and the angle
+     * between their centres (rad).
+     **********************************************************************************************/
+    static void apparentAngles(const ECICoordinates& position, const ECICoordinates& sun,
+        double& sun_radius, double& earth_radius, double& separation);
+
+    /*******************************************************************************************//**
+     * Computes the shadow geometry of a point.
+     **********************************************************************************************/
+    static Shadow shadow(const ECICoordinates& position, const ECICoordinates& sun);
+
+    /*******************************************************************************************//**
+     * Computes the illumination of a panel at a state.
+     *
+     * @param  panel    Panel
+     * @param  r        Position of the satellite (km)
+     * @param  v        Velocity of the satellite (km/s)
+     * @param  sun      Position of the Sun (km)
+     * @return          Update, without time nor panel index
+     **********************************************************************************************/
+    static IlluminationUpdate illumination(const Panel& panel, const double r[3],
+        const double v[3], const ECICoordinates& sun);
+
+    /*******************************************************************************************//**
+     * Propagates a single satellite and computes its shadow geometry.
+     *
+     * @return  False if SGP4 fails
+     **********************************************************************************************/
+    bool evaluate(std::size_t satellite, double time, double r[3], double v[3],
+        ECICoordinates& sun, Shadow& geometry);
+
+    /*******************************************************************************************//**
+     * Refines by bisection a change of sign of the penumbra or umbra function of a satellite.
+     *
+     * @param  satellite    Index of the satellite
+     * @param  umbra        Refine the umbra function instead of the penumbra one
+     * @param  t0           Time before the change
+     * @param  f0           Value of the function at t0
+     * @param  t1           Time after the change
+     * @return              Time of the change
+     **********************************************************************************************/
+    double refine(std::size_t satellite, bool umbra, double t0, double f0, double t1);
+
+    /*******************************************************************************************//**
+     * Emits the updates of all the panels of a satellite at a time.
+     *
+     * @param  satellite    Index of the satellite
+     * @param  time         Time of the updates
+     * @param  last         Last illumination emitted for each panel, updated
+     **********************************************************************************************/
+    void emitTransition(std::size_t satellite, double time, std::vector<double>& last);
+};
+
+#endif /* __ILLUMINATION_SERVICE_HPP__ */
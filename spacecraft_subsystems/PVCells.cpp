@@ -18,6 +18,8 @@
 
 #include "PVCells.hpp"
 
+#include <algorithm>
+
 #include "ns3/assert.h"
 #include "ns3/pointer.h"
 #include "ns3/string.h"
@@ -26,10 +28,14 @@ LOG_COMPONENT_DEFINE("PVCells");
 
 
 PVCells::PVCells(double Imax, double Pmax, double V_Pmax, double Vmax)
-    : m_Imax(Imax)
+    : m_harvestingPower(0)
+    , m_harvestingCurrent(0)
+    , m_Imax(Imax)
     , m_Pmax(Pmax)
-    , m_V_Pmax(V_Pmax)
     , m_Vmax(Vmax)
+    , m_V_Pmax(V_Pmax)
+    , m_Vin(0)
+    , m_illumination(1.0)
 {}
 
 double PVCells::calculateHarvestingCurrent(double Vin)
@@ -61,6 +67,12 @@ double PVCells::DoGetPower(void) const
 
 void PVCells::updateInputVoltage(double Vin)
 {
-    m_harvestingCurrent = calculateHarvestingCurrent(Vin);
+    m_harvestingCurrent = calculateHarvestingCurrent(Vin) * m_illumination;
     m_harvestingPower = m_harvestingCurrent * m_Vin;
 }
+
+void PVCells::setIllumination(double illumination)
+{
+    m_illumination = std::min(std::max(illumination, 0.0), 1.0);
+    updateInputVoltage(m_Vin);
+}
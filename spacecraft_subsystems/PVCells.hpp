@@ -74,6 +74,22 @@ public:
      **********************************************************************************************/
     void updateInputVoltage(double Vin);
 
+    /*******************************************************************************************//**
+     * Method that sets the illumination of the cell and updates its current and power at the last
+     * input voltage. The current of the cell is taken as proportional to the irradiance.
+     * 
+     * @param illumination    Irradiance relative to the nominal one (sunlit fraction times the
+     *                        cosine of the incidence angle), in [0, 1]. It is 1 by default.
+     **********************************************************************************************/
+    void setIllumination(double illumination);
+
+    /*******************************************************************************************//**
+     * Method that gets the illumination of the cell.
+     * 
+     * @returns   Irradiance relative to the nominal one.
+     **********************************************************************************************/
+    double getIllumination(void) const { return m_illumination; }
+
 protected:
     double m_harvestingPower;   /**< Output current of the PV Cell */
     double m_harvestingCurrent; /**< Output power of the PV Cell */
@@ -82,6 +98,7 @@ protected:
     double m_Vmax;              /**< Volatge when the cells delivers the maximum power */
     double m_V_Pmax;            /**< Maximum voltage of the cell (also known as Voc) */
     double m_Vin;               /**< Input voltage of the cell */
+    double m_illumination;      /**< Irradiance relative to the nominal one */
 
     /*******************************************************************************************//**
      * Method that calculates the harvesting current of the given an input voltage. If the input 